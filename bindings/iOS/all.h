@@ -74,6 +74,7 @@
 #import <VerovioFramework/harm.h>
 #import <VerovioFramework/horizontalaligner.h>
 #import <VerovioFramework/humlib.h>
+#import <VerovioFramework/inflater.h>
 #import <VerovioFramework/instrdef.h>
 #import <VerovioFramework/io.h>
 #import <VerovioFramework/ioabc.h>
@@ -95,8 +96,10 @@
 #import <VerovioFramework/linkinginterface.h>
 #import <VerovioFramework/mdiv.h>
 #import <VerovioFramework/measure.h>
+#import <VerovioFramework/memorystats.h>
 #import <VerovioFramework/mensur.h>
 #import <VerovioFramework/metersig.h>
+#import <VerovioFramework/midiwriter.h>
 #import <VerovioFramework/mnum.h>
 #import <VerovioFramework/mordent.h>
 #import <VerovioFramework/mrest.h>
@@ -110,6 +113,7 @@
 #import <VerovioFramework/note.h>
 #import <VerovioFramework/num.h>
 #import <VerovioFramework/object.h>
+#import <VerovioFramework/objectarena.h>
 #import <VerovioFramework/octave.h>
 #import <VerovioFramework/options.h>
 #import <VerovioFramework/orig.h>
@@ -123,6 +127,7 @@
 #import <VerovioFramework/pghead2.h>
 #import <VerovioFramework/phrase.h>
 #import <VerovioFramework/pitchinterface.h>
+#import <VerovioFramework/playbackschedule.h>
 #import <VerovioFramework/plica.h>
 #import <VerovioFramework/plistinterface.h>
 #import <VerovioFramework/positioninterface.h>
@@ -144,6 +149,7 @@
 #import <VerovioFramework/slur.h>
 #import <VerovioFramework/smufl.h>
 #import <VerovioFramework/space.h>
+#import <VerovioFramework/spatialindex.h>
 #import <VerovioFramework/staff.h>
 #import <VerovioFramework/staffdef.h>
 #import <VerovioFramework/staffgrp.h>
@@ -161,7 +167,9 @@
 #import <VerovioFramework/textdirinterface.h>
 #import <VerovioFramework/textelement.h>
 #import <VerovioFramework/tie.h>
+#import <VerovioFramework/timeindex.h>
 #import <VerovioFramework/timeinterface.h>
+#import <VerovioFramework/timespanindex.h>
 #import <VerovioFramework/timestamp.h>
 #import <VerovioFramework/toolkit.h>
 #import <VerovioFramework/transposition.h>
@@ -14,10 +14,15 @@
 %ignore vrv::Toolkit::GetShowBoundingBoxes( );
 %ignore vrv::Toolkit::GetCString( );
 %ignore vrv::Toolkit::GetLogString( );
+%ignore vrv::Toolkit::GetPlaybackSchedule( );
 %ignore vrv::Toolkit::ParseOptions( const std::string & );
 %ignore vrv::Toolkit::ResetLogBuffer( );
 %ignore vrv::Toolkit::SetShowBoundingBoxes( bool );
 %ignore vrv::Toolkit::SetCString( const std::string & );
+%ignore vrv::Toolkit::GetCData( int & );
+%ignore vrv::Toolkit::SetCData( std::string && );
+// Raw MIDI data cannot be returned as a String, use renderToMIDI instead
+%ignore vrv::Toolkit::RenderToMIDIData;
 
 %module verovio
 %include "std_string.i"
@@ -12,9 +12,17 @@
 %ignore vrv::Toolkit::GetShowBoundingBoxes( );
 %ignore vrv::Toolkit::GetCString( );
 %ignore vrv::Toolkit::GetLogString( );
+%ignore vrv::Toolkit::GetPlaybackSchedule( );
 %ignore vrv::Toolkit::ResetLogBuffer( );
 %ignore vrv::Toolkit::SetShowBoundingBoxes( bool );
 %ignore vrv::Toolkit::SetCString( const std::string & );
+%ignore vrv::Toolkit::GetCData( int & );
+%ignore vrv::Toolkit::SetCData( std::string && );
+
+// Return the raw MIDI data as bytes and not as a (decoded) str
+%typemap(out) std::string RenderToMIDIData %{
+    $result = PyBytes_FromStringAndSize($1.data(), $1.size());
+%}
 
 %module(package="verovio") verovio
 %include "std_string.i"
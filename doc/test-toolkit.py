@@ -0,0 +1,480 @@
+# This script it expected to be run from ./bindings/python
+import base64
+import gzip
+import io
+import json
+import os
+import re
+import shutil
+import struct
+import sys
+import tempfile
+import threading
+import unittest
+import zipfile
+
+# Add path for toolkit built in-place
+sys.path.append('.')
+import verovio
+
+# Two staves with quarter notes and then eighth notes in the upper staff, and half notes and then a whole note in the
+# lower one. At the default tempo of 120, a quarter note lasts 500 ms.
+testMEI = """<?xml version="1.0" encoding="UTF-8"?>
+<mei xmlns="http://www.music-encoding.org/ns/mei" meiversion="4.0.0">
+  <meiHead><fileDesc><titleStmt><title/></titleStmt><pubStmt/></fileDesc></meiHead>
+  <music><body><mdiv><score>
+    <scoreDef meter.count="4" meter.unit="4">
+      <staffGrp>
+        <staffDef n="1" lines="5" clef.shape="G" clef.line="2"/>
+        <staffDef n="2" lines="5" clef.shape="F" clef.line="4"/>
+      </staffGrp>
+    </scoreDef>
+    <section>
+      <measure xml:id="m1" n="1">
+        <staff n="1"><layer n="1">
+          <note xml:id="n1" pname="c" oct="5" dur="4"/>
+          <note xml:id="n2" pname="d" oct="5" dur="4"/>
+          <note xml:id="n3" pname="e" oct="5" dur="4"/>
+          <note xml:id="n4" pname="f" oct="5" dur="4"/>
+        </layer></staff>
+        <staff n="2"><layer n="1">
+          <note xml:id="h1" pname="c" oct="3" dur="2"/>
+          <note xml:id="h2" pname="g" oct="2" dur="2"/>
+        </layer></staff>
+      </measure>
+      <measure xml:id="m2" n="2">
+        <staff n="1"><layer n="1">
+          <note xml:id="e1" pname="g" oct="5" dur="8"/>
+          <note xml:id="e2" pname="f" oct="5" dur="8"/>
+          <note xml:id="e3" pname="e" oct="5" dur="8"/>
+          <note xml:id="e4" pname="d" oct="5" dur="8"/>
+          <note xml:id="e5" pname="c" oct="5" dur="8"/>
+          <note xml:id="e6" pname="d" oct="5" dur="8"/>
+          <note xml:id="e7" pname="e" oct="5" dur="8"/>
+          <note xml:id="e8" pname="f" oct="5" dur="8"/>
+        </layer></staff>
+        <staff n="2"><layer n="1">
+          <note xml:id="h3" pname="c" oct="3" dur="1"/>
+        </layer></staff>
+      </measure>
+    </section>
+  </score></mdiv></body></music>
+</mei>
+"""
+
+
+class ToolkitTestCase(unittest.TestCase):
+
+    def setUp(self):
+        self.tk = verovio.toolkit(False)
+        self.tk.setResourcePath('../../data')
+        self.tmpDir = tempfile.mkdtemp()
+
+    def tearDown(self):
+        shutil.rmtree(self.tmpDir)
+
+    def writeFile(self, name, data):
+        path = os.path.join(self.tmpDir, name)
+        with open(path, 'wb') as f:
+            f.write(data)
+        return path
+
+
+class InflaterTestCase(ToolkitTestCase):
+
+    def gzipData(self):
+        return gzip.compress(testMEI.encode('utf-8'))
+
+    def zipData(self):
+        output = io.BytesIO()
+        with zipfile.ZipFile(output, 'w', zipfile.ZIP_DEFLATED) as archive:
+            archive.writestr('score.mei', testMEI)
+        return output.getvalue()
+
+    def test_gzip(self):
+        self.assertTrue(self.tk.loadFile(self.writeFile('score.mei.gz', self.gzipData())))
+        self.assertEqual(self.tk.getPageWithElement('h3'), 1)
+
+    def test_gzip_truncated(self):
+        data = self.gzipData()
+        for length in (20, len(data) // 2, len(data) - 4):
+            self.assertFalse(self.tk.loadFile(self.writeFile('score.mei.gz', data[:length])))
+
+    def test_gzip_corrupted(self):
+        data = bytearray(self.gzipData())
+        # the first byte of the deflate stream sets a reserved block type
+        data[10] |= 0x06
+        self.assertFalse(self.tk.loadFile(self.writeFile('score.mei.gz', bytes(data))))
+
+    def test_gzip_wrong_size(self):
+        # a size in the trailer that does not match the data, and that must not be reserved as such
+        data = self.gzipData()[:-4] + struct.pack('<I', 0xFFFFFFF0)
+        self.assertFalse(self.tk.loadFile(self.writeFile('score.mei.gz', data)))
+
+    def test_zip(self):
+        self.assertTrue(self.tk.loadFile(self.writeFile('score.mei.zip', self.zipData())))
+        self.assertEqual(self.tk.getPageWithElement('h3'), 1)
+
+    def test_zip_truncated(self):
+        data = self.zipData()
+        for length in (30, len(data) // 2, len(data) - 10):
+            self.assertFalse(self.tk.loadFile(self.writeFile('score.mei.zip', data[:length])))
+
+    def test_zip_wrong_size(self):
+        # the uncompressed size in the central directory does not match the data (the checksum still does)
+        data = bytearray(self.zipData())
+        offset = data.rfind(b'PK\x01\x02')
+        data[offset + 24:offset + 28] = struct.pack('<I', 0xFFFFFFF0)
+        self.assertFalse(self.tk.loadFile(self.writeFile('score.mei.zip', bytes(data))))
+
+
+
+class TimeTestCase(ToolkitTestCase):
+
+    def setUp(self):
+        super().setUp()
+        self.tk.loadData(testMEI)
+
+    def test_elements_at_times(self):
+        elements = json.loads(self.tk.getElementsAtTimes(json.dumps([250, 1250, 2600, 3900, 5000])))
+        self.assertEqual(len(elements), 5)
+        self.assertEqual(elements[0]['notes'], ['n1', 'h1'])
+        self.assertEqual(elements[0]['page'], 1)
+        self.assertEqual(elements[1]['notes'], ['n3', 'h2'])
+        # the whole note is found after the eighth notes starting after it
+        self.assertEqual(elements[2]['notes'], ['e3', 'h3'])
+        self.assertEqual(elements[3]['notes'], ['e8', 'h3'])
+        self.assertEqual(elements[4], {})
+
+    def test_elements_at_time(self):
+        elements = json.loads(self.tk.getElementsAtTime(1750))
+        self.assertEqual(elements['notes'], ['n4', 'h2'])
+
+    def test_elements_in_time_range(self):
+        elements = json.loads(self.tk.getElementsInTimeRange(1600, 2300))
+        self.assertEqual(elements['notes'], ['h2', 'n4', 'e1', 'h3', 'e2'])
+        self.assertEqual(elements['pages'], [1])
+        elements = json.loads(self.tk.getElementsInTimeRange(3600, 3700))
+        self.assertEqual(elements['notes'], ['h3', 'e7'])
+        elements = json.loads(self.tk.getElementsInTimeRange(5000, 6000))
+        self.assertEqual(elements['notes'], [])
+
+
+
+class PlaybackTestCase(ToolkitTestCase):
+
+    def setUp(self):
+        super().setUp()
+        self.tk.loadData(testMEI)
+
+    def test_events_in_order(self):
+        order = {'tempo': 0, 'off': 1, 'on': 2}
+        events = json.loads(self.tk.getPlaybackEvents(0, 10000))
+        self.assertEqual(events[0]['type'], 'tempo')
+        self.assertEqual(events[0]['tempo'], 120)
+        keys = [(event['tstamp'], order[event['type']]) for event in events]
+        self.assertEqual(keys, sorted(keys))
+        self.assertEqual(len([event for event in events if event['type'] == 'on']), 15)
+        self.assertEqual(len([event for event in events if event['type'] == 'off']), 15)
+
+    def test_seek(self):
+        # the cursor starts at the first event at the time, and the offs come before the ons
+        events = json.loads(self.tk.getPlaybackEvents(1000, 1000))
+        self.assertEqual([(event['type'], event['id']) for event in events],
+                         [('off', 'n2'), ('off', 'h1'), ('on', 'n3'), ('on', 'h2')])
+        self.assertEqual(events[2]['pitch'], 76)
+        self.assertEqual(events[2]['page'], 1)
+        self.assertEqual(events[2]['qstamp'], 2.0)
+        events = json.loads(self.tk.getPlaybackEvents(3900, 10000))
+        self.assertEqual([(event['type'], event['id']) for event in events], [('off', 'e8'), ('off', 'h3')])
+        self.assertEqual(json.loads(self.tk.getPlaybackEvents(5000, 6000)), [])
+
+
+
+class MIDITestCase(ToolkitTestCase):
+
+    def parseMIDI(self, data):
+        """Return the ticks per quarter note and, for each track, the list of (tick, status, data) events"""
+        self.assertEqual(data[:4], b'MThd')
+        tpq = struct.unpack('>H', data[12:14])[0]
+        tracks = []
+        pos = 14
+        while pos < len(data):
+            self.assertEqual(data[pos:pos + 4], b'MTrk')
+            end = pos + 8 + struct.unpack('>I', data[pos + 4:pos + 8])[0]
+            pos += 8
+            tick = 0
+            status = 0
+            events = []
+            while pos < end:
+                delta = 0
+                while True:
+                    delta = (delta << 7) | (data[pos] & 0x7F)
+                    pos += 1
+                    if data[pos - 1] < 0x80:
+                        break
+                tick += delta
+                if data[pos] >= 0x80:
+                    status = data[pos]
+                    pos += 1
+                if status == 0xFF:
+                    length = data[pos + 1]
+                    events.append((tick, status, data[pos:pos + 2 + length]))
+                    pos += 2 + length
+                else:
+                    length = 1 if (status & 0xF0) in (0xC0, 0xD0) else 2
+                    events.append((tick, status, data[pos:pos + length]))
+                    pos += length
+            tracks.append(events)
+        return tpq, tracks
+
+    def test_track_order(self):
+        # a second layer in the first staff, whose events are generated after the ones of the first layer
+        self.tk.loadData(testMEI.replace('''
+        </layer></staff>
+        <staff n="2">''', '''
+        </layer><layer n="2">
+          <note xml:id="l1" pname="a" oct="4" dur="2"/>
+          <note xml:id="l2" pname="b" oct="4" dur="2"/>
+        </layer></staff>
+        <staff n="2">''', 1))
+        tpq, tracks = self.parseMIDI(base64.b64decode(self.tk.renderToMIDI()))
+        self.assertEqual(len(tracks), 3)
+        for track in tracks:
+            # one end of track, last
+            self.assertEqual([event for event in track if event[2][:1] == b'\x2F'], [track[-1]])
+            self.assertEqual(track[-1][2], b'\x2F\x00')
+        noteOns = [(tick, event[0]) for tick, status, event in tracks[1] if (status & 0xF0) == 0x90 and event[1] > 0]
+        expected = [(0, 72), (0, 69), (tpq, 74), (2 * tpq, 76), (2 * tpq, 71), (3 * tpq, 77)]
+        expected += [(4 * tpq + i * tpq // 2, pitch) for i, pitch in enumerate([79, 77, 76, 74, 72, 74, 76, 77])]
+        self.assertEqual(noteOns, expected)
+        # the offs come before the ons at the same tick
+        for track in tracks:
+            keys = [(tick, 1 if ((status & 0xF0) == 0x90 and event[1] > 0) else 0)
+                    for tick, status, event in track if (status & 0xF0) in (0x80, 0x90)]
+            self.assertEqual(keys, sorted(keys))
+
+
+
+class MemoryStatsTestCase(ToolkitTestCase):
+
+    def checkStats(self, useArena):
+        self.tk.setOptions(json.dumps({'useArena': useArena, 'memoryStats': True}))
+        self.assertTrue(self.tk.loadData(testMEI))
+        stats = json.loads(self.tk.getMemoryStats())
+        self.assertEqual(stats['objects']['Note']['count'], 15)
+        self.assertGreater(stats['objects']['Note']['bytes'], 0)
+        self.assertEqual(sorted(stats['phases'].keys()), ['castOff', 'import', 'prepareDrawing'])
+        self.assertEqual(stats['phases']['import']['objects']['Note']['count'], 15)
+        self.assertEqual('contentArena' in stats['structures'], useArena)
+        return stats
+
+    def test_heap(self):
+        self.checkStats(False)
+
+    def test_arena(self):
+        stats = self.checkStats(True)
+        self.assertGreater(stats['structures']['layoutArena']['count'], 0)
+
+
+
+
+class ArenaTestCase(ToolkitTestCase):
+
+    def runInThread(self, function):
+        errors = []
+
+        def run():
+            try:
+                function()
+            except Exception as e:
+                errors.append(e)
+
+        thread = threading.Thread(target=run)
+        thread.start()
+        thread.join()
+        if errors:
+            raise errors[0]
+
+    def test_threads(self):
+        self.tk.setOptions(json.dumps({'useArena': True}))
+        # the document is loaded by a thread and reloaded, rendered and deleted by other ones
+        self.runInThread(lambda: self.assertTrue(self.tk.loadData(testMEI)))
+
+        def reload():
+            self.assertIn('id="n1"', self.tk.renderToSVG(1))
+            self.assertTrue(self.tk.loadData(testMEI))
+            self.assertIn('id="n1"', self.tk.renderToSVG(1))
+
+        self.runInThread(reload)
+
+        def delete():
+            del self.tk
+
+        self.runInThread(delete)
+
+
+
+
+class AttributeTestCase(ToolkitTestCase):
+
+    def test_round_trip(self):
+        # an attribute of the color and notehead classes with a value, and with the default (empty) one
+        self.assertTrue(self.tk.loadData(testMEI.replace(
+            '<note xml:id="n1" pname="c" oct="5" dur="4"/>',
+            '<note xml:id="n1" pname="c" oct="5" dur="4" color="red" head.shape="x"/>').replace(
+            '<note xml:id="n2" pname="d" oct="5" dur="4"/>', '<note xml:id="n2" pname="d" oct="5" dur="4" color=""/>')))
+        mei = self.tk.getMEI()
+        n1 = re.search(r'<note xml:id="n1"[^>]*>', mei).group(0)
+        self.assertIn('color="red"', n1)
+        self.assertIn('head.shape="x"', n1)
+        n2 = re.search(r'<note xml:id="n2"[^>]*>', mei).group(0)
+        self.assertNotIn('color', n2)
+        self.assertNotIn('head.shape', n2)
+        # the values are kept when the document is loaded again
+        self.assertTrue(self.tk.loadData(mei))
+        self.assertEqual(self.tk.getMEI(), mei)
+
+
+
+
+class ExpansionTestCase(ToolkitTestCase):
+
+    def setUp(self):
+        super().setUp()
+        # the section A is repeated, and the section B has an element with the id the copy of the note would get
+        expansionMEI = testMEI.replace('''<section>
+      <measure xml:id="m1" n="1">''', '''<section>
+      <expansion xml:id="exp" plist="#A #A #B"/>
+      <section xml:id="A">
+      <measure xml:id="m1" n="1">''').replace('''      </measure>
+      <measure xml:id="m2" n="2">''', '''      </measure>
+      </section>
+      <section xml:id="B">
+      <measure xml:id="m2" n="2">''').replace('''<note xml:id="h3" pname="c" oct="3" dur="1"/>''',
+                                             '''<note xml:id="n1-rend2" pname="c" oct="3" dur="1"/>''').replace(
+            '''</measure>
+    </section>''', '''</measure>
+      </section>
+    </section>''')
+        self.tk.setOptions(json.dumps({'expand': 'exp'}))
+        self.assertTrue(self.tk.loadData(expansionMEI))
+
+    def test_derived_ids(self):
+        self.assertEqual(json.loads(self.tk.getExpansionIdsForElement('m1')), ['m1', 'm1-rend2'])
+        self.assertEqual(json.loads(self.tk.getExpansionIdsForElement('n2-rend2')), ['n2', 'n2-rend2'])
+        self.assertEqual(self.tk.getNotatedIdForElement('n2-rend2'), 'n2')
+        self.assertEqual(self.tk.getNotatedIdForElement('m2'), 'm2')
+
+    def test_collision(self):
+        ids = json.loads(self.tk.getExpansionIdsForElement('n1'))
+        self.assertEqual(len(ids), 2)
+        self.assertEqual(ids[0], 'n1')
+        self.assertNotEqual(ids[1], 'n1-rend2')
+        self.assertEqual(self.tk.getNotatedIdForElement(ids[1]), 'n1')
+        # the element of the document keeps its id and is not a rendition
+        self.assertEqual(self.tk.getNotatedIdForElement('n1-rend2'), 'n1-rend2')
+        self.assertEqual(json.loads(self.tk.getExpansionIdsForElement('n1-rend2')), ['n1-rend2'])
+        self.assertEqual(self.tk.getPageWithElement(ids[1]), 1)
+
+
+
+
+class CopyTestCase(ToolkitTestCase):
+
+    def setUp(self):
+        super().setUp()
+        self.assertTrue(self.tk.loadData(testMEI))
+        self.copy = self.newToolkit()
+
+    def newToolkit(self):
+        tk = verovio.toolkit(False)
+        tk.setResourcePath('../../data')
+        return tk
+
+    def withoutGeneratedIds(self, svg):
+        # the ids of the objects generated when preparing the drawing and laying out differ from one load to another
+        return re.sub(r'id="[a-z]+-\d+"', 'id=""', svg)
+
+    def test_same_output(self):
+        self.assertTrue(self.copy.loadCopy(self.tk))
+        self.assertEqual(self.copy.getMEI(), self.tk.getMEI())
+        self.assertEqual(self.withoutGeneratedIds(self.copy.renderToSVG(1)),
+                         self.withoutGeneratedIds(self.tk.renderToSVG(1)))
+
+    def test_other_options(self):
+        mei = self.tk.getMEI()
+        svg = self.tk.renderToSVG(1)
+        self.copy.setOptions(json.dumps({'pageWidth': 800, 'pageHeight': 800, 'spacingStaff': 20}))
+        self.assertTrue(self.copy.loadCopy(self.tk))
+        self.assertEqual(self.copy.getPageCount(), 2)
+        self.assertNotEqual(self.copy.renderToSVG(1), svg)
+        # the document copied is not changed by the layout of the copy
+        self.assertEqual(self.tk.getMEI(), mei)
+        self.assertEqual(self.tk.renderToSVG(1), svg)
+
+    def test_transposition(self):
+        self.copy.setOptions(json.dumps({'transpose': 'M2'}))
+        self.assertTrue(self.copy.loadCopy(self.tk))
+        self.assertIn('<note xml:id="n1" dur="4" oct="5" pname="d">', self.copy.getMEI())
+        self.assertIn('<note xml:id="n1" dur="4" oct="5" pname="c"', self.tk.getMEI())
+        # a transposed document can only be copied with the same transposition
+        other = self.newToolkit()
+        self.assertFalse(other.loadCopy(self.copy))
+        other.setOptions(json.dumps({'transpose': 'M2'}))
+        self.assertTrue(other.loadCopy(self.copy))
+        self.assertEqual(other.getMEI(), self.copy.getMEI())
+
+
+
+
+class SpatialTestCase(ToolkitTestCase):
+
+    def setUp(self):
+        super().setUp()
+        self.assertTrue(self.tk.loadData(testMEI))
+        self.svg = self.tk.renderToSVG(1)
+
+    def pageSize(self):
+        # the coordinates are the ones of the viewBox of the definition-scale element
+        match = re.search(r'class="definition-scale"[^>]* viewBox="0 0 (\d+) (\d+)"', self.svg)
+        return int(match.group(1)), int(match.group(2))
+
+    def notePosition(self, noteId):
+        # the position of the notehead glyph, with its origin on the middle of its left side, and with the translation
+        # of the page margins
+        margins = re.search(r'class="page-margin" transform="translate\((\d+), (\d+)\)"', self.svg)
+        match = re.search(r'<g id="' + noteId + r'" class="note">.*?<use xlink:href="#\w+" x="(\d+)" y="(\d+)"',
+                          self.svg, re.DOTALL)
+        return int(margins.group(1)) + int(match.group(1)), int(margins.group(2)) + int(match.group(2))
+
+    def test_rect(self):
+        width, height = self.pageSize()
+        elements = json.loads(self.tk.getElementsInRect(1, 0, 0, width, height))
+        self.assertEqual(len(elements['note']), 15)
+        self.assertEqual(elements['measure'], ['m1', 'm2'])
+        self.assertEqual(json.loads(self.tk.getElementsInRect(1, width + 100, 0, 100, height)), {})
+
+    def test_point(self):
+        x, y = self.notePosition('n1')
+        elements = json.loads(self.tk.getElementsAtPoint(1, x + 50, y, 0))
+        self.assertEqual(elements['note'], ['n1'])
+        self.assertEqual(elements['measure'], ['m1'])
+        # the next note is found only with a radius large enough
+        x2, _ = self.notePosition('n2')
+        self.assertIn('n2', json.loads(self.tk.getElementsAtPoint(1, x + 50, y, x2 - x))['note'])
+
+    def test_layout(self):
+        x, y = self.notePosition('e1')
+        # with a narrower page, the second measure is moved to a second system
+        self.tk.setOptions(json.dumps({'pageWidth': 800}))
+        self.tk.redoLayout()
+        self.svg = self.tk.renderToSVG(1)
+        x2, y2 = self.notePosition('e1')
+        self.assertGreater(y2, y)
+        self.assertNotIn('e1', json.loads(self.tk.getElementsAtPoint(1, x + 50, y, 0)).get('note', []))
+        self.assertEqual(json.loads(self.tk.getElementsAtPoint(1, x2 + 50, y2, 0))['note'], ['e1'])
+
+
+if __name__ == "__main__":
+    unittest.main()
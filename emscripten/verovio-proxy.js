@@ -21,9 +21,21 @@ verovio.vrvToolkit.getAvailableOptions = Module.cwrap( 'vrvToolkit_getAvailableO
 // char *getElementAttr(Toolkit *ic, const char *xmlId)
 verovio.vrvToolkit.getElementAttr = Module.cwrap( 'vrvToolkit_getElementAttr', 'string', ['number', 'string'] );
 
+// char *getElementsAtPoint(Toolkit *ic, int pageNo, int x, int y, int radius)
+verovio.vrvToolkit.getElementsAtPoint = Module.cwrap( 'vrvToolkit_getElementsAtPoint', 'string', ['number', 'number', 'number', 'number', 'number'] );
+
 // char *getElementsAtTime(Toolkit *ic, int time)
 verovio.vrvToolkit.getElementsAtTime = Module.cwrap( 'vrvToolkit_getElementsAtTime', 'string', ['number', 'number'] );
 
+// char *getElementsAtTimes(Toolkit *ic, const char *times)
+verovio.vrvToolkit.getElementsAtTimes = Module.cwrap( 'vrvToolkit_getElementsAtTimes', 'string', ['number', 'string'] );
+
+// char *getElementsInRect(Toolkit *ic, int pageNo, int x, int y, int width, int height)
+verovio.vrvToolkit.getElementsInRect = Module.cwrap( 'vrvToolkit_getElementsInRect', 'string', ['number', 'number', 'number', 'number', 'number', 'number'] );
+
+// char *getElementsInTimeRange(Toolkit *ic, int startTime, int endTime)
+verovio.vrvToolkit.getElementsInTimeRange = Module.cwrap( 'vrvToolkit_getElementsInTimeRange', 'string', ['number', 'number', 'number'] );
+
 // char *vrvToolkit_getExpansionIdsForElement(Toolkit *tk, const char *xmlId);
 verovio.vrvToolkit.getExpansionIdsForElement = Module.cwrap( 'vrvToolkit_getExpansionIdsForElement', 'string', ['number', 'string'] );
 
@@ -48,18 +60,27 @@ verovio.vrvToolkit.getPageCount = Module.cwrap( 'vrvToolkit_getPageCount', 'numb
 // int getPageWithElement(Toolkit *ic, const char *xmlId)
 verovio.vrvToolkit.getPageWithElement = Module.cwrap( 'vrvToolkit_getPageWithElement', 'number', ['number', 'string'] );
 
+// char *getPlaybackEvents(Toolkit *ic, int startTime, int endTime)
+verovio.vrvToolkit.getPlaybackEvents = Module.cwrap( 'vrvToolkit_getPlaybackEvents', 'string', ['number', 'number', 'number'] );
+
 // double getTimeForElement(Toolkit *ic, const char *xmlId)
 verovio.vrvToolkit.getTimeForElement = Module.cwrap( 'vrvToolkit_getTimeForElement', 'number', ['number', 'string'] );
 
 // char *getMIDIValuesForElement(Toolkit *ic, const char *xmlId)
 verovio.vrvToolkit.getMIDIValuesForElement = Module.cwrap( 'vrvToolkit_getMIDIValuesForElement', 'string', ['number', 'string'] );
 
+// char *getMemoryStats(Toolkit *ic)
+verovio.vrvToolkit.getMemoryStats = Module.cwrap( 'vrvToolkit_getMemoryStats', 'string', ['number'] );
+
 // char *getVersion(Toolkit *ic)
 verovio.vrvToolkit.getVersion = Module.cwrap( 'vrvToolkit_getVersion', 'string', ['number'] );
 
 // bool loadData(Toolkit *ic, const char *data)
 verovio.vrvToolkit.loadData = Module.cwrap( 'vrvToolkit_loadData', 'number', ['number', 'string'] );
 
+// bool loadCopy(Toolkit *ic, Toolkit *source)
+verovio.vrvToolkit.loadCopy = Module.cwrap( 'vrvToolkit_loadCopy', 'number', ['number', 'number'] );
+
 // void redoLayout(Toolkit *ic)
 verovio.vrvToolkit.redoLayout = Module.cwrap( 'vrvToolkit_redoLayout', null, ['number'] );
 
@@ -75,8 +96,8 @@ verovio.vrvToolkit.renderToMIDI = Module.cwrap( 'vrvToolkit_renderToMIDI', 'stri
 // char *renderToSvg(Toolkit *ic, int pageNo, const char *rendering_options)
 verovio.vrvToolkit.renderToSVG = Module.cwrap( 'vrvToolkit_renderToSVG', 'string', ['number', 'number', 'string'] );
 
-// char *renderToTimemap(Toolkit *ic)
-verovio.vrvToolkit.renderToTimemap = Module.cwrap( 'vrvToolkit_renderToTimemap', 'string', ['number'] );
+// char *renderToTimemap(Toolkit *ic, const char *options)
+verovio.vrvToolkit.renderToTimemap = Module.cwrap( 'vrvToolkit_renderToTimemap', 'string', ['number', 'string'] );
 
 // void setOptions(Toolkit *ic, const char *options) 
 verovio.vrvToolkit.setOptions = Module.cwrap( 'vrvToolkit_setOptions', null, ['number', 'string'] );
@@ -120,11 +141,31 @@ verovio.toolkit.prototype.getElementAttr = function ( xmlId )
     return JSON.parse( verovio.vrvToolkit.getElementAttr( this.ptr, xmlId ) );
 };
 
+verovio.toolkit.prototype.getElementsAtPoint = function ( pageNo, x, y, radius )
+{
+    return JSON.parse( verovio.vrvToolkit.getElementsAtPoint( this.ptr, pageNo, x, y, radius || 0 ) );
+};
+
 verovio.toolkit.prototype.getElementsAtTime = function ( millisec )
 {
     return JSON.parse( verovio.vrvToolkit.getElementsAtTime( this.ptr, millisec ) );
 };
 
+verovio.toolkit.prototype.getElementsAtTimes = function ( millisecs )
+{
+    return JSON.parse( verovio.vrvToolkit.getElementsAtTimes( this.ptr, JSON.stringify( millisecs ) ) );
+};
+
+verovio.toolkit.prototype.getElementsInRect = function ( pageNo, x, y, width, height )
+{
+    return JSON.parse( verovio.vrvToolkit.getElementsInRect( this.ptr, pageNo, x, y, width, height ) );
+};
+
+verovio.toolkit.prototype.getElementsInTimeRange = function ( startMillisec, endMillisec )
+{
+    return JSON.parse( verovio.vrvToolkit.getElementsInTimeRange( this.ptr, startMillisec, endMillisec ) );
+};
+
 verovio.toolkit.prototype.getExpansionIdsForElement = function ( xmlId )
 {
     return JSON.parse( verovio.vrvToolkit.getExpansionIdsForElement( this.ptr, xmlId ) );
@@ -163,6 +204,11 @@ verovio.toolkit.prototype.getMIDIValuesForElement = function ( xmlId )
     return JSON.parse( verovio.vrvToolkit.getMIDIValuesForElement( this.ptr, xmlId ) );
 };
 
+verovio.toolkit.prototype.getMemoryStats = function ()
+{
+    return JSON.parse( verovio.vrvToolkit.getMemoryStats( this.ptr ) );
+};
+
 verovio.toolkit.prototype.getNotatedIdForElement = function ( xmlId )
 {
     return verovio.vrvToolkit.getNotatedIdForElement( this.ptr, xmlId );
@@ -183,6 +229,11 @@ verovio.toolkit.prototype.getPageWithElement = function ( xmlId )
     return verovio.vrvToolkit.getPageWithElement( this.ptr, xmlId );
 };
 
+verovio.toolkit.prototype.getPlaybackEvents = function ( startMillisec, endMillisec )
+{
+    return JSON.parse( verovio.vrvToolkit.getPlaybackEvents( this.ptr, startMillisec, endMillisec ) );
+};
+
 verovio.toolkit.prototype.getTimeForElement = function ( xmlId )
 {
     return verovio.vrvToolkit.getTimeForElement( this.ptr, xmlId );
@@ -198,6 +249,11 @@ verovio.toolkit.prototype.loadData = function ( data )
     return verovio.vrvToolkit.loadData( this.ptr, data );
 };
 
+verovio.toolkit.prototype.loadCopy = function ( toolkit )
+{
+    return verovio.vrvToolkit.loadCopy( this.ptr, toolkit.ptr );
+};
+
 verovio.toolkit.prototype.redoLayout = function ()
 {
     verovio.vrvToolkit.redoLayout( this.ptr );
@@ -221,13 +277,13 @@ verovio.toolkit.prototype.renderPage = function ( pageNo, options )
 
 verovio.toolkit.prototype.renderToMIDI = function ( options )
 {
-    return verovio.vrvToolkit.renderToMIDI( this.ptr, JSON.stringify( options ) );
+    return verovio.vrvToolkit.renderToMIDI( this.ptr, JSON.stringify( options || {} ) );
 };
 
 verovio.toolkit.prototype.renderToMidi = function ( options )
 {
     console.warn( "Method renderToMidi is deprecated; use renderToMIDI instead" );
-    return verovio.vrvToolkit.renderToMIDI( this.ptr, JSON.stringify( options ) );
+    return verovio.vrvToolkit.renderToMIDI( this.ptr, JSON.stringify( options || {} ) );
 };
 
 verovio.toolkit.prototype.renderToSVG = function ( pageNo, options )
@@ -235,9 +291,12 @@ verovio.toolkit.prototype.renderToSVG = function ( pageNo, options )
     return verovio.vrvToolkit.renderToSVG( this.ptr, pageNo, JSON.stringify( options ) );
 };
 
-verovio.toolkit.prototype.renderToTimemap = function ()
+verovio.toolkit.prototype.renderToTimemap = function ( options )
 {
-    return JSON.parse( verovio.vrvToolkit.renderToTimemap( this.ptr ) );
+    options = options || {};
+    var timemap = verovio.vrvToolkit.renderToTimemap( this.ptr, JSON.stringify( options ) );
+    // NDJSON is returned as a string to be read line by line
+    return ( options.format === "ndjson" ) ? timemap : JSON.parse( timemap );
 };
 
 verovio.toolkit.prototype.setOptions = function ( options )
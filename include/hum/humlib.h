@@ -1208,6 +1208,7 @@ class HumdrumLine : public std::string, public HumHash {
 		            HumdrumLine            (void);
 		            HumdrumLine            (const std::string& aString);
 		            HumdrumLine            (const char* aString);
+		            HumdrumLine            (const char* aString, int length);
 		            HumdrumLine            (HumdrumLine& line);
 		            HumdrumLine            (HumdrumLine& line, void* owner);
 		           ~HumdrumLine            ();
@@ -1434,6 +1435,7 @@ class HumdrumToken : public std::string, public HumHash {
 		         HumdrumToken              (HumdrumToken* token, HLp owner);
 		         HumdrumToken              (const char* token);
 		         HumdrumToken              (const std::string& token);
+		         HumdrumToken              (const char* token, int length);
 		        ~HumdrumToken              ();
 
 		bool     isNull                    (void) const;
@@ -2071,6 +2073,7 @@ class HumdrumFileBase : public HumHash {
 		                                         unsigned short int port);
 
 	protected:
+		bool          readBuffer                (const char* contents, int length);
 		bool          analyzeTokens             (void);
 		bool          analyzeSpines             (void);
 		bool          analyzeLinks              (void);
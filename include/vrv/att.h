@@ -8,6 +8,7 @@
 #ifndef __VRV_ATT_H__
 #define __VRV_ATT_H__
 
+#include <memory>
 #include <string>
 
 //----------------------------------------------------------------------------
@@ -236,6 +237,71 @@ public:
     ///@}
 };
 
+//----------------------------------------------------------------------------
+// AttSparse
+//----------------------------------------------------------------------------
+
+/**
+ * This class stores the values of an att class that are rarely set.
+ * The values are allocated only when one of them is set, and read from the shared default values otherwise,
+ * so the att class only takes a pointer in the objects where none of them is set.
+ * The default values are the ones given in the VALUES struct. Copying the storage copies the values.
+ * It is meant to be emitted by the libmei generator for the att classes of rarely used attributes, since the
+ * generated files must not be edited by hand.
+ */
+template <class VALUES> class AttSparse {
+public:
+    /** @name Constructors, destructor and assignment */
+    ///@{
+    AttSparse() {}
+    AttSparse(const AttSparse &other) : m_values(other.m_values ? new VALUES(*other.m_values) : NULL) {}
+    AttSparse &operator=(const AttSparse &other)
+    {
+        if (this != &other) m_values.reset(other.m_values ? new VALUES(*other.m_values) : NULL);
+        return *this;
+    }
+    ///@}
+
+    /**
+     * Return the values for reading them, or the default values if none is set.
+     */
+    const VALUES &Get() const { return (m_values) ? *m_values : GetDefaults(); }
+
+    /**
+     * Set a value, allocating the values if necessary.
+     * Nothing is allocated for setting a default value when none is set.
+     */
+    template <typename TYPE> void Set(TYPE VALUES::*member, const TYPE &value)
+    {
+        if (!m_values) {
+            if (GetDefaults().*member == value) return;
+            m_values.reset(new VALUES());
+        }
+        (*m_values).*member = value;
+    }
+
+    /**
+     * Reset the values to their defaults and free them.
+     */
+    void Reset() { m_values.reset(); }
+
+private:
+    /**
+     * The default values, shared by all the objects.
+     */
+    static const VALUES &GetDefaults()
+    {
+        static const VALUES defaults;
+        return defaults;
+    }
+
+public:
+    //
+private:
+    /** The values, or NULL if none is set */
+    std::unique_ptr<VALUES> m_values;
+};
+
 //----------------------------------------------------------------------------
 // Interface
 //----------------------------------------------------------------------------
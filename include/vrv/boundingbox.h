@@ -8,6 +8,8 @@
 #ifndef __VRV_BOUNDING_BOX_H__
 #define __VRV_BOUNDING_BOX_H__
 
+#include <initializer_list>
+
 //----------------------------------------------------------------------------
 
 #include "vrvdef.h"
@@ -37,6 +39,16 @@ public:
     virtual ClassId GetClassId() const;
     bool Is(ClassId classId) const { return (this->GetClassId() == classId); }
     bool Is(const std::vector<ClassId> &classIds) const;
+    bool Is(std::initializer_list<ClassId> classIds) const;
+    ///@}
+
+    /**
+     * @name Class-specific allocation of the objects and of the floating positioners.
+     * They are allocated from the current ObjectArena when there is one.
+     */
+    ///@{
+    static void *operator new(size_t size);
+    static void operator delete(void *ptr);
     ///@}
 
     /**
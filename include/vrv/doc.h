@@ -8,11 +8,17 @@
 #ifndef __VRV_DOC_H__
 #define __VRV_DOC_H__
 
+#include <unordered_map>
+
+//----------------------------------------------------------------------------
+
 #include "devicecontextbase.h"
 #include "expansionmap.h"
 #include "facsimile.h"
 #include "options.h"
+#include "playbackschedule.h"
 #include "scoredef.h"
+#include "timeindex.h"
 
 namespace smf {
 class MidiFile;
@@ -21,11 +27,16 @@ class MidiFile;
 namespace vrv {
 
 class CastOffPagesParams;
+class Clef;
 class FontInfo;
 class Glyph;
+class LayerElement;
+class MemoryStats;
+class ObjectArena;
 class Pages;
 class Page;
 class Score;
+struct TimemapEvent;
 
 enum DocType { Raw = 0, Rendering, Transcription, Facs };
 
@@ -47,6 +58,7 @@ public:
     Doc();
     virtual ~Doc();
     virtual ClassId GetClassId() const { return DOC; }
+    virtual std::string GetClassName() const { return "Doc"; }
     ///@}
 
     /**
@@ -91,6 +103,16 @@ public:
      */
     bool GenerateMeasureNumbers();
 
+    /**
+     * Fill the document with a deep copy of the content of another one, for laying it out with other options.
+     * The document is reset first. The objects keep their uuids but not their layout and drawing state, which is
+     * stored in the objects themselves, so the document has to be prepared and cast off again. No object is shared
+     * with the other document, which is not modified. The uuid generator and the current arena of the thread are
+     * shared, however, so the two documents must not be used concurrently.
+     * Page-based and mensural-only documents cannot be copied because their layout is part of the content.
+     */
+    bool CopyContentFrom(Doc *source);
+
     /**
      * Getter and setter for the DocType.
      * The setter resets the document.
@@ -197,23 +219,66 @@ public:
      * Check to see if the MIDI timemap has already been calculated.  This needs to return
      * true before ExportMIDI() or ExportTimemap() can export anything (These two functions
      * will automatically run CalculateMidiTimemap() if HasMidiTimemap() return false.
+     * The timemap does not depend on the layout and is kept when the document is cast off again
+     * or when options not affecting the timing are changed. Only the tempo adjustment option invalidates it.
+     */
+    bool HasMidiTimemap() const;
+
+    /**
+     * Reset the MIDI timemap, the time index and the playback schedule.
+     * This needs to be called when the content of the document is modified (e.g., with the editor)
+     * or when its measures are rebuilt (e.g., for mensural music).
+     */
+    void ResetMidiTimemap();
+
+    /**
+     * Return the index of the measure and note times built with the MIDI timemap.
+     */
+    const TimeIndex &GetTimeIndex() const { return m_timeIndex; }
+
+    /**
+     * Return the playback schedule, which is built with the MIDI output the first time it is needed.
+     * It is reset with the timemap. Casting off the document again only updates its page numbers.
+     */
+    const PlaybackSchedule &GetPlaybackSchedule();
+
+    /**
+     * @name Getters for the arenas of the content objects and of the layout objects.
+     * The arenas are created when first needed if the useArena option is set. NULL is returned otherwise.
+     * They are kept until the document is deleted, so a scope using them remains valid when it is reset.
+     * The content arena is used when loading or editing and the layout arena when casting off or laying out.
+     */
+    ///@{
+    ObjectArena *GetContentArena();
+    ObjectArena *GetLayoutArena();
+    ///@}
+
+    /**
+     * Add the objects of the document and its side structures to the stats.
+     * The side structures are the aligners, the floating positioners and the overflowing bounding boxes of the
+     * layout, the time index, the playback schedule, the expansion map and the arenas.
      */
-    bool HasMidiTimemap();
+    void CollectMemoryStats(MemoryStats &stats);
 
     /**
      * Export the document to a MIDI file.
      * Run trough all the layers and fill the midi file content.
+     * With a range, only its measures are processed and the output starts with the first one. Notes tied across
+     * the boundaries are cut at them. The playback schedule is filled and finalized at the same time when given.
      */
-    void ExportMIDI(smf::MidiFile *midiFile);
+    void ExportMIDI(
+        smf::MidiFile *midiFile, const PlaybackRange &range = PlaybackRange(), PlaybackSchedule *schedule = NULL);
 
     /**
      * Extract a timemap from the document to a JSON string.
      * Run trough all the layers and fill the timemap file content.
+     * With a range, only its measures are processed and only the entries within its times are given. Times remain
+     * the ones from the start of the piece. The NDJSON output starts with a line listing the IDs, to which each entry
+     * line then refers by index.
      */
-    bool ExportTimemap(std::string &output);
-    void PrepareJsonTimemap(std::string &output, std::map<double, double> &realTimeToScoreTime,
-        std::map<double, std::vector<std::string> > &realTimeToOnElements,
-        std::map<double, std::vector<std::string> > &realTimeToOffElements, std::map<double, int> &realTimeToTempo);
+    bool ExportTimemap(std::string &output, bool ndjson = false, const PlaybackRange &range = PlaybackRange());
+    void PrepareJsonTimemap(std::string &output, const std::vector<TimemapEvent> &events);
+    void PrepareNdjsonTimemap(std::string &output, const std::vector<TimemapEvent> &events);
 
     /**
      * Set the initial scoreDef of each page.
@@ -385,6 +450,19 @@ public:
     bool HasFacsimile() const { return m_facsimile != NULL; }
     ///@}
 
+    /**
+     * Return the last clef before a layer element in the document order, the element included.
+     * This is used for facsimile documents, where the clef can be in a previous layer.
+     * The clefs are cached and the cache is rebuilt when the content of the document has been modified.
+     */
+    Clef *GetFacsClef(LayerElement *element);
+
+    /**
+     * Mark the document as modified, which also invalidates the facsimile clef cache.
+     * The modifications of the objects of the document are propagated up to it.
+     */
+    virtual void Modify(bool modified = true);
+
     //----------//
     // Functors //
     //----------//
@@ -405,6 +483,17 @@ private:
      */
     int CalcMusicFontSize();
 
+    /**
+     * @name Methods for copying the content of a document (see Doc::CopyContentFrom).
+     * CopyContentChildren copies the children of a Mdiv or Pages as the document would be un-cast off, and
+     * CopyContentIds sets the uuids, comments and unsupported attributes of the copy of an object and of its
+     * descendants.
+     */
+    ///@{
+    void CopyContentChildren(Object *source, Object *target);
+    static void CopyContentIds(const Object *source, Object *target);
+    ///@}
+
 public:
     /**
      * A copy of the header tree stored as pugi::xml_document
@@ -517,9 +606,26 @@ private:
      * A flag to indicate that the MIDI timemap has been calculated.  The
      * timemap needs to be prepared before MIDI files or timemap JSON files
      * are generated. Value is 0.0 when no timemap has been generated.
+     * Otherwise it is the tempo adjustment it was calculated with.
      */
     double m_MIDITimemapTempo;
 
+    /**
+     * The sorted measure and note intervals, built with the MIDI timemap.
+     */
+    TimeIndex m_timeIndex;
+
+    /**
+     * The time-sorted playback events, built with the MIDI output.
+     */
+    PlaybackSchedule m_playbackSchedule;
+
+    /**
+     * The arenas of the content objects and of the layout objects, cleared when the document is reset.
+     */
+    ObjectArena *m_contentArena;
+    ObjectArena *m_layoutArena;
+
     /**
      * A flag to indicate whereas the document contains analytical markup to be converted.
      * This is currently limited to @fermata and @tie. Other attribute markup (@accid and @artic)
@@ -548,6 +654,11 @@ private:
 
     /** Facsimile information */
     Facsimile *m_facsimile = NULL;
+
+    /** The last clef before each layer element in the document order (see Doc::GetFacsClef) */
+    std::unordered_map<const Object *, Clef *> m_facsClefs;
+    /** A flag indicating that the facsimile clef cache is up-to-date */
+    bool m_isFacsClefCacheValid;
 };
 
 } // namespace vrv
@@ -85,6 +85,8 @@ public:
     ///@{
     BeamDrawingInterface();
     virtual ~BeamDrawingInterface();
+    BeamDrawingInterface(const BeamDrawingInterface &interface); // copy constructor;
+    BeamDrawingInterface &operator=(const BeamDrawingInterface &interface); // copy assignement;
     virtual void Reset();
     ///@}
 
@@ -9,6 +9,9 @@
 #define __VRV_EXPANSION_MAP_H__
 
 #include <map>
+#include <set>
+#include <string>
+#include <vector>
 
 //----------------------------------------------------------------------------
 
@@ -45,19 +48,57 @@ public:
 
     bool UpdateIds(Object *object);
 
-    std::vector<std::string> GetExpansionIdsForElement(const std::string &xmlId);
+    /**
+     * Return the ids of all the renditions of an element, starting with the notated one.
+     * The element can be given by the id of any of its renditions.
+     */
+    std::vector<std::string> GetExpansionIdsForElement(const std::string &xmlId) const;
 
-    void GetUuidList(Object *object, std::vector<std::string> &idList);
+    /**
+     * Return the id of the notated element for the id of any of its renditions.
+     * Return the id itself if the element was not expanded.
+     */
+    std::string GetNotatedId(const std::string &xmlId) const;
+
+    /**
+     * Return the id of the last rendition of an element given by the id of any of its renditions.
+     */
+    std::string GetLastRenditionId(const std::string &xmlId) const;
+
+    /**
+     * Return the id of a rendition of an element given by its notated id.
+     * The first rendition is the notated element itself, the following ones get a "-rend" suffix unless the derived
+     * id was already used in the document.
+     */
+    std::string GetRenditionId(const std::string &notatedId, int rendition) const;
 
 private:
-    /** Ads an id string to an original/notated id */
-    bool AddExpandedIdToExpansionMap(const std::string &origXmlId, std::string newXmlId);
+    /**
+     * Register the clone of an object and of its descendants as new renditions and set their ids.
+     * The clone is expected to have the same tree as the object.
+     */
+    void AddRendition(const Object *object, Object *clone);
+
+    /**
+     * Fill the ids of the object and of its descendants that could collide with a derived id.
+     */
+    void CollectUsedIds(const Object *object);
 
 public:
-    /** The expansion map indicates which xmlId has been repeated (expanded) elsewhere */
-    std::map<std::string, std::vector<std::string> > m_map;
+    /**
+     * The number of renditions of the elements that have been repeated (expanded) elsewhere, including the
+     * notated one, by notated id. The ids of the renditions are derived from the notated one.
+     */
+    std::map<std::string, int> m_map;
 
 private:
+    /** The generated ids of the renditions whose derived id was already used, by derived id */
+    std::map<std::string, std::string> m_generatedIds;
+    /** The notated ids of the renditions with a generated id, by generated id */
+    std::map<std::string, std::string> m_generatedNotatedIds;
+    /** The ids of the document with a "-rend" suffix before the expansion, and a flag indicating they are collected */
+    std::set<std::string> m_usedIds;
+    bool m_hasUsedIds;
 };
 
 } // namespace vrv
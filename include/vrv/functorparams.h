@@ -10,6 +10,7 @@
 
 //----------------------------------------------------------------------------
 
+#include "playbackschedule.h"
 #include "vrvdef.h"
 
 namespace smf {
@@ -1288,12 +1289,27 @@ public:
 // GenerateMIDIParams
 //----------------------------------------------------------------------------
 
+/**
+ * The MIDI track, channel and transposition of a staff
+ **/
+
+struct MIDITrackState {
+    int m_midiTrack = 1;
+    int m_midiChannel = 0;
+    int m_transSemi = 0;
+};
+
 /**
  * member 0: MidiFile*: the MidiFile we are writing to
  * member 1: int: the midi track number
- * member 3: double: the score time from the start of the music to the start of the current measure
+ * member 3: double: the score time from the start of the output to the start of the current measure
  * member 4: int: the semi tone transposition for the current track
  * member 5: int with the current tempo
+ * member 6: the track state for each staff @n, set as current when reaching a staff
+ * member 7: the playback schedule to fill along with the MidiFile (if any)
+ * member 8: the range of measures to output (if any)
+ * member 9: the score time of the start and of the end of the range (-1.0 until its first measure is reached)
+ * member 10: a flag indicating that the current measure is the first one of the range
  **/
 
 class GenerateMIDIParams : public FunctorParams {
@@ -1306,6 +1322,10 @@ public:
         m_totalTime = 0.0;
         m_transSemi = 0;
         m_currentTempo = 120;
+        m_schedule = NULL;
+        m_scoreTimeStart = 0.0;
+        m_scoreTimeEnd = -1.0;
+        m_isRangeStart = false;
         m_functor = functor;
     }
     smf::MidiFile *m_midiFile;
@@ -1314,6 +1334,12 @@ public:
     double m_totalTime;
     int m_transSemi;
     int m_currentTempo;
+    std::map<int, MIDITrackState> m_trackStates;
+    PlaybackSchedule *m_schedule;
+    PlaybackRange m_range;
+    double m_scoreTimeStart;
+    double m_scoreTimeEnd;
+    bool m_isRangeStart;
     Functor *m_functor;
 };
 
@@ -1322,13 +1348,24 @@ public:
 //----------------------------------------------------------------------------
 
 /**
- * member 0: mapping of real times to score times
- * member 1: mapping of real times to elements which should be highlighted at time
- * member 2: mapping of real times to elements which should be unhighlighted at time
- * member 3: mapping of real times to tempos
- * member 4: Score time from the start of the piece to previous barline in quarter notes
- * member 5: Real time from the start of the piece to previous barline in ms
- * member 6: Currently active tempo
+ * A note on or off event of the timemap.
+ * The tempo is the one active at the onset of the note and is only used for on events.
+ **/
+
+struct TimemapEvent {
+    double m_realTime;
+    double m_scoreTime;
+    int m_tempo;
+    bool m_isOn;
+    Object *m_element;
+};
+
+/**
+ * member 0: the note on and off events, in the order of the traversal (sorted by real time afterwards)
+ * member 1: Score time from the start of the piece to previous barline in quarter notes
+ * member 2: Real time from the start of the piece to previous barline in ms
+ * member 3: Currently active tempo
+ * member 4: the range of measures to output (if any)
  **/
 
 class GenerateTimemapParams : public FunctorParams {
@@ -1340,13 +1377,11 @@ public:
         m_currentTempo = 120;
         m_functor = functor;
     }
-    std::map<double, double> realTimeToScoreTime;
-    std::map<double, std::vector<std::string> > realTimeToOnElements;
-    std::map<double, std::vector<std::string> > realTimeToOffElements;
-    std::map<double, int> realTimeToTempo;
+    std::vector<TimemapEvent> m_events;
     double m_scoreTimeOffset;
     double m_realTimeOffsetMilliseconds;
     int m_currentTempo;
+    PlaybackRange m_range;
     Functor *m_functor;
 };
 
@@ -1462,68 +1497,6 @@ public:
     Doc *m_doc;
 };
 
-//----------------------------------------------------------------------------
-// LayerCountInTimeSpanParams
-//----------------------------------------------------------------------------
-
-/**
- * member 0: the time of the event
- * member 1: the duration of the event
- * member 2: the list of layerN found
- * member 3: the current meter signature
- * member 4: the current mensur
- * member 5: the functor for redirection
- **/
-
-class LayerCountInTimeSpanParams : public FunctorParams {
-public:
-    LayerCountInTimeSpanParams(MeterSig *meterSig, Mensur *mensur, Functor *functor)
-    {
-        m_time = 0.0;
-        m_duration = 0.0;
-        m_meterSig = meterSig;
-        m_mensur = mensur;
-        m_functor = functor;
-    }
-    double m_time;
-    double m_duration;
-    std::vector<int> m_layers;
-    MeterSig *m_meterSig;
-    Mensur *m_mensur;
-    Functor *m_functor;
-};
-
-//----------------------------------------------------------------------------
-// LayerElementsInTimeSpanParams
-//----------------------------------------------------------------------------
-
-/**
- * member 0: the time of the event
- * member 1: the duration of the event
- * member 2: the list of layer elements found
- * member 3: the current meter signature
- * member 4: the current mensur
- * member 5: layer to process elements on
- **/
-
-class LayerElementsInTimeSpanParams : public FunctorParams {
-public:
-    LayerElementsInTimeSpanParams(MeterSig *meterSig, Mensur *mensur, Layer *layer)
-    {
-        m_time = 0.0;
-        m_duration = 0.0;
-        m_meterSig = meterSig;
-        m_mensur = mensur;
-        m_layer = layer;
-    }
-    double m_time;
-    double m_duration;
-    ListOfObjects m_elements;
-    MeterSig *m_meterSig;
-    Mensur *m_mensur;
-    Layer *m_layer;
-};
-
 //----------------------------------------------------------------------------
 // OptimizeScoreDefParams
 //----------------------------------------------------------------------------
@@ -0,0 +1,64 @@
+/////////////////////////////////////////////////////////////////////////////
+// Name:        inflater.h
+// Author:      agent
+// Created:     2026
+// Copyright (c) Authors and others. All rights reserved.
+/////////////////////////////////////////////////////////////////////////////
+
+#ifndef __VRV_INFLATER_H__
+#define __VRV_INFLATER_H__
+
+#include <string>
+#include <vector>
+
+namespace vrv {
+
+//----------------------------------------------------------------------------
+// Inflater
+//----------------------------------------------------------------------------
+
+/**
+ * This class decompresses DEFLATE streams (RFC 1951) as stored in gzip files and in zip archives.
+ * It is a small self-contained implementation so that no external library is required.
+ * Only stored and deflated zip entries are supported (no Zip64 and no encryption).
+ */
+class Inflater {
+public:
+    /**
+     * @name Check the magic bytes of gzip data and of zip archives (e.g., MusicXML .mxl files)
+     */
+    ///@{
+    static bool IsGzip(const std::string &data);
+    static bool IsZip(const std::string &data);
+    ///@}
+
+    /**
+     * Decompress gzip data (RFC 1952) into the output.
+     * The output is reserved from the size stored in the gzip trailer before inflating.
+     */
+    static bool Gunzip(const std::string &data, std::string &output);
+
+    /**
+     * @name Methods for reading zip archives.
+     * Unzip returns false without logging an error if the archive has no entry with the name.
+     */
+    ///@{
+    static bool GetZipEntryNames(const std::string &data, std::vector<std::string> &names);
+    static bool Unzip(const std::string &data, const std::string &name, std::string &output);
+    ///@}
+
+    /**
+     * Decompress a raw DEFLATE stream and append it to the output.
+     * Consumed is set to the number of input bytes used by the stream.
+     */
+    static bool Inflate(const unsigned char *data, size_t length, std::string &output, size_t &consumed);
+
+    /**
+     * Compute the CRC-32 checksum used by gzip and zip.
+     */
+    static unsigned int Crc32(const char *data, size_t length);
+};
+
+} // namespace vrv
+
+#endif
@@ -167,8 +167,16 @@ public:
 
     /**
      * The main method for exporting the file to MEI.
+     * The MEI is streamed to the output while the tree is walked and the nodes written are released.
+     * Page is 0-based (all pages by default).
      */
-    bool Export();
+    bool Export(std::ostream &output, int page = -1);
+
+    /**
+     * Fill the pugi::xml_document with the MEI tree.
+     * When called by MEIOutput::Export, the nodes are streamed and released while the tree is walked.
+     */
+    bool ExportDocument(pugi::xml_document &meiDoc);
 
     /**
      * The main method for write objects.
@@ -181,7 +189,8 @@ public:
     virtual bool WriteObjectEnd(Object *object);
 
     /**
-     * Return the output as a string by writing it to the stringstream member.
+     * Return the output as a string.
+     * The string is filled directly while the tree is walked.
      */
     std::string GetOutput(int page = -1);
 
@@ -201,6 +210,25 @@ public:
     void SetRemoveIds(bool removeIds) { m_removeIds = removeIds; }
 
 private:
+    /**
+     * Export the MEI to the writer.
+     * The nodes are flushed to the writer every time a measure or a system element is completed.
+     */
+    bool Export(pugi::xml_writer &writer);
+
+    /**
+     * @name Methods for streaming the MEI tree being built.
+     * FlushStream writes the completed nodes and the start tags of the open ones and removes them from the tree.
+     * With final, all the remaining nodes are written and the open ones closed.
+     */
+    ///@{
+    void FlushStream(bool final);
+    void WriteStreamIndent(unsigned int depth);
+    void WriteStreamStartTag(pugi::xml_node node, unsigned int depth);
+    void WriteStreamEndTag(pugi::xml_node node, unsigned int depth);
+    void WriteStreamEscaped(const char *value);
+    ///@}
+
     bool WriteDoc(Doc *doc);
 
     /**
@@ -416,7 +444,12 @@ private:
 public:
     //
 private:
-    std::ostringstream m_streamStringOutput;
+    /** The writer when streaming the output (NULL otherwise) */
+    pugi::xml_writer *m_writer;
+    /** The nodes for which the start tag has already been written */
+    std::vector<pugi::xml_node> m_streamedNodes;
+    std::string m_streamIndent;
+    unsigned int m_streamFlags;
     int m_indent;
     int m_page;
     bool m_scoreBasedMEI;
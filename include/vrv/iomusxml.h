@@ -440,6 +440,56 @@ private:
     std::map<Measure *, int> m_measureCounts;
     /* measure rests */
     std::map<int, int> m_multiRests;
+
+    /*
+     * @name Precompiled XPath queries evaluated for every measure, note or direction.
+     * pugixml would otherwise compile the expression at each select_node call.
+     * Lookups of a single child use pugi::xml_node::child directly.
+     */
+    ///@{
+    /* measures and attributes */
+    const pugi::xpath_query m_xpathMultipleRest;
+    const pugi::xpath_query m_xpathFirstPartParent;
+    const pugi::xpath_query m_xpathFirstPartAncestor;
+    const pugi::xpath_query m_xpathPrecedingKey;
+    const pugi::xpath_query m_xpathMeasureRepeat;
+    const pugi::xpath_query m_xpathMeasureSlash;
+    /* directions and figured bass */
+    const pugi::xpath_query m_xpathWords;
+    const pugi::xpath_query m_xpathDynamics;
+    const pugi::xpath_query m_xpathDynamicsAndWords;
+    const pugi::xpath_query m_xpathSoundTempo;
+    const pugi::xpath_query m_xpathBracketOrDashes;
+    const pugi::xpath_query m_xpathWedges;
+    const pugi::xpath_query m_xpathExtendStart;
+    /* notes */
+    const pugi::xpath_query m_xpathNotations;
+    const pugi::xpath_query m_xpathCueType;
+    const pugi::xpath_query m_xpathBeamStart;
+    const pugi::xpath_query m_xpathBeamEnd;
+    const pugi::xpath_query m_xpathBeamContinue;
+    const pugi::xpath_query m_xpathTremolo;
+    const pugi::xpath_query m_xpathTremoloStart;
+    const pugi::xpath_query m_xpathTieStart;
+    const pugi::xpath_query m_xpathTieStop;
+    const pugi::xpath_query m_xpathUnplacedArticulation;
+    const pugi::xpath_query m_xpathBreathMark;
+    const pugi::xpath_query m_xpathFingering;
+    const pugi::xpath_query m_xpathGlissandi;
+    const pugi::xpath_query m_xpathMordent;
+    const pugi::xpath_query m_xpathExtOrnament;
+    const pugi::xpath_query m_xpathTrillMark;
+    const pugi::xpath_query m_xpathWavyLineStart;
+    const pugi::xpath_query m_xpathWavyLineStop;
+    const pugi::xpath_query m_xpathTurn;
+    const pugi::xpath_query m_xpathArpeggiate;
+    const pugi::xpath_query m_xpathSlurs;
+    const pugi::xpath_query m_xpathTupletStart;
+    const pugi::xpath_query m_xpathTupletStop;
+    const pugi::xpath_query m_xpathNextBeamEnd;
+    const pugi::xpath_query m_xpathNextTupletStart;
+    const pugi::xpath_query m_xpathNextTupletStop;
+    ///@}
 };
 
 } // namespace vrv
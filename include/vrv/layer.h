@@ -8,6 +8,10 @@
 #ifndef __VRV_LAYER_H__
 #define __VRV_LAYER_H__
 
+#include <unordered_map>
+
+//----------------------------------------------------------------------------
+
 #include "atts_shared.h"
 #include "drawinginterface.h"
 #include "object.h"
@@ -16,8 +20,11 @@ namespace vrv {
 
 class Clef;
 class DeviceContext;
+class KeySig;
 class LayerElement;
 class Measure;
+class Mensur;
+class MeterSig;
 class Note;
 class StaffDef;
 
@@ -74,7 +81,7 @@ public:
 
     /**
      * Get the current clef for the test element.
-     * Goes back on the layer until a clef is found.
+     * This is the last clef before the test element in the layer, set when the list is built.
      * This is used when inserting a note by passing a y position because we need
      * to know the clef in order to get the pitch.
      */
@@ -82,7 +89,7 @@ public:
 
     /**
      * Get the current clef based on facsimile for the test element.
-     * This goes back by facsimile position until a clef is found.
+     * This goes back in the document until a clef is found (see Doc::GetFacsClef).
      * Returns NULL if a clef cannot be found via this method.
      */
     Clef *GetClefFacs(LayerElement *test);
@@ -237,11 +244,27 @@ public:
      */
     virtual int ResetDrawing(FunctorParams *);
 
+protected:
+    /**
+     * Does not filter the list but sets the clef preceding each element.
+     */
+    virtual void FilterList(ArrayOfObjects *childList);
+
 private:
-    //
+    /**
+     * Return the clef preceding the test element in the layer, or NULL if there is none.
+     * The list is reset first, which also resets the clefs when the layer has been modified.
+     */
+    Clef *GetPreviousClef(LayerElement *test);
+
 public:
     //
 private:
+    /**
+     * The clef preceding each element of the list, only for the elements with a preceding clef
+     */
+    std::unordered_map<const Object *, Clef *> m_previousClefs;
+
     /**
      * The drawing stem direction of the layer based on the number of layers in the staff
      */
@@ -309,16 +309,6 @@ public:
      */
     virtual int FindSpannedLayerElements(FunctorParams *functorParams);
 
-    /**
-     * See Object::LayerCountInTimeSpan
-     */
-    virtual int LayerCountInTimeSpan(FunctorParams *functorParams);
-
-    /**
-     * See Object::LayerElementsInTimeSpan
-     */
-    virtual int LayerElementsInTimeSpan(FunctorParams *functorParams);
-
     /**
      * See Object::CalcOnsetOffset
      */
@@ -13,12 +13,14 @@
 #include "barline.h"
 #include "horizontalaligner.h"
 #include "object.h"
+#include "timespanindex.h"
 
 namespace vrv {
 
 class Ending;
 class ControlElement;
 class ScoreDef;
+struct PlaybackRange;
 class System;
 class TimestampAttr;
 
@@ -218,6 +220,27 @@ public:
      */
     double GetRealTimeOffsetMilliseconds(int repeat) const;
 
+    /**
+     * Return the number of times the measure is played.
+     */
+    int GetRepeatCount() const { return (int)m_realTimeOffsetMilliseconds.size(); }
+
+    /**
+     * Return the real time duration of the measure in millisecond (rounded).
+     */
+    int GetRealTimeDurationMilliseconds() const;
+
+    /**
+     * Return the score time duration of the measure in quarter notes.
+     */
+    double GetScoreTimeDuration() const;
+
+    /**
+     * Check if the measure is within a playback range and update the flags of the range.
+     * Return FUNCTOR_CONTINUE if it is, FUNCTOR_SIBLINGS if it is before and FUNCTOR_STOP if it is after.
+     */
+    int CheckPlaybackRange(PlaybackRange &range) const;
+
     //----------//
     // Functors //
     //----------//
@@ -430,6 +453,11 @@ public:
      */
     mutable MeasureAligner m_measureAligner;
 
+    /**
+     * The index of the time spans of the layer elements in the measure aligner
+     */
+    TimeSpanIndex m_timeSpanIndex;
+
     TimestampAligner m_timestampAligner;
 
 protected:
@@ -0,0 +1,95 @@
+/////////////////////////////////////////////////////////////////////////////
+// Name:        memorystats.h
+// Author:      agent
+// Created:     2026
+// Copyright (c) Authors and others. All rights reserved.
+/////////////////////////////////////////////////////////////////////////////
+
+#ifndef __VRV_MEMORYSTATS_H__
+#define __VRV_MEMORYSTATS_H__
+
+#include <cstddef>
+#include <map>
+#include <string>
+
+namespace vrv {
+
+class BoundingBox;
+class Object;
+
+//----------------------------------------------------------------------------
+// MemoryStats
+//----------------------------------------------------------------------------
+
+/**
+ * This class accumulates the number of objects of a document and the memory they use, by class and by side
+ * structure (e.g., aligners or indexes). The size of an object is the size of its class and does not include the
+ * memory it owns (e.g., strings or vectors). The sizes of the side structures are estimates.
+ */
+class MemoryStats {
+public:
+    /**
+     * A number of items and their size in bytes
+     */
+    struct Entry {
+        int m_count = 0;
+        size_t m_size = 0;
+    };
+
+    /** @name Constructors and destructor */
+    ///@{
+    MemoryStats();
+    virtual ~MemoryStats();
+    ///@}
+
+    /**
+     * Reset the stats.
+     */
+    void Reset();
+
+    /**
+     * Add an object with the size of its class.
+     */
+    void AddObject(const Object *object, size_t size);
+
+    /**
+     * Add the descendants of an object, which are allocated with new.
+     * With a structure name, they are added to the structure instead of their class.
+     */
+    void AddDescendants(const Object *object, const std::string &structure = "");
+
+    /**
+     * Add items and their size to a side structure.
+     */
+    void AddStructure(const std::string &structure, int count, size_t size);
+
+    /**
+     * Return the size of the class of an object or a positioner allocated with new.
+     */
+    static size_t GetAllocatedSize(const BoundingBox *boundingBox);
+
+    /**
+     * @name Getters for the objects by class name, the side structures and their totals
+     */
+    ///@{
+    const std::map<std::string, Entry> &GetObjects() const { return m_objects; }
+    const std::map<std::string, Entry> &GetStructures() const { return m_structures; }
+    Entry GetObjectTotal() const { return GetTotal(m_objects); }
+    Entry GetStructureTotal() const { return GetTotal(m_structures); }
+    ///@}
+
+private:
+    static Entry GetTotal(const std::map<std::string, Entry> &entries);
+
+public:
+    //
+private:
+    /** The objects by class name */
+    std::map<std::string, Entry> m_objects;
+    /** The side structures by name */
+    std::map<std::string, Entry> m_structures;
+};
+
+} // namespace vrv
+
+#endif
@@ -44,15 +44,6 @@ public:
     /** Override the method since check is required */
     virtual bool IsScoreDefElement() const { return (this->GetParent() && this->GetFirstAncestor(SCOREDEF)); }
 
-    //----------//
-    // Functors //
-    //----------//
-
-    /**
-     * See Object::LayerCountInTimeSpan
-     */
-    virtual int LayerCountInTimeSpan(FunctorParams *functorParams);
-
 private:
     //
 public:
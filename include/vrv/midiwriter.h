@@ -0,0 +1,85 @@
+/////////////////////////////////////////////////////////////////////////////
+// Name:        midiwriter.h
+// Author:      agent
+// Created:     2026
+// Copyright (c) Authors and others. All rights reserved.
+/////////////////////////////////////////////////////////////////////////////
+
+#ifndef __VRV_MIDIWRITER_H__
+#define __VRV_MIDIWRITER_H__
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace smf {
+class MidiEventList;
+class MidiFile;
+} // namespace smf
+
+namespace vrv {
+
+//----------------------------------------------------------------------------
+// MIDIWriter
+//----------------------------------------------------------------------------
+
+/**
+ * This class writes a MIDI file filled by Doc::ExportMIDI as a Standard MIDI File.
+ * The events of a track are generated layer by layer and measure by measure, so each track is made of runs
+ * of events that are already in order. Instead of sorting the tracks and converting them to delta ticks,
+ * the runs are merged and the delta ticks are encoded directly into the output.
+ * The events are ordered as with smf::MidiFile::sortTracks, and simultaneous events keep the document order.
+ */
+class MIDIWriter {
+public:
+    /** @name Constructors and destructor */
+    ///@{
+    MIDIWriter();
+    virtual ~MIDIWriter();
+    ///@}
+
+    /**
+     * Write the MIDI file into the output.
+     * The ticks of the MIDI file have to be absolute. The MIDI file is not modified.
+     */
+    void Write(const smf::MidiFile &midiFile, std::string &output);
+
+private:
+    /**
+     * Write a track chunk with the events of the track merged by key.
+     */
+    void WriteTrack(const smf::MidiEventList &track, std::string &output);
+
+    /**
+     * Return the sort key of an event, with the tick in the high bits and then the order of the event type.
+     */
+    static int64_t GetEventKey(int tick, const std::vector<unsigned char> &message);
+
+    /**
+     * @name Methods for encoding numbers
+     */
+    ///@{
+    static void WriteVLValue(int value, std::string &output);
+    static void WriteBigEndian(uint32_t value, int byteCount, std::string &output);
+    ///@}
+
+public:
+    //
+private:
+    /**
+     * A run of events already in order in a track, with the index of its next event.
+     */
+    struct EventRun {
+        int m_current;
+        int m_end;
+    };
+
+    /** The keys of the events of the track being written */
+    std::vector<int64_t> m_keys;
+    /** The runs of the track being written */
+    std::vector<EventRun> m_runs;
+};
+
+} // namespace vrv
+
+#endif
@@ -73,6 +73,11 @@ public:
     virtual ClassId GetClassId() const { return NOTE; }
     ///@}
 
+    /**
+     * Overriding CloneReset() method to be called after copy / assignment calls.
+     */
+    virtual void CloneReset();
+
     /**
      * @name Getter to interfaces
      */
@@ -213,6 +218,12 @@ public:
     char GetMIDIPitch();
     ///@}
 
+    /**
+     * Return the duration of the notes tied after this one by following the ties.
+     * Only the first note of a tied group stores it, this is used for starting the output within the group.
+     */
+    double GetFollowingTiedDuration();
+
     /**
      * Helper to adjust overlaping layers for notes
      */
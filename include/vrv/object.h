@@ -8,10 +8,13 @@
 #ifndef __VRV_OBJECT_H__
 #define __VRV_OBJECT_H__
 
+#include <atomic>
+#include <bitset>
 #include <cstdlib>
 #include <ctime>
 #include <iterator>
 #include <map>
+#include <memory>
 #include <string>
 
 //----------------------------------------------------------------------------
@@ -22,6 +25,7 @@
 
 namespace vrv {
 
+class ChildRange;
 class Doc;
 class DurationInterface;
 class EditorialElement;
@@ -43,6 +47,69 @@ class Zone;
 #define FORWARD true
 #define BACKWARD false
 
+//----------------------------------------------------------------------------
+// ObjectMetadata
+//----------------------------------------------------------------------------
+
+/**
+ * This class holds the data shared by all the instances of a class, namely the uuid prefix and the MEI att classes
+ * and interfaces registered by the constructors. Instances are interned and never deleted. Registering an att class
+ * or an interface moves an object to the metadata including it, which is created only once for each class.
+ * Once created, metadata are found without locking since the lists holding them are only ever prepended to.
+ */
+class ObjectMetadata {
+public:
+    /**
+     * Return the metadata with only the uuid prefix, the starting point of every constructor.
+     */
+    static const ObjectMetadata *Get(const std::string &classid);
+
+    /**
+     * @name Return the metadata with an att class or an interface (and its att classes) added.
+     */
+    ///@{
+    const ObjectMetadata *AddAttClass(AttClassId attClassId) const;
+    const ObjectMetadata *AddInterface(const std::vector<AttClassId> *attClasses, InterfaceId interfaceId) const;
+    ///@}
+
+    /**
+     * @name Getters
+     */
+    ///@{
+    const std::string &GetClassid() const { return m_classid; }
+    bool HasAttClass(AttClassId attClassId) const { return m_attClasses[attClassId]; }
+    bool HasInterface(InterfaceId interfaceId) const { return m_interfaces[interfaceId]; }
+    ///@}
+
+private:
+    ObjectMetadata(const std::string &classid);
+
+    /**
+     * Return the metadata following this one for the key, creating it with the function if necessary.
+     */
+    template <class FUNCTION> const ObjectMetadata *GetNext(int key, FUNCTION addTo) const;
+
+    /**
+     * An entry of a list of metadata, never modified once added to the list.
+     */
+    struct Entry {
+        int m_key;
+        const ObjectMetadata *m_metadata;
+        const Entry *m_next;
+    };
+
+public:
+    //
+private:
+    /** The uuid prefix */
+    std::string m_classid;
+    /** The att classes and interfaces */
+    std::bitset<ATT_CLASS_max> m_attClasses;
+    std::bitset<INTERFACE_max> m_interfaces;
+    /** The metadata already created from this one, by att class or by interface (after the att classes) */
+    mutable std::atomic<const Entry *> m_next;
+};
+
 //----------------------------------------------------------------------------
 // Object
 //----------------------------------------------------------------------------
@@ -120,16 +187,10 @@ public:
      * @name Methods for registering a MEI att class and for registering interfaces regrouping MEI att classes.
      */
     ///@{
-    void RegisterAttClass(AttClassId attClassId) { m_attClasses.push_back(attClassId); }
-    bool HasAttClass(AttClassId attClassId) const
-    {
-        return std::find(m_attClasses.begin(), m_attClasses.end(), attClassId) != m_attClasses.end();
-    }
+    void RegisterAttClass(AttClassId attClassId) { m_metadata = m_metadata->AddAttClass(attClassId); }
+    bool HasAttClass(AttClassId attClassId) const { return m_metadata->HasAttClass(attClassId); }
     void RegisterInterface(std::vector<AttClassId> *attClasses, InterfaceId interfaceId);
-    bool HasInterface(InterfaceId interfaceId) const
-    {
-        return std::find(m_interfaces.begin(), m_interfaces.end(), interfaceId) != m_interfaces.end();
-    }
+    bool HasInterface(InterfaceId interfaceId) const { return m_metadata->HasInterface(interfaceId); }
     ///@}
 
     virtual DurationInterface *GetDurationInterface() { return NULL; }
@@ -230,12 +291,12 @@ public:
     /**
      * Methods for setting / getting comments
      */
-    std::string GetComment() const { return m_comment; }
-    void SetComment(std::string comment) { m_comment = comment; }
-    bool HasComment() { return !m_comment.empty(); }
-    std::string GetClosingComment() const { return m_closingComment; }
-    void SetClosingComment(std::string endComment) { m_closingComment = endComment; }
-    bool HasClosingComment() { return !m_closingComment.empty(); }
+    std::string GetComment() const { return (m_comments) ? m_comments->m_comment : ""; }
+    void SetComment(std::string comment);
+    bool HasComment() { return (m_comments && !m_comments->m_comment.empty()); }
+    std::string GetClosingComment() const { return (m_comments) ? m_comments->m_closingComment : ""; }
+    void SetClosingComment(std::string endComment);
+    bool HasClosingComment() { return (m_comments && !m_comments->m_closingComment.empty()); }
 
     /**
      * @name Children count, with or without a ClassId.
@@ -277,16 +338,16 @@ public:
     bool HasAttribute(std::string attribute, std::string value) const;
 
     /**
-     * @name Iterator methods for accessing children.
-     * GetFirst returns the first element child of the specified type.
-     * Its position and the specified type are stored and used of accessing next elements
-     * The methods returns NULL when no child is found or when the end is reached.
-     * Always call GetFirst before calling GetNext() or call GetNext(child)
+     * Return the first child of the specified type, or NULL if there is none.
      */
-    ///@{
-    Object *GetFirst(const ClassId classId = UNSPECIFIED);
-    Object *GetNext();
-    ///@}
+    Object *GetFirst(const ClassId classId = UNSPECIFIED) const;
+
+    /**
+     * Return a range for iterating over the children of the specified type (all children with UNSPECIFIED).
+     * No iteration state is stored in the object, so iterations can be nested and run concurrently.
+     * Children must not be added or removed during the iteration (see ChildRange).
+     */
+    ChildRange GetChildRange(const ClassId classId = UNSPECIFIED) const;
 
     /**
      * @name Retrieving next or previous sibling of a certain type.
@@ -481,7 +542,7 @@ public:
     /**
      * Mark the object and its parent (if any) as modified
      */
-    void Modify(bool modified = true);
+    virtual void Modify(bool modified = true);
 
     /**
      * @name Setter and getter of the attribute flag
@@ -532,6 +593,7 @@ public:
      * This is the generic way for parsing the tree, e.g., for extracting one single staff or layer.
      * Deepness specifies how many child levels should be processed. UNLIMITED_DEPTH means no
      * limit (EditorialElement objects do not count).
+     * The tree is traversed with an explicit stack and not recursively.
      */
     virtual void Process(Functor *functor, FunctorParams *functorParams, Functor *endFunctor = NULL,
         ArrayOfComparisons *filters = NULL, int deepness = UNLIMITED_DEPTH, bool direction = FORWARD);
@@ -579,16 +641,6 @@ public:
      */
     virtual int FindAllReferencedObjects(FunctorParams *functorParams);
 
-    /**
-     * Look if the time / duration passed as parameter overlap with a space in the alignment references
-     */
-    virtual int LayerCountInTimeSpan(FunctorParams *) { return FUNCTOR_CONTINUE; }
-
-    /**
-     * Look for all the layer elements that overlap with the time / duration within certain layer passed as parameter
-     */
-    virtual int LayerElementsInTimeSpan(FunctorParams *functorParams) { return FUNCTOR_CONTINUE; }
-
     /**
      * Retrieve the layer elements spanned by two points
      */
@@ -1242,12 +1294,9 @@ private:
     Object *m_parent;
 
     /**
-     * Members for storing / generating uuids
+     * Member for storing / generating uuids
      */
-    ///@{
     std::string m_uuid;
-    std::string m_classid;
-    ///@}
 
     /**
      * A reference object do not own children.
@@ -1264,33 +1313,22 @@ private:
     mutable bool m_isModified;
 
     /**
-     * Members used for caching iterator values.
-     * See Object::IterGetFirst, Object::IterGetNext and Object::IterIsNotEnd
-     * Values are set when GetFirst is called (which is mandatory)
-     */
-    ///@{
-    ArrayOfObjects::iterator m_iteratorEnd, m_iteratorCurrent;
-    ClassId m_iteratorElementType;
-    ///@}
-
-    /**
-     * A vector for storing the list of AttClassId (MEI att classes) implemented.
+     * The uuid prefix and the AttClassId (MEI att classes) and InterfaceId (group of MEI att classes) implemented.
+     * They are shared by all the instances of the class.
      */
-    std::vector<AttClassId> m_attClasses;
+    const ObjectMetadata *m_metadata;
 
     /**
-     * A vector for storing the list of InterfaceId (group of MEI att classes) implemented.
-     */
-    std::vector<InterfaceId> m_interfaces;
-
-    /**
-     * String for storing a comments attached to the object when printing an MEI element.
+     * Strings for storing comments attached to the object when printing an MEI element.
      * m_comment is to be printed immediately before the element
      * m_closingComment is to be printed before the closing tag of the element
+     * Few objects have comments, so they are allocated only when set.
      */
-    std::string m_comment;
-    std::string m_closingComment;
-    ///@}
+    struct Comments {
+        std::string m_comment;
+        std::string m_closingComment;
+    };
+    std::unique_ptr<Comments> m_comments;
 
     /**
      * A flag indicating if the Object represents an attribute in the original MEI.
@@ -1309,6 +1347,77 @@ private:
     static unsigned long s_objectCounter;
 };
 
+//----------------------------------------------------------------------------
+// ChildRange
+//----------------------------------------------------------------------------
+
+/**
+ * This class is a range over the children of an object, filtered by ClassId (all children with UNSPECIFIED).
+ * It is meant to be used in range-based for loops and is returned by Object::GetChildRange.
+ * The position is held by the iterator, so several iterations over the same parent can be nested or run
+ * concurrently. The children must not be added or removed while iterating, but can be relinquished.
+ */
+class ChildRange {
+public:
+    /**
+     * The iterator, skipping the children of another type.
+     */
+    class Iterator {
+    public:
+        Iterator(ArrayOfObjects::const_iterator current, ArrayOfObjects::const_iterator end, ClassId classId)
+            : m_current(current), m_end(end), m_classId(classId)
+        {
+            this->SkipOthers();
+        }
+
+        Object *operator*() const { return *m_current; }
+        Iterator &operator++()
+        {
+            ++m_current;
+            this->SkipOthers();
+            return *this;
+        }
+        bool operator==(const Iterator &other) const { return (m_current == other.m_current); }
+        bool operator!=(const Iterator &other) const { return (m_current != other.m_current); }
+
+    private:
+        void SkipOthers()
+        {
+            if (m_classId == UNSPECIFIED) return;
+            while ((m_current != m_end) && ((*m_current)->GetClassId() != m_classId)) ++m_current;
+        }
+
+        ArrayOfObjects::const_iterator m_current;
+        ArrayOfObjects::const_iterator m_end;
+        ClassId m_classId;
+    };
+
+    ChildRange(const ArrayOfObjects &children, ClassId classId) : m_children(children), m_classId(classId) {}
+
+    /**
+     * @name The begin and end iterators
+     */
+    ///@{
+    Iterator begin() const { return Iterator(m_children.begin(), m_children.end(), m_classId); }
+    Iterator end() const { return Iterator(m_children.end(), m_children.end(), UNSPECIFIED); }
+    ///@}
+
+private:
+    //
+public:
+    //
+private:
+    /** The children iterated over */
+    const ArrayOfObjects &m_children;
+    /** The ClassId filtering the children */
+    ClassId m_classId;
+};
+
+inline ChildRange Object::GetChildRange(const ClassId classId) const
+{
+    return ChildRange(m_children, classId);
+}
+
 //----------------------------------------------------------------------------
 // ObjectListInterface
 //----------------------------------------------------------------------------
@@ -1358,7 +1467,6 @@ public:
 
 private:
     mutable ArrayOfObjects m_list;
-    ArrayOfObjects::iterator m_iteratorCurrent;
 
 protected:
     /**
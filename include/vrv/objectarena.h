@@ -0,0 +1,140 @@
+/////////////////////////////////////////////////////////////////////////////
+// Name:        objectarena.h
+// Author:      agent
+// Created:     2026
+// Copyright (c) Authors and others. All rights reserved.
+/////////////////////////////////////////////////////////////////////////////
+
+#ifndef __VRV_OBJECTARENA_H__
+#define __VRV_OBJECTARENA_H__
+
+#include <cstddef>
+#include <vector>
+
+namespace vrv {
+
+//----------------------------------------------------------------------------
+// ObjectArena
+//----------------------------------------------------------------------------
+
+/**
+ * This class allocates the objects of a document from large chunks of memory.
+ * Allocating is a pointer bump, and deleted objects go to a free list by size for being reused.
+ * The chunks are freed all at once when the document is reset, or when the arena has been released by its
+ * document and all its objects have been deleted, so objects moved out of the document remain valid.
+ * Each arena block starts with a header pointing to its arena. Objects allocated outside any arena (or too large)
+ * are plain heap blocks without header, and the chunks of all the arenas tell them apart when deleted.
+ * The arena used is the current one for the thread (see ObjectArenaScope).
+ * A document can be used by different threads one after the other, but an arena is not thread-safe and its objects
+ * must not be created or deleted concurrently.
+ */
+class ObjectArena {
+public:
+    /** @name Constructors and destructor */
+    ///@{
+    ObjectArena();
+    virtual ~ObjectArena();
+    ///@}
+
+    /**
+     * Free all the chunks if all the objects have been deleted.
+     * Return false if some objects remain, in which case the chunks are kept.
+     */
+    bool Clear();
+
+    /**
+     * Release the arena from its owner.
+     * The arena deletes itself as soon as all its objects are deleted.
+     */
+    void Release();
+
+    /**
+     * @name Getters for the memory use
+     */
+    ///@{
+    int GetObjectCount() const { return m_objectCount; }
+    size_t GetReservedSize() const { return m_chunks.size() * CHUNK_SIZE; }
+    ///@}
+
+    /**
+     * @name Allocate and deallocate a block from the current arena, or from the heap if there is none.
+     * These are called by the class-specific new and delete operators of BoundingBox.
+     */
+    ///@{
+    static void *AllocateBlock(size_t size);
+    static void DeallocateBlock(void *ptr);
+    ///@}
+
+    /**
+     * Return the size of a block allocated with AllocateBlock.
+     * This is the size requested for arena blocks, and the size given by the allocator for heap blocks.
+     * The pointer has to be the one returned, i.e., of the most derived object when called for an object.
+     */
+    static size_t GetBlockSize(const void *ptr);
+
+    /**
+     * Return the current arena for the thread, or NULL.
+     */
+    static ObjectArena *GetCurrent();
+
+private:
+    /**
+     * Allocate and deallocate a block of the size class.
+     */
+    ///@{
+    void *Allocate(int sizeClass);
+    void Deallocate(void *block, int sizeClass);
+    ///@}
+
+public:
+    /** The size of the chunks allocated */
+    static const size_t CHUNK_SIZE = 256 * 1024;
+
+private:
+    /** The alignment and the granularity of the size classes */
+    static const size_t BLOCK_ALIGNMENT = 16;
+    /** The largest block (with its header), larger blocks are allocated from the heap */
+    static const size_t MAX_BLOCK_SIZE = 4096;
+
+    /** The chunks allocated */
+    std::vector<char *> m_chunks;
+    /** The position of the next block and the end of the current chunk */
+    char *m_current;
+    char *m_end;
+    /** The heads of the free lists by size class */
+    std::vector<void *> m_freeLists;
+    /** The number of objects currently allocated */
+    int m_objectCount;
+    /** A flag indicating that the owner has released the arena */
+    bool m_isReleased;
+};
+
+//----------------------------------------------------------------------------
+// ObjectArenaScope
+//----------------------------------------------------------------------------
+
+/**
+ * This class makes an arena the current one for the thread during its lifetime.
+ * The previous arena is restored when it is destroyed, so scopes can be nested.
+ * A NULL arena means that the objects are allocated from the heap.
+ */
+class ObjectArenaScope {
+public:
+    /** @name Constructors and destructor */
+    ///@{
+    ObjectArenaScope(ObjectArena *arena);
+    virtual ~ObjectArenaScope();
+    ///@}
+
+private:
+    //
+public:
+    //
+private:
+    /** The arena current before the scope */
+    ObjectArena *m_previous;
+};
+
+} // namespace vrv
+
+#endif
@@ -501,6 +501,7 @@ public:
     OptionBool m_humType;
     OptionBool m_justifyVertically;
     OptionBool m_landscape;
+    OptionBool m_memoryStats;
     OptionBool m_mensuralToMeasure;
     OptionDbl m_midiTempoAdjustment;
     OptionDbl m_minLastJustification;
@@ -524,6 +525,7 @@ public:
     OptionBool m_svgViewBox;
     OptionBool m_svgHtml5;
     OptionInt m_unit;
+    OptionBool m_useArena;
     OptionBool m_useFacsimile;
     OptionBool m_usePgFooterForAll;
     OptionBool m_usePgHeaderForAll;
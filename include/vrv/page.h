@@ -10,6 +10,7 @@
 
 #include "object.h"
 #include "scoredef.h"
+#include "spatialindex.h"
 
 namespace vrv {
 
@@ -94,6 +95,19 @@ public:
      */
     void LayOutTranscription(bool force = false);
 
+    /**
+     * Return the spatial index of the bounding boxes of the page, building it if necessary.
+     * The page has to be laid out and to be the drawing page of the document.
+     * The bounding boxes are filled again before building it unless Page::LayOut already did it.
+     */
+    const SpatialIndex *GetSpatialIndex();
+
+    /**
+     * Mark the page as modified, which also resets its spatial index.
+     * The modifications of the objects of the page are propagated up to it.
+     */
+    virtual void Modify(bool modified = true);
+
     /**
      * Lay out the content of the page (measures and their content) horizontally
      */
@@ -214,6 +228,12 @@ public:
      */
     double m_justificationSum;
 
+    /**
+     * The spatial index of the bounding boxes for hit testing.
+     * It is reset when the page is laid out again or modified (see Page::Modify) and built by Page::GetSpatialIndex.
+     */
+    SpatialIndex m_spatialIndex;
+
 private:
     /**
      * A flag for indicating whether the layout has been done or not.
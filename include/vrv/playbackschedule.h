@@ -0,0 +1,227 @@
+/////////////////////////////////////////////////////////////////////////////
+// Name:        playbackschedule.h
+// Author:      agent
+// Created:     2026
+// Copyright (c) Authors and others. All rights reserved.
+/////////////////////////////////////////////////////////////////////////////
+
+#ifndef __VRV_PLAYBACKSCHEDULE_H__
+#define __VRV_PLAYBACKSCHEDULE_H__
+
+#include <cstddef>
+#include <vector>
+
+namespace vrv {
+
+class Measure;
+class Note;
+
+//----------------------------------------------------------------------------
+// PlaybackEvent
+//----------------------------------------------------------------------------
+
+enum PlaybackEventType { PLAYBACK_TEMPO = 0, PLAYBACK_NOTE_OFF, PLAYBACK_NOTE_ON };
+
+/**
+ * An event of the playback schedule.
+ * Times are absolute, in milliseconds and in quarter notes from the start of the piece.
+ * The note, pitch, velocity and channel are unset (NULL or 0) for tempo events.
+ */
+struct PlaybackEvent {
+    double m_time;
+    double m_scoreTime;
+    PlaybackEventType m_type;
+    Note *m_note;
+    Measure *m_measure;
+    int m_page;
+    int m_tempo;
+    char m_pitch;
+    char m_velocity;
+    char m_channel;
+};
+
+//----------------------------------------------------------------------------
+// PlaybackRange
+//----------------------------------------------------------------------------
+
+/**
+ * A range of measures (included) or of real time (in milliseconds, included) for restricting the MIDI and timemap
+ * output. A missing start or end measure means the beginning or the end of the document, as does a negative end time.
+ * The time range selects the measures overlapping it. The flags are updated by the measures during the traversal.
+ */
+struct PlaybackRange {
+    Measure *m_startMeasure = NULL;
+    Measure *m_endMeasure = NULL;
+    double m_startTime = 0.0;
+    double m_endTime = -1.0;
+    bool m_isStarted = false;
+    bool m_isEnded = false;
+
+    bool IsSet() const { return (m_startMeasure || m_endMeasure || (m_startTime > 0.0) || (m_endTime >= 0.0)); }
+};
+
+//----------------------------------------------------------------------------
+// PlaybackSchedule
+//----------------------------------------------------------------------------
+
+/**
+ * This class stores the tempo changes and the note on and off events of a document in a single time-sorted array.
+ * It is filled by Doc::ExportMIDI with the same pitches, velocities and channels as the MIDI output, so that
+ * a player can follow the playback without traversing the tree. Pages are 1-based and need the document to be
+ * cast off; they are 0 otherwise. Events at the same time are ordered tempo first, then offs, then ons.
+ */
+class PlaybackSchedule {
+public:
+    /** @name Constructors and destructor */
+    ///@{
+    PlaybackSchedule();
+    virtual ~PlaybackSchedule();
+    ///@}
+
+    /**
+     * Reset the schedule.
+     * This needs to be called when the objects of the document or its pagination are modified.
+     */
+    void Reset();
+
+    /**
+     * Return true if the schedule has been built
+     */
+    bool IsBuilt() const { return m_isBuilt; }
+
+    /**
+     * @name Methods for keeping the page numbers up to date.
+     * The timing of the events does not depend on the layout, so casting off the document again only needs the
+     * page numbers to be updated from the measures instead of rebuilding the schedule.
+     */
+    ///@{
+    void ResetPages() { m_hasPages = false; }
+    bool HasPages() const { return m_hasPages; }
+    void UpdatePages();
+    ///@}
+
+    /**
+     * @name Methods for filling the schedule while generating MIDI.
+     * A measure needs to be added before its notes. Note times are given in quarter notes because the tied
+     * notes can end in a measure with another tempo. Finalize converts them and sorts the events.
+     */
+    ///@{
+    void AddMeasure(Measure *measure, double scoreTimeOffset, double realTimeOffset, int tempo);
+    void AddNote(Note *note, double scoreTimeOnset, double scoreTimeOffset, int pitch, int velocity, int channel);
+    void Finalize();
+    ///@}
+
+    /**
+     * @name Getters for the events
+     */
+    ///@{
+    const std::vector<PlaybackEvent> &GetEvents() const { return m_events; }
+    int GetEventCount() const { return (int)m_events.size(); }
+    ///@}
+
+    /**
+     * Return the memory used by the events and the measure anchors
+     */
+    size_t GetMemorySize() const
+    {
+        return m_events.capacity() * sizeof(PlaybackEvent) + m_anchors.capacity() * sizeof(MeasureAnchor);
+    }
+
+    /**
+     * Return the index of the first event at or after the time (or the event count if there is none).
+     */
+    int GetEventIndex(double millisec) const;
+
+private:
+    /**
+     * Convert a score time (in quarter notes) to a real time with the tempo of the measure it falls in.
+     */
+    double GetRealTime(double scoreTime) const;
+
+    /**
+     * Return the 1-based index of the page of the measure, or 0 if the document is not cast off.
+     */
+    static int GetPageNumber(Measure *measure);
+
+public:
+    //
+private:
+    /**
+     * The start of each measure, sorted by score time, for converting score times to real times.
+     */
+    struct MeasureAnchor {
+        double m_scoreTime;
+        double m_realTime;
+        int m_tempo;
+    };
+
+    /** The events, sorted by time once finalized */
+    std::vector<PlaybackEvent> m_events;
+    /** The measure anchors */
+    std::vector<MeasureAnchor> m_anchors;
+    /** The measure currently filled and its page */
+    Measure *m_currentMeasure;
+    int m_currentPage;
+    /** A flag indicating that the schedule has been built */
+    bool m_isBuilt;
+    /** A flag indicating that the page numbers match the current layout */
+    bool m_hasPages;
+};
+
+//----------------------------------------------------------------------------
+// PlaybackCursor
+//----------------------------------------------------------------------------
+
+/**
+ * This class iterates over the events of a playback schedule.
+ * Seeking is a binary search and advancing is constant time, so it can be used from an audio thread.
+ * The schedule must outlive the cursor and must not be reset while the cursor is used.
+ */
+class PlaybackCursor {
+public:
+    /** @name Constructors and destructor */
+    ///@{
+    PlaybackCursor(const PlaybackSchedule *schedule);
+    virtual ~PlaybackCursor();
+    ///@}
+
+    /**
+     * Move the cursor to the first event at or after the time.
+     */
+    void Seek(double millisec);
+
+    /**
+     * Return true if the cursor is past the last event.
+     */
+    bool IsAtEnd() const;
+
+    /**
+     * Return the current event without advancing, or NULL at the end.
+     */
+    const PlaybackEvent *Peek() const;
+
+    /**
+     * Return the current event and advance the cursor, or NULL at the end.
+     */
+    const PlaybackEvent *Next();
+
+    /**
+     * Return the next event if it is at or before the time and advance the cursor, or NULL otherwise.
+     * This is meant to be called in a loop with the current playback time.
+     */
+    const PlaybackEvent *NextUntil(double millisec);
+
+private:
+    //
+public:
+    //
+private:
+    /** The schedule iterated over */
+    const PlaybackSchedule *m_schedule;
+    /** The index of the current event */
+    int m_index;
+};
+
+} // namespace vrv
+
+#endif
@@ -0,0 +1,132 @@
+/////////////////////////////////////////////////////////////////////////////
+// Name:        spatialindex.h
+// Author:      agent
+// Created:     2026
+// Copyright (c) Authors and others. All rights reserved.
+/////////////////////////////////////////////////////////////////////////////
+
+#ifndef __VRV_SPATIALINDEX_H__
+#define __VRV_SPATIALINDEX_H__
+
+#include <cstddef>
+#include <vector>
+
+namespace vrv {
+
+class Doc;
+class Object;
+class Page;
+
+//----------------------------------------------------------------------------
+// SpatialIndex
+//----------------------------------------------------------------------------
+
+/**
+ * This class stores the bounding boxes of the objects of a laid-out page in a uniform grid for hit testing.
+ * The boxes are in the coordinates of the SVG output, i.e., in the viewBox of the definition-scale element, with the
+ * page margins included and the y axis pointing down.
+ * Each cell lists the boxes overlapping it in the document order. Boxes spanning too many cells (e.g., systems or
+ * measures) are not put in the cells but are always tested.
+ * The index is built by Page::GetSpatialIndex and holds pointers to the objects of the page.
+ */
+class SpatialIndex {
+public:
+    /** @name Constructors and destructor */
+    ///@{
+    SpatialIndex();
+    virtual ~SpatialIndex();
+    ///@}
+
+    /**
+     * Reset the index.
+     * This needs to be called when the page is laid out again or when its objects are modified or deleted.
+     */
+    void Reset();
+
+    /**
+     * Fill the index from the bounding boxes of the descendants of the page.
+     * The page has to be the drawing page of the document and its bounding boxes have to be up-to-date.
+     * Objects with no self bounding box use their content bounding box, and objects with none are skipped.
+     */
+    void Build(Page *page, Doc *doc);
+
+    /**
+     * Return true if the index has been built
+     */
+    bool IsBuilt() const { return m_isBuilt; }
+
+    /**
+     * @name Getters for the number of boxes and the memory they use
+     */
+    ///@{
+    int GetBoxCount() const { return (int)m_boxes.size(); }
+    size_t GetMemorySize() const
+    {
+        return m_boxes.capacity() * sizeof(Box)
+            + (m_largeBoxes.capacity() + m_cellStarts.capacity() + m_cellBoxes.capacity()) * sizeof(int);
+    }
+    ///@}
+
+    /**
+     * Fill the objects with a bounding box overlapping the rectangle (edges included).
+     * The objects are given in the document order.
+     */
+    void GetObjectsInRect(int left, int top, int right, int bottom, std::vector<Object *> &objects) const;
+
+    /**
+     * Fill the objects with a bounding box within the radius of the point.
+     * The objects are given in the document order.
+     */
+    void GetObjectsAtPoint(int x, int y, int radius, std::vector<Object *> &objects) const;
+
+private:
+    /**
+     * The bounding box of an object in SVG coordinates
+     */
+    struct Box {
+        Object *m_object;
+        int m_left;
+        int m_top;
+        int m_right;
+        int m_bottom;
+    };
+
+    /**
+     * Fill the indexes of the boxes overlapping the rectangle, sorted and without duplicates.
+     */
+    void FindBoxes(int left, int top, int right, int bottom, std::vector<int> &boxIdx) const;
+
+    /**
+     * @name Return the column or the row of a coordinate, clamped to the grid
+     */
+    ///@{
+    int GetColumn(int x) const;
+    int GetRow(int y) const;
+    ///@}
+
+public:
+    //
+private:
+    /** The boxes, in the document order */
+    std::vector<Box> m_boxes;
+    /** The indexes of the boxes spanning too many cells */
+    std::vector<int> m_largeBoxes;
+    /** The position of the first box of each cell in m_cellBoxes, with one more for the end of the last cell */
+    std::vector<int> m_cellStarts;
+    /** The indexes of the boxes of each cell, one cell after the other */
+    std::vector<int> m_cellBoxes;
+    /** The top-left corner of the grid */
+    int m_left;
+    int m_top;
+    /** The size of the cells */
+    int m_cellSize;
+    /** The dimensions of the grid */
+    int m_columns;
+    int m_rows;
+    /** Flag indicating whether the index has been built */
+    bool m_isBuilt;
+};
+
+} // namespace vrv
+
+#endif
@@ -187,6 +187,11 @@ public:
     virtual int CalcOnsetOffset(FunctorParams *functorParams);
     ///@}
 
+    /**
+     * See Object::GenerateMIDI
+     */
+    virtual int GenerateMIDI(FunctorParams *functorParams);
+
     /**
      * Set staff parameters based on
      * facsimile information (if it
@@ -69,6 +69,11 @@ public:
      */
     std::string GetStringSVG(bool xml_declaration = false);
 
+    /**
+     * Return an estimate of the memory used by the SVG DOM and by the output, and the number of nodes of the DOM.
+     */
+    size_t GetMemorySize(int &nodeCount);
+
     /**
      * @name Drawing methods
      */
@@ -0,0 +1,136 @@
+/////////////////////////////////////////////////////////////////////////////
+// Name:        timeindex.h
+// Author:      agent
+// Created:     2026
+// Copyright (c) Authors and others. All rights reserved.
+/////////////////////////////////////////////////////////////////////////////
+
+#ifndef __VRV_TIMEINDEX_H__
+#define __VRV_TIMEINDEX_H__
+
+#include <cstddef>
+#include <vector>
+
+namespace vrv {
+
+class Doc;
+class Measure;
+class Note;
+
+//----------------------------------------------------------------------------
+// TimeIndex
+//----------------------------------------------------------------------------
+
+/**
+ * This class stores the real time intervals (in milliseconds) of the measures and of the notes of a document.
+ * Measures played more than once (repeats or expansions) have one interval per performance.
+ * The intervals are sorted by onset so that the elements sounding at a given time are found with a binary search.
+ * Each interval also stores the largest offset of the intervals up to it, which stops the backward search as soon as
+ * no earlier interval can reach the time.
+ * The index is built by Doc::CalculateMidiTimemap and holds pointers to the objects of the document.
+ */
+class TimeIndex {
+public:
+    /** @name Constructors and destructor */
+    ///@{
+    TimeIndex();
+    virtual ~TimeIndex();
+    ///@}
+
+    /**
+     * Reset the index.
+     * This needs to be called when the objects of the document are modified or deleted.
+     */
+    void Reset();
+
+    /**
+     * Fill the index from the measures and notes of the document.
+     * The onset and offset times of the measures and of the notes have to be calculated.
+     */
+    void Build(Doc *doc);
+
+    /**
+     * Return true if the index has been built
+     */
+    bool IsBuilt() const { return m_isBuilt; }
+
+    /**
+     * @name Getters for the number of intervals and the memory they use
+     */
+    ///@{
+    int GetIntervalCount() const { return (int)(m_measureIntervals.size() + m_noteIntervals.size()); }
+    size_t GetMemorySize() const
+    {
+        return m_measureIntervals.capacity() * sizeof(MeasureInterval)
+            + m_noteIntervals.capacity() * sizeof(NoteInterval);
+    }
+    ///@}
+
+    /**
+     * Look for the measure played at a time and fill the notes of that measure sounding at that time.
+     * When two measures enclose the time (e.g., at a barline), the first one in the document is used.
+     * The notes are given in the document order. Return NULL if no measure is played at that time.
+     */
+    Measure *GetNotesAtTime(int millisec, std::vector<Note *> &notes) const;
+
+    /**
+     * Fill the notes sounding at any time between start and end (included) and the measures they belong to.
+     * Notes and measures are listed once, ordered by their first onset in the range.
+     */
+    void GetNotesInTimeRange(
+        int startMillisec, int endMillisec, std::vector<Note *> &notes, std::vector<Measure *> &measures) const;
+
+private:
+    /**
+     * An interval for each performance of a measure.
+     * The offset is truncated to an integer as done by Toolkit::GetElementsAtTime for note lookup.
+     */
+    struct MeasureInterval {
+        double m_onset;
+        double m_offset;
+        double m_maxOffset;
+        int m_measureTimeOffset;
+        int m_order;
+        Measure *m_measure;
+    };
+
+    /**
+     * An interval for each performance of a note.
+     * The times within the measure are kept for comparison since they are what the note stores.
+     * The offset used for the largest offset is the one in the time of the document.
+     */
+    struct NoteInterval {
+        double m_onset;
+        double m_noteOnset;
+        double m_noteOffset;
+        double m_maxOffset;
+        int m_order;
+        int m_measureTimeOffset;
+        Measure *m_measure;
+        Note *m_note;
+    };
+
+    /**
+     * Return the index of the first interval with an onset greater than the time.
+     */
+    template <class INTERVAL> static int UpperBound(const std::vector<INTERVAL> &intervals, double time);
+
+    /**
+     * Set the largest offset of the intervals sorted by onset, given the offset of each interval.
+     */
+    template <class INTERVAL, class OFFSET> static void SetMaxOffsets(std::vector<INTERVAL> &intervals, OFFSET offset);
+
+public:
+    //
+private:
+    /** The measure intervals, sorted by onset */
+    std::vector<MeasureInterval> m_measureIntervals;
+    /** The note intervals, sorted by onset */
+    std::vector<NoteInterval> m_noteIntervals;
+    /** A flag indicating that the index has been built */
+    bool m_isBuilt;
+};
+
+} // namespace vrv
+
+#endif
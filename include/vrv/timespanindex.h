@@ -0,0 +1,132 @@
+/////////////////////////////////////////////////////////////////////////////
+// Name:        timespanindex.h
+// Author:      agent
+// Created:     2026
+// Copyright (c) Authors and others. All rights reserved.
+/////////////////////////////////////////////////////////////////////////////
+
+#ifndef __VRV_TIMESPANINDEX_H__
+#define __VRV_TIMESPANINDEX_H__
+
+#include <map>
+#include <tuple>
+#include <vector>
+
+//----------------------------------------------------------------------------
+
+#include "vrvdef.h"
+
+namespace vrv {
+
+class Layer;
+class LayerElement;
+class Measure;
+class Mensur;
+class MeterSig;
+
+//----------------------------------------------------------------------------
+// TimeSpanIndex
+//----------------------------------------------------------------------------
+
+/**
+ * This class indexes the time spans of the layer elements of a measure by staff for the queries of
+ * Layer::GetLayerCountInTimeSpan and Layer::GetLayerElementsInTimeSpan.
+ * For each staff, the layer elements are stored in the order the MeasureAligner is traversed, with the maximum end
+ * time so far, so that the first element reaching a time is found with a binary search. From there, the query
+ * gives the same result as a traversal of the MeasureAligner stopping at the first element starting after the span.
+ * The index is filled when needed and reset with the MeasureAligner or when alignments or references are added to it.
+ */
+class TimeSpanIndex {
+public:
+    /** @name Constructors and destructor */
+    ///@{
+    TimeSpanIndex();
+    virtual ~TimeSpanIndex();
+    ///@}
+
+    /**
+     * Reset the index.
+     * This needs to be called when the MeasureAligner of the measure is reset or when its alignments or references
+     * change.
+     */
+    void Reset();
+
+    /**
+     * Return the number of layers with elements in the time span on the staff.
+     * The meter signature and the mensur are the current ones of the layer and change along the traversal.
+     */
+    int GetLayerCount(
+        Measure *measure, int staffN, double time, double duration, MeterSig *meterSig, Mensur *mensur);
+
+    /**
+     * Return the elements of the layer in the time span on the staff.
+     * The meter signature and the mensur are the current ones of the layer. Notes in chords take the chord duration.
+     */
+    ListOfObjects GetLayerElements(
+        Measure *measure, int staffN, Layer *layer, double time, double duration, MeterSig *meterSig, Mensur *mensur);
+
+private:
+    /**
+     * A layer element visited when traversing the MeasureAligner, with the index after its descendants.
+     */
+    struct Visit {
+        LayerElement *m_element;
+        int m_end;
+    };
+
+    /**
+     * An element with a duration and the index of the next span not in its descendants.
+     */
+    struct Span {
+        LayerElement *m_element;
+        double m_time;
+        double m_duration;
+        int m_next;
+        int m_layerN;
+        bool m_isChord;
+    };
+
+    /**
+     * The spans of the elements, the maximum end time up to each of them, and the position of the mRests.
+     */
+    struct SpanList {
+        std::vector<Span> m_spans;
+        std::vector<double> m_maxEnds;
+        std::vector<std::pair<int, int>> m_mRests;
+    };
+
+    /**
+     * Return the visits of the staff, traversing the MeasureAligner if they are not there yet.
+     */
+    const std::vector<Visit> &GetVisits(Measure *measure, int staffN);
+
+    /**
+     * Add a span to a list, once its next index is known (see TimeSpanIndex::FinishSpans).
+     */
+    static void AddSpan(SpanList &spanList, LayerElement *element, double time, double duration);
+
+    /**
+     * Set the next indexes from the span count before each visit and the maximum end times.
+     */
+    static void FinishSpans(SpanList &spanList, const std::vector<Visit> &visits, const std::vector<int> &spanIdx,
+        const std::vector<int> &visitIdx);
+
+    /**
+     * Fill the indexes of the spans in the time span and return the index where the traversal would stop.
+     */
+    static int FindSpans(const SpanList &spanList, double time, double duration, std::vector<int> &spanIdx);
+
+public:
+    //
+private:
+    /** The visits by staff */
+    std::map<int, std::vector<Visit>> m_visits;
+    /** The spans for the layer count, by staff, meter signature and mensur */
+    std::map<std::tuple<int, MeterSig *, Mensur *>, SpanList> m_layerCountSpans;
+    /** The spans for the layer elements, by staff, layer, meter signature and mensur */
+    std::map<std::tuple<int, Layer *, MeterSig *, Mensur *>, SpanList> m_layerElementSpans;
+};
+
+} // namespace vrv
+
+#endif
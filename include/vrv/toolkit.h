@@ -8,18 +8,27 @@
 #ifndef __VRV_TOOLKIT_H__
 #define __VRV_TOOLKIT_H__
 
+#include <map>
 #include <string>
 
 //----------------------------------------------------------------------------
 
 #include "doc.h"
+#include "memorystats.h"
 #include "view.h"
 
 //----------------------------------------------------------------------------
 
+namespace jsonxx {
+class Object;
+}
+
 namespace vrv {
 
 class EditorToolkit;
+class MEIOutput;
+class SpatialIndex;
+class SvgDeviceContext;
 
 enum FileFormat {
     UNKNOWN = 0,
@@ -77,8 +86,20 @@ public:
      */
     bool LoadData(const std::string &data);
 
+    /**
+     * Load a deep copy of the document loaded by another toolkit, for rendering it with the options of this one.
+     * This saves the parsing of the input but not the preparation of the drawing and the cast off, which are done
+     * again with the options of this toolkit.
+     * The content is copied as loaded and prepared by the other toolkit (e.g., expanded). The transposition option
+     * of this toolkit is applied if the other toolkit did not transpose the content, and has to be the same
+     * otherwise. Only score-based documents can be copied.
+     * The other toolkit is not modified, but the two toolkits must not be used concurrently.
+     */
+    bool LoadCopy(Toolkit *toolkit);
+
     /**
      * Save an MEI file.
+     * The MEI is streamed to the file. Options (JSON) are the same as for GetMEI.
      */
     bool SaveFile(const std::string &filename, const std::string &jsonOptions);
 
@@ -146,14 +167,24 @@ public:
 
     /**
      * Creates a midi file, opens it, and writes to it.
-     * currently generates a dummy midi file.
+     * Options (JSON) can be:
+     * measureId, startMeasureId, endMeasureId: string; the measure or the range of measures to render
+     * startTime, endTime: number; the times (in milliseconds) of the measures to render
+     * The MIDI output of a range starts with its first measure.
      */
-    bool RenderToMIDIFile(const std::string &filename);
+    bool RenderToMIDIFile(const std::string &filename, const std::string &jsonOptions = "");
 
     /**
      * Creates a midi file, opens it, and returns it (base64 encoded).
+     * See RenderToMIDIFile for the options.
+     */
+    std::string RenderToMIDI(const std::string &jsonOptions = "");
+
+    /**
+     * Creates a midi file and returns its raw bytes (not encoded).
+     * See RenderToMIDIFile for the options.
      */
-    std::string RenderToMIDI();
+    std::string RenderToMIDIData(const std::string &jsonOptions = "");
 
     /**
      * Export the content to a Plaine and Easie file.
@@ -168,9 +199,13 @@ public:
 
     /**
      * Creates a timemap file, and return it as a JSON string.
+     * Options (JSON) can be:
+     * format: "json" (default) or "ndjson" for one compact line per entry with the IDs listed once in a first line
+     * measureId, startMeasureId, endMeasureId: string; the timemap of the measure or the range of measures only
+     * startTime, endTime: number; the entries between these times (in milliseconds, included) only
      */
-    std::string RenderToTimemap();
-    bool RenderToTimemapFile(const std::string &filename);
+    std::string RenderToTimemap(const std::string &jsonOptions = "");
+    bool RenderToTimemapFile(const std::string &filename, const std::string &jsonOptions = "");
 
     const char *GetHumdrumBuffer();
     void SetHumdrumBuffer(const char *contents);
@@ -184,6 +219,45 @@ public:
      */
     std::string GetElementsAtTime(int millisec);
 
+    /**
+     * Returns an array with the elements played at each time of a JSON array of times (in milliseconds).
+     * Each entry is the object returned by GetElementsAtTime.
+     */
+    std::string GetElementsAtTimes(const std::string &jsonTimes);
+
+    /**
+     * Returns the IDs of the elements played at any time within a time range (in milliseconds),
+     * and the pages they appear on.
+     */
+    std::string GetElementsInTimeRange(int startMillisec, int endMillisec);
+
+    /**
+     * Returns the IDs of the elements with a bounding box within a radius of a point on a page, grouped by element
+     * name and in document order.
+     * Page number is 1-based. The coordinates are the ones of the viewBox of the SVG definition-scale element.
+     */
+    std::string GetElementsAtPoint(int pageNo, int x, int y, int radius = 0);
+
+    /**
+     * Returns the IDs of the elements with a bounding box overlapping a rectangle on a page, grouped by element
+     * name and in document order.
+     * Page number is 1-based. The coordinates are the ones of the viewBox of the SVG definition-scale element.
+     */
+    std::string GetElementsInRect(int pageNo, int x, int y, int width, int height);
+
+    /**
+     * Returns the playback schedule, with the tempo changes and the note on and off events sorted by time.
+     * This is meant for native clients following the playback with a PlaybackCursor.
+     */
+    const PlaybackSchedule *GetPlaybackSchedule();
+
+    /**
+     * Returns the events of the playback schedule between two times (in milliseconds, included), in time order.
+     * Each event has its time in milliseconds (tstamp) and in quarter notes (qstamp) and its type (tempo, on or off).
+     * Tempo events have the tempo, and note events the note ID, pitch, velocity, channel and page.
+     */
+    std::string GetPlaybackEvents(int startMillisec, int endMillisec);
+
     /**
      * Get the MEI as a string.
      * Options (JSON) can be:
@@ -198,6 +272,14 @@ public:
      */
     std::string GetElementAttr(const std::string &xmlId);
 
+    /**
+     * Return the memory used by the document as a JSON string.
+     * It gives the count and the size in bytes of the objects by class and of the side structures.
+     * With the memoryStats option, the stats collected after the import, the drawing preparation, the cast off and
+     * the last rendering to SVG are given too.
+     */
+    std::string GetMemoryStats();
+
     /**
      * Returns the ID string of the notated (the original) element
      */
@@ -293,10 +375,61 @@ public:
     const char *GetCString();
     ///@}
 
+    /**
+     * @name Set and get binary data (e.g., raw MIDI) that can contain null bytes.
+     * The data is moved into the buffer, which is kept until the next call.
+     */
+    ///@{
+    void SetCData(std::string &&data);
+    const unsigned char *GetCData(int &length);
+    ///@}
+
 private:
     bool IsUTF16(const std::string &filename);
     bool LoadUTF16File(const std::string &filename);
+    bool IsCompressed(const std::string &filename);
+    bool LoadBinaryFile(const std::string &filename);
+    bool DecompressData(const std::string &data, std::string &output);
+    /**
+     * Generate the running elements and the measure numbers, prepare the drawing and cast off the loaded document.
+     */
+    void PrepareLoadedDoc(bool transpose);
+    /**
+     * Collect the memory stats of the document, the humdrum buffer and the SVG being rendered if any.
+     * The snapshot is taken only with the memoryStats option.
+     */
+    ///@{
+    void CollectMemoryStats(MemoryStats &stats, SvgDeviceContext *svg = NULL);
+    void SnapshotMemoryStats(const std::string &phase, SvgDeviceContext *svg = NULL);
+    ///@}
+    /**
+     * Fill a JSON object with the count and the size of memory stats entries, or with the memory stats and their
+     * totals.
+     */
+    ///@{
+    static jsonxx::Object GetMemoryEntriesObject(const std::map<std::string, MemoryStats::Entry> &entries);
+    static jsonxx::Object GetMemoryStatsObject(const MemoryStats &stats);
+    ///@}
+    void SetMEIOutputOptions(MEIOutput &meioutput, const std::string &jsonOptions, int &pageNo);
+    bool SetPlaybackRange(PlaybackRange &range, const std::string &jsonOptions);
+    bool ExportMIDI(std::string &output, const std::string &jsonOptions);
+    bool ExportTimemap(std::string &output, const std::string &jsonOptions);
     void GetClassIds(const std::vector<std::string> &classStrings, std::vector<ClassId> &classIds);
+    /**
+     * Fill a JSON object with the notes played at a time and the page of their measure.
+     * The time index needs to be built.
+     */
+    jsonxx::Object GetElementsAtTimeObject(int millisec);
+    /**
+     * Set the page as drawing page, laying it out if necessary, and return its spatial index.
+     * Return NULL if the page does not exist.
+     */
+    const SpatialIndex *GetSpatialIndex(int pageNo);
+    /**
+     * Fill a JSON object with the IDs of the objects grouped by their element name.
+     * The name is the one of the MEI element, which is also the class in the SVG.
+     */
+    static jsonxx::Object GetElementsByNameObject(const std::vector<Object *> &objects);
 
 public:
     static std::map<std::string, ClassId> s_MEItoClassIdMap;
@@ -308,6 +441,14 @@ private:
     FileFormat m_inputFrom;
     FileFormat m_outputTo;
 
+    /** A flag indicating that the data loaded has layout information (breaks) */
+    bool m_hasLayoutInformation;
+    /** The transposition applied to the data loaded, empty if none */
+    std::string m_transposition;
+
+    /** The memory stats collected after each phase */
+    std::map<std::string, MemoryStats> m_memoryStats;
+
     static char *m_humdrumBuffer;
 
     Options *m_options;
@@ -317,6 +458,11 @@ private:
      */
     char *m_cString;
 
+    /**
+     * The C binary buffer.
+     */
+    std::string m_cData;
+
     EditorToolkit *m_editorToolkit;
 };
 
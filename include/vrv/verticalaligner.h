@@ -248,13 +248,20 @@ public:
     ///@}
 
     /**
-     * @name Adds a bounding box to the array of overflowing objects above or below
+     * @name Add a bounding box to the array of overflowing objects above or below, and get them
      */
     ///@{
     void AddBBoxAbove(BoundingBox *box) { m_overflowAboveBBoxes.push_back(box); }
     void AddBBoxBelow(BoundingBox *box) { m_overflowBelowBBoxes.push_back(box); }
+    const std::vector<BoundingBox *> &GetBBoxesAbove() const { return m_overflowAboveBBoxes; }
+    const std::vector<BoundingBox *> &GetBBoxesBelow() const { return m_overflowBelowBBoxes; }
     ///@}
 
+    /**
+     * Return the FloatingPositioner objects of the staff.
+     */
+    const ArrayOfFloatingPositioners &GetFloatingPositioners() const { return m_floatingPositioners; }
+
     /**
      * Deletes all the FloatingPositioner objects.
      */
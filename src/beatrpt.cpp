@@ -80,16 +80,15 @@ int BeatRpt::GenerateMIDI(FunctorParams *functorParams)
     int tpq = params->m_midiFile->getTPQ();
 
     // filter last beat and copy all notes
+    // The events of the track are not in time order (the layers of the staff are added one after the other), so all
+    // of them are looked at and the ones of the last beat are selected by tick
     smf::MidiEvent event;
     int eventcount = params->m_midiFile->getEventCount(params->m_midiTrack);
     for (int i = 0; i < eventcount; i++) {
         event = params->m_midiFile->getEvent(params->m_midiTrack, i);
-        if (event.tick > starttime * tpq)
-            break;
-        else if (event.tick >= (starttime - beatLength) * tpq) {
-            if (((event[0] & 0xf0) == 0x80) || ((event[0] & 0xf0) == 0x90)) {
-                params->m_midiFile->addEvent(params->m_midiTrack, event.tick + beatLength * tpq, event);
-            }
+        if ((event.tick > starttime * tpq) || (event.tick < (starttime - beatLength) * tpq)) continue;
+        if (((event[0] & 0xf0) == 0x80) || ((event[0] & 0xf0) == 0x90)) {
+            params->m_midiFile->addEvent(params->m_midiTrack, event.tick + beatLength * tpq, event);
         }
     }
 
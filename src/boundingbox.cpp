@@ -18,6 +18,7 @@
 #include "doc.h"
 #include "floatingobject.h"
 #include "glyph.h"
+#include "objectarena.h"
 #include "vrv.h"
 
 #define BEZIER_APPROXIMATION 50.0
@@ -42,6 +43,16 @@ BoundingBox::BoundingBox()
     ResetBoundingBox();
 }
 
+void *BoundingBox::operator new(size_t size)
+{
+    return ObjectArena::AllocateBlock(size);
+}
+
+void BoundingBox::operator delete(void *ptr)
+{
+    ObjectArena::DeallocateBlock(ptr);
+}
+
 ClassId BoundingBox::GetClassId() const
 {
     // we should always have the method overridden
@@ -54,6 +65,12 @@ bool BoundingBox::Is(const std::vector<ClassId> &classIds) const
     return (std::find(classIds.begin(), classIds.end(), this->GetClassId()) != classIds.end());
 }
 
+bool BoundingBox::Is(std::initializer_list<ClassId> classIds) const
+{
+    // Braced lists of class ids are checked without building a vector
+    return (std::find(classIds.begin(), classIds.end(), this->GetClassId()) != classIds.end());
+}
+
 void BoundingBox::UpdateContentBBoxX(int x1, int x2)
 {
     // LogDebug("CB Was: %i %i %i %i", m_contentBB_x1, m_contentBB_y1, m_contentBB_x2, m_contentBB_y2);
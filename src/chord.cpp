@@ -66,6 +66,14 @@ Chord::~Chord()
     ClearClusters();
 }
 
+void Chord::CloneReset()
+{
+    // The clusters belong to the original chord and must not be deleted when resetting the drawing
+    m_clusters.clear();
+
+    LayerElement::CloneReset();
+}
+
 void Chord::Reset()
 {
     LayerElement::Reset();
@@ -9,16 +9,21 @@
 
 //----------------------------------------------------------------------------
 
+#include <algorithm>
 #include <assert.h>
+#include <map>
 #include <math.h>
 
 //----------------------------------------------------------------------------
 
 #include "barline.h"
 #include "beatrpt.h"
+#include "boundary.h"
 #include "chord.h"
+#include "clef.h"
 #include "comparison.h"
 #include "expansion.h"
+#include "floatingobject.h"
 #include "functorparams.h"
 #include "glyph.h"
 #include "instrdef.h"
@@ -28,6 +33,7 @@
 #include "layer.h"
 #include "mdiv.h"
 #include "measure.h"
+#include "memorystats.h"
 #include "mensur.h"
 #include "metersig.h"
 #include "mnum.h"
@@ -37,6 +43,7 @@
 #include "multirest.h"
 #include "multirpt.h"
 #include "note.h"
+#include "objectarena.h"
 #include "page.h"
 #include "pages.h"
 #include "pgfoot.h"
@@ -57,6 +64,7 @@
 #include "timestamp.h"
 #include "transposition.h"
 #include "verse.h"
+#include "verticalaligner.h"
 #include "vrv.h"
 #include "zone.h"
 
@@ -73,12 +81,18 @@ namespace vrv {
 Doc::Doc() : Object("doc-")
 {
     m_options = new Options();
+    m_contentArena = NULL;
+    m_layoutArena = NULL;
 
     Reset();
 }
 
 Doc::~Doc()
 {
+    // The arenas are freed once the objects are deleted by the Object destructor
+    if (m_contentArena) m_contentArena->Release();
+    if (m_layoutArena) m_layoutArena->Release();
+
     delete m_options;
 }
 
@@ -108,10 +122,14 @@ void Doc::Reset()
     m_currentScoreDefDone = false;
     m_drawingPreparationDone = false;
     m_MIDITimemapTempo = 0.0;
+    m_timeIndex.Reset();
+    m_playbackSchedule.Reset();
     m_markup = MARKUP_DEFAULT;
     m_isMensuralMusicOnly = false;
 
     m_mdivScoreDef.Reset();
+    m_facsClefs.clear();
+    m_isFacsClefCacheValid = false;
 
     m_drawingSmuflFontSize = 0;
     m_drawingLyricFontSize = 0;
@@ -119,6 +137,10 @@ void Doc::Reset()
     m_header.reset();
     m_front.reset();
     m_back.reset();
+
+    // The objects have been deleted, so the memory of the arenas can be freed at once
+    if (m_contentArena) m_contentArena->Clear();
+    if (m_layoutArena) m_layoutArena->Clear();
 }
 
 void Doc::SetType(DocType type)
@@ -242,14 +264,284 @@ bool Doc::GenerateMeasureNumbers()
     return true;
 }
 
-bool Doc::HasMidiTimemap()
+bool Doc::CopyContentFrom(Doc *source)
+{
+    assert(source && (source != this));
+
+    if ((source->GetType() != Raw) || source->IsMensuralMusicOnly() || source->HasFacsimile()) {
+        LogError("Only score-based documents without facsimile can be copied");
+        return false;
+    }
+
+    this->Reset();
+
+    // The copies are content objects, the pages and systems are created in the layout arena (see CopyContentChildren)
+    ObjectArenaScope arenaScope(this->GetContentArena());
+
+    m_type = source->m_type;
+    m_notationType = source->m_notationType;
+    m_markup = source->m_markup;
+    m_pageHeight = source->m_pageHeight;
+    m_pageWidth = source->m_pageWidth;
+    m_pageMarginBottom = source->m_pageMarginBottom;
+    m_pageMarginLeft = source->m_pageMarginLeft;
+    m_pageMarginRight = source->m_pageMarginRight;
+    m_pageMarginTop = source->m_pageMarginTop;
+    m_expansionMap = source->m_expansionMap;
+    m_header.reset(source->m_header);
+    m_front.reset(source->m_front);
+    m_back.reset(source->m_back);
+
+    // The running elements are not cloned with the scoreDef. The encoded ones are copied in place, but not the
+    // generated ones because they are generated again with the options of the document
+    m_mdivScoreDef = source->m_mdivScoreDef;
+    int idx = 0;
+    for (Object *child : source->m_mdivScoreDef.GetChildRange()) {
+        if (!child->IsRunningElement()) {
+            ++idx;
+            continue;
+        }
+        RunningElement *runningElement = vrv_cast<RunningElement *>(child);
+        assert(runningElement);
+        if (runningElement->IsGenerated()) continue;
+        RunningElement *copy = NULL;
+        if (child->Is(PGHEAD)) {
+            copy = new PgHead(*vrv_cast<PgHead *>(child));
+        }
+        else if (child->Is(PGHEAD2)) {
+            copy = new PgHead2(*vrv_cast<PgHead2 *>(child));
+        }
+        else if (child->Is(PGFOOT)) {
+            copy = new PgFoot(*vrv_cast<PgFoot *>(child));
+        }
+        else if (child->Is(PGFOOT2)) {
+            copy = new PgFoot2(*vrv_cast<PgFoot2 *>(child));
+        }
+        else {
+            LogWarning("Running element '%s' not copied", child->GetClassName().c_str());
+            continue;
+        }
+        copy->SetParent(&m_mdivScoreDef);
+        copy->CloneReset();
+        m_mdivScoreDef.InsertChild(copy, idx);
+        copy->SetDrawingPage(NULL);
+        ++idx;
+    }
+    CopyContentIds(&source->m_mdivScoreDef, &m_mdivScoreDef);
+
+    this->CopyContentChildren(source, this);
+
+    return true;
+}
+
+void Doc::CopyContentChildren(Object *source, Object *target)
+{
+    Page *contentPage = NULL;
+    System *contentSystem = NULL;
+    // The copies of the boundary starts in the system for linking them to their end
+    std::map<Object *, Object *> copiedStarts;
+
+    for (Object *child : source->GetChildRange()) {
+        if (child->Is(MDIV)) {
+            Mdiv *mdiv = vrv_cast<Mdiv *>(child);
+            assert(mdiv);
+            Mdiv *mdivCopy = new Mdiv();
+            mdivCopy->SetLabel(mdiv->GetLabel());
+            mdivCopy->SetN(mdiv->GetN());
+            mdivCopy->m_visibility = mdiv->m_visibility;
+            target->AddChild(mdivCopy);
+            CopyContentIds(mdiv, mdivCopy);
+            this->CopyContentChildren(mdiv, mdivCopy);
+        }
+        else if (child->Is(PAGES)) {
+            Pages *pages = vrv_cast<Pages *>(child);
+            assert(pages);
+            Pages *pagesCopy = new Pages();
+            pagesCopy->SetLabel(pages->GetLabel());
+            pagesCopy->SetN(pages->GetN());
+            target->AddChild(pagesCopy);
+            CopyContentIds(pages, pagesCopy);
+            this->CopyContentChildren(pages, pagesCopy);
+        }
+        // The content of all the pages goes to a single system, as with Doc::UnCastOffDoc
+        else if (child->Is(PAGE)) {
+            if (!contentPage) {
+                ObjectArenaScope arenaScope(this->GetLayoutArena());
+                contentPage = new Page();
+                contentSystem = new System();
+                contentPage->AddChild(contentSystem);
+                target->AddChild(contentPage);
+            }
+            for (Object *system : child->GetChildRange(SYSTEM)) {
+                for (Object *systemChild : system->GetChildRange()) {
+                    // The boundary ends are not cloned but created again for the copy of their start
+                    if (systemChild->Is(BOUNDARY_END)) {
+                        BoundaryEnd *boundaryEnd = vrv_cast<BoundaryEnd *>(systemChild);
+                        assert(boundaryEnd);
+                        auto copiedStart = copiedStarts.find(boundaryEnd->GetStart());
+                        if (copiedStart == copiedStarts.end()) continue;
+                        BoundaryEnd *boundaryEndCopy = new BoundaryEnd(copiedStart->second);
+                        dynamic_cast<BoundaryStartInterface *>(copiedStart->second)->SetEnd(boundaryEndCopy);
+                        contentSystem->AddChild(boundaryEndCopy);
+                        boundaryEndCopy->SetUuid(boundaryEnd->GetUuid());
+                        continue;
+                    }
+                    Object *clone = systemChild->Clone();
+                    if (!clone) continue;
+                    clone->SetParent(contentSystem);
+                    clone->CloneReset();
+                    contentSystem->AddChild(clone);
+                    CopyContentIds(systemChild, clone);
+                    // The copy still points to the end of the original start
+                    BoundaryStartInterface *boundaryStart = dynamic_cast<BoundaryStartInterface *>(clone);
+                    if (boundaryStart) {
+                        boundaryStart->BoundaryStartInterface::Reset();
+                        copiedStarts[systemChild] = clone;
+                    }
+                }
+            }
+        }
+        else {
+            Object *clone = child->Clone();
+            if (!clone) continue;
+            clone->SetParent(target);
+            clone->CloneReset();
+            target->AddChild(clone);
+            CopyContentIds(child, clone);
+        }
+    }
+}
+
+void Doc::CopyContentIds(const Object *source, Object *target)
+{
+    target->SetUuid(source->GetUuid());
+    if (!source->GetComment().empty()) target->SetComment(source->GetComment());
+    if (!source->GetClosingComment().empty()) target->SetClosingComment(source->GetClosingComment());
+    target->m_unsupported = source->m_unsupported;
+
+    // The children that are not cloned (e.g., generated running elements) are missing in the copy
+    ChildRange targetChildren = target->GetChildRange();
+    ChildRange::Iterator targetChild = targetChildren.begin();
+    for (Object *child : source->GetChildRange()) {
+        if (targetChild == targetChildren.end()) break;
+        if ((*targetChild)->GetClassId() != child->GetClassId()) continue;
+        CopyContentIds(child, *targetChild);
+        ++targetChild;
+    }
+}
+
+bool Doc::HasMidiTimemap() const
 {
     return (m_MIDITimemapTempo == m_options->m_midiTempoAdjustment.GetValue());
 }
 
-void Doc::CalculateMidiTimemap()
+void Doc::ResetMidiTimemap()
 {
     m_MIDITimemapTempo = 0.0;
+    m_timeIndex.Reset();
+    m_playbackSchedule.Reset();
+}
+
+const PlaybackSchedule &Doc::GetPlaybackSchedule()
+{
+    if (!Doc::HasMidiTimemap() || !m_playbackSchedule.IsBuilt()) {
+        // The MIDI output itself is not used
+        smf::MidiFile midiFile;
+        midiFile.absoluteTicks();
+        this->ExportMIDI(&midiFile, PlaybackRange(), &m_playbackSchedule);
+    }
+    else if (!m_playbackSchedule.HasPages()) {
+        m_playbackSchedule.UpdatePages();
+    }
+    return m_playbackSchedule;
+}
+
+ObjectArena *Doc::GetContentArena()
+{
+    if (!m_contentArena && m_options->m_useArena.GetValue()) m_contentArena = new ObjectArena();
+    return m_contentArena;
+}
+
+ObjectArena *Doc::GetLayoutArena()
+{
+    if (!m_layoutArena && m_options->m_useArena.GetValue()) m_layoutArena = new ObjectArena();
+    return m_layoutArena;
+}
+
+void Doc::CollectMemoryStats(MemoryStats &stats)
+{
+    // The scoreDef of the document is a member and its size is the one of the document
+    stats.AddObject(this, sizeof(Doc));
+    stats.AddDescendants(this);
+    stats.AddDescendants(&m_mdivScoreDef);
+
+    // The aligners are members of the measures and of the systems
+    ClassIdComparison matchMeasure(MEASURE);
+    ListOfObjects measures;
+    this->FindAllDescendantByComparison(&measures, &matchMeasure);
+    for (Object *object : measures) {
+        Measure *measure = vrv_cast<Measure *>(object);
+        assert(measure);
+        stats.AddDescendants(&measure->m_measureAligner, "aligners");
+        stats.AddDescendants(&measure->m_timestampAligner, "aligners");
+    }
+
+    ClassIdComparison matchSystem(SYSTEM);
+    ListOfObjects systems;
+    this->FindAllDescendantByComparison(&systems, &matchSystem);
+    for (Object *object : systems) {
+        System *system = vrv_cast<System *>(object);
+        assert(system);
+        stats.AddDescendants(&system->m_systemAligner, "aligners");
+        // The staff alignments own the floating positioners
+        for (Object *child : system->m_systemAligner.GetChildRange(STAFF_ALIGNMENT)) {
+            StaffAlignment *staffAlignment = vrv_cast<StaffAlignment *>(child);
+            assert(staffAlignment);
+            for (FloatingPositioner *positioner : staffAlignment->GetFloatingPositioners()) {
+                stats.AddStructure("floatingPositioners", 1, MemoryStats::GetAllocatedSize(positioner));
+            }
+            const std::vector<BoundingBox *> &above = staffAlignment->GetBBoxesAbove();
+            const std::vector<BoundingBox *> &below = staffAlignment->GetBBoxesBelow();
+            stats.AddStructure("overflowBBoxes", (int)(above.size() + below.size()),
+                (above.capacity() + below.capacity()) * sizeof(BoundingBox *));
+        }
+    }
+
+    // The spatial indexes of the pages queried for hit testing
+    ClassIdComparison matchPage(PAGE);
+    ListOfObjects pages;
+    this->FindAllDescendantByComparison(&pages, &matchPage);
+    for (Object *object : pages) {
+        Page *page = vrv_cast<Page *>(object);
+        assert(page);
+        if (!page->m_spatialIndex.IsBuilt()) continue;
+        stats.AddStructure(
+            "spatialIndex", page->m_spatialIndex.GetBoxCount(), page->m_spatialIndex.GetMemorySize());
+    }
+
+    stats.AddStructure("timeIndex", m_timeIndex.GetIntervalCount(), m_timeIndex.GetMemorySize());
+    stats.AddStructure(
+        "playbackSchedule", m_playbackSchedule.GetEventCount(), m_playbackSchedule.GetMemorySize());
+
+    // An estimate of the nodes of the map and of the strings
+    size_t expansionMapSize = 0;
+    for (auto const &entry : m_expansionMap.m_map) {
+        expansionMapSize += sizeof(entry) + 4 * sizeof(void *) + entry.first.capacity();
+    }
+    stats.AddStructure("expansionMap", (int)m_expansionMap.m_map.size(), expansionMapSize);
+
+    // The memory reserved by the arenas, which includes the objects allocated from them
+    if (m_contentArena) {
+        stats.AddStructure("contentArena", m_contentArena->GetObjectCount(), m_contentArena->GetReservedSize());
+    }
+    if (m_layoutArena) {
+        stats.AddStructure("layoutArena", m_layoutArena->GetObjectCount(), m_layoutArena->GetReservedSize());
+    }
+}
+
+void Doc::CalculateMidiTimemap()
+{
+    this->ResetMidiTimemap();
 
     // This happens if the document was never cast off (layout none option in the toolkit)
     if (!m_drawingPage && GetPageCount() == 1) {
@@ -257,6 +549,7 @@ void Doc::CalculateMidiTimemap()
         if (!page) {
             return;
         }
+        ObjectArenaScope arenaScope(this->GetLayoutArena());
         this->SetCurrentScoreDefDoc();
         page->LayOutHorizontally();
     }
@@ -285,10 +578,13 @@ void Doc::CalculateMidiTimemap()
     Functor resolveMIDITies(&Object::ResolveMIDITies);
     this->Process(&resolveMIDITies, NULL, NULL, NULL, UNLIMITED_DEPTH, BACKWARD);
 
+    // Index the measure and note times for looking up the elements played at a given time
+    m_timeIndex.Build(this);
+
     m_MIDITimemapTempo = m_options->m_midiTempoAdjustment.GetValue();
 }
 
-void Doc::ExportMIDI(smf::MidiFile *midiFile)
+void Doc::ExportMIDI(smf::MidiFile *midiFile, const PlaybackRange &range, PlaybackSchedule *schedule)
 {
 
     if (!Doc::HasMidiTimemap()) {
@@ -317,18 +613,22 @@ void Doc::ExportMIDI(smf::MidiFile *midiFile)
     Functor prepareProcessingLists(&Object::PrepareProcessingLists);
     this->Process(&prepareProcessingLists, &prepareProcessingListsParams);
 
-    // The tree is used to process each staff/layer/verse separatly
-    // For this, we use a array of AttNIntegerComparison that looks for each object if it is of the type
-    // and with @n specified
+    // The tree is used to set up a track state for each staff, which is then made current by Staff::GenerateMIDI
+    // This makes it possible to generate all the tracks in a single traversal of the document
+    Functor generateMIDI(&Object::GenerateMIDI);
+    GenerateMIDIParams generateMIDIParams(midiFile, &generateMIDI);
+    generateMIDIParams.m_currentTempo = tempo;
+    generateMIDIParams.m_range = range;
+    if (schedule) {
+        schedule->Reset();
+        generateMIDIParams.m_schedule = schedule;
+    }
 
     IntTree_t::iterator staves;
-    IntTree_t::iterator layers;
 
-    // Process notes and chords, rests, spaces layer by layer
     // track 0 (included by default) is reserved for meta messages common to all tracks
     int midiChannel = 0;
     int midiTrack = 1;
-    ArrayOfComparisons filters;
     for (staves = prepareProcessingListsParams.m_layerTree.child.begin();
          staves != prepareProcessingListsParams.m_layerTree.child.end(); ++staves) {
 
@@ -372,28 +672,31 @@ void Doc::ExportMIDI(smf::MidiFile *midiFile)
             }
         }
 
-        for (layers = staves->second.child.begin(); layers != staves->second.child.end(); ++layers) {
-            filters.clear();
-            // Create ad comparison object for each type / @n
-            AttNIntegerComparison matchStaff(STAFF, staves->first);
-            AttNIntegerComparison matchLayer(LAYER, layers->first);
-            filters.push_back(&matchStaff);
-            filters.push_back(&matchLayer);
+        MIDITrackState &trackState = generateMIDIParams.m_trackStates[staves->first];
+        trackState.m_midiTrack = midiTrack;
+        trackState.m_midiChannel = midiChannel;
+        trackState.m_transSemi = transSemi;
+    }
 
-            Functor generateMIDI(&Object::GenerateMIDI);
-            GenerateMIDIParams generateMIDIParams(midiFile, &generateMIDI);
-            generateMIDIParams.m_midiChannel = midiChannel;
-            generateMIDIParams.m_midiTrack = midiTrack;
-            generateMIDIParams.m_transSemi = transSemi;
-            generateMIDIParams.m_currentTempo = tempo;
+    // Process notes and chords, rests, spaces of all staves and layers at once
+    this->Process(&generateMIDI, &generateMIDIParams);
 
-            // LogDebug("Exporting track %d ----------------", midiTrack);
-            this->Process(&generateMIDI, &generateMIDIParams, NULL, &filters);
+    // Cut the notes tied beyond the last measure of the range
+    if (range.IsSet() && (generateMIDIParams.m_scoreTimeEnd >= 0.0)) {
+        const int endTick
+            = (generateMIDIParams.m_scoreTimeEnd - generateMIDIParams.m_scoreTimeStart) * midiFile->getTPQ();
+        for (int track = 0; track < midiFile->getTrackCount(); ++track) {
+            for (int i = 0; i < midiFile->getEventCount(track); ++i) {
+                smf::MidiEvent &event = midiFile->getEvent(track, i);
+                if (event.tick > endTick) event.tick = endTick;
+            }
         }
     }
+
+    if (schedule) schedule->Finalize();
 }
 
-bool Doc::ExportTimemap(std::string &output)
+bool Doc::ExportTimemap(std::string &output, bool ndjson, const PlaybackRange &range)
 {
     if (!Doc::HasMidiTimemap()) {
         // generate MIDI timemap before progressing
@@ -406,82 +709,159 @@ bool Doc::ExportTimemap(std::string &output)
     }
     Functor generateTimemap(&Object::GenerateTimemap);
     GenerateTimemapParams generateTimemapParams(&generateTimemap);
+    generateTimemapParams.m_range = range;
     this->Process(&generateTimemap, &generateTimemapParams);
 
-    PrepareJsonTimemap(output, generateTimemapParams.realTimeToScoreTime, generateTimemapParams.realTimeToOnElements,
-        generateTimemapParams.realTimeToOffElements, generateTimemapParams.realTimeToTempo);
+    // Events at the same time remain in the traversal order, the last one giving the score time of the entry
+    std::vector<TimemapEvent> &events = generateTimemapParams.m_events;
+    std::stable_sort(events.begin(), events.end(),
+        [](const TimemapEvent &a, const TimemapEvent &b) { return a.m_realTime < b.m_realTime; });
+
+    // Keep only the events within the time range (included)
+    if (range.m_endTime >= 0.0) {
+        events.erase(std::upper_bound(events.begin(), events.end(), range.m_endTime,
+                         [](double time, const TimemapEvent &event) { return time < event.m_realTime; }),
+            events.end());
+    }
+    events.erase(events.begin(),
+        std::lower_bound(events.begin(), events.end(), range.m_startTime,
+            [](const TimemapEvent &event, double time) { return event.m_realTime < time; }));
+
+    if (ndjson) {
+        PrepareNdjsonTimemap(output, events);
+    }
+    else {
+        PrepareJsonTimemap(output, events);
+    }
 
     return true;
 }
 
-void Doc::PrepareJsonTimemap(std::string &output, std::map<double, double> &realTimeToScoreTime,
-    std::map<double, std::vector<std::string> > &realTimeToOnElements,
-    std::map<double, std::vector<std::string> > &realTimeToOffElements, std::map<double, int> &realTimeToTempo)
+/**
+ * Return the end of the events of the timemap entry starting at the given position (i.e., with the same time).
+ */
+static std::vector<TimemapEvent>::const_iterator GetTimemapEntryEnd(
+    std::vector<TimemapEvent>::const_iterator begin, std::vector<TimemapEvent>::const_iterator end)
 {
+    const double realTime = begin->m_realTime;
+    while ((begin != end) && (begin->m_realTime == realTime)) ++begin;
+    return begin;
+}
 
+/**
+ * Return the tempo of the last on event of the entry, or 0 if there is none.
+ */
+static int GetTimemapEntryTempo(
+    std::vector<TimemapEvent>::const_iterator begin, std::vector<TimemapEvent>::const_iterator end)
+{
+    int tempo = 0;
+    for (auto it = begin; it != end; ++it) {
+        if (it->m_isOn) tempo = it->m_tempo;
+    }
+    return tempo;
+}
+
+void Doc::PrepareJsonTimemap(std::string &output, const std::vector<TimemapEvent> &events)
+{
     int currentTempo = -1000;
-    int newTempo;
-    int mapsize = (int)realTimeToScoreTime.size();
     output = "";
-    output.reserve(mapsize * 100); // Estimate 100 characters for each entry.
+    output.reserve(events.size() * 60); // Estimate 60 characters for each event.
     output += "[\n";
-    auto lastit = realTimeToScoreTime.end();
-    lastit--;
-    for (auto it = realTimeToScoreTime.begin(); it != realTimeToScoreTime.end(); ++it) {
+    for (auto it = events.begin(); it != events.end();) {
+        auto entryEnd = GetTimemapEntryEnd(it, events.end());
+        if (it != events.begin()) {
+            output += ",\n";
+        }
         output += "\t{\n";
         output += "\t\t\"tstamp\":\t";
-        output += std::to_string(it->first);
+        output += std::to_string(it->m_realTime);
         output += ",\n";
         output += "\t\t\"qstamp\":\t";
-        output += std::to_string(it->second);
-
-        auto ittempo = realTimeToTempo.find(it->first);
-        if (ittempo != realTimeToTempo.end()) {
-            newTempo = ittempo->second;
-            if (newTempo != currentTempo) {
-                currentTempo = newTempo;
-                output += ",\n\t\t\"tempo\":\t";
-                output += std::to_string(currentTempo);
-            }
-        }
+        output += std::to_string((entryEnd - 1)->m_scoreTime);
 
-        auto iton = realTimeToOnElements.find(it->first);
-        if (iton != realTimeToOnElements.end()) {
-            output += ",\n\t\t\"on\":\t[";
-            for (int ion = 0; ion < (int)iton->second.size(); ++ion) {
-                output += "\"";
-                output += iton->second[ion];
-                output += "\"";
-                if (ion < (int)iton->second.size() - 1) {
-                    output += ", ";
-                }
-            }
-            output += "]";
+        const int newTempo = GetTimemapEntryTempo(it, entryEnd);
+        if ((newTempo != 0) && (newTempo != currentTempo)) {
+            currentTempo = newTempo;
+            output += ",\n\t\t\"tempo\":\t";
+            output += std::to_string(currentTempo);
         }
 
-        auto itoff = realTimeToOffElements.find(it->first);
-        if (itoff != realTimeToOffElements.end()) {
-            output += ",\n\t\t\"off\":\t[";
-            for (int ioff = 0; ioff < (int)itoff->second.size(); ++ioff) {
+        for (bool isOn : { true, false }) {
+            bool first = true;
+            for (auto event = it; event != entryEnd; ++event) {
+                if (event->m_isOn != isOn) continue;
+                output += (first) ? ((isOn) ? ",\n\t\t\"on\":\t[\"" : ",\n\t\t\"off\":\t[\"") : ", \"";
+                output += event->m_element->GetUuid();
                 output += "\"";
-                output += itoff->second[ioff];
-                output += "\"";
-                if (ioff < (int)itoff->second.size() - 1) {
-                    output += ", ";
-                }
+                first = false;
             }
-            output += "]";
+            if (!first) output += "]";
         }
 
         output += "\n\t}";
-        if (it == lastit) {
-            output += "\n";
+        it = entryEnd;
+    }
+    if (!events.empty()) {
+        output += "\n";
+    }
+    output += "]\n";
+}
+
+/**
+ * Format a time of the timemap without the trailing zeros.
+ */
+static void AppendTimemapNumber(std::string &output, double value)
+{
+    std::string number = StringFormat("%.6f", value);
+    number.erase(number.find_last_not_of('0') + 1);
+    if (number.back() == '.') number.pop_back();
+    output += number;
+}
+
+void Doc::PrepareNdjsonTimemap(std::string &output, const std::vector<TimemapEvent> &events)
+{
+    // Intern the IDs in the order of their first event so that the entries only refer to their index
+    std::map<Object *, int> indexes;
+    output = "{\"ids\":[";
+    for (auto const &event : events) {
+        if (!indexes.insert({ event.m_element, (int)indexes.size() }).second) continue;
+        if (indexes.size() > 1) output += ",";
+        output += "\"";
+        output += event.m_element->GetUuid();
+        output += "\"";
+    }
+    output += "]}\n";
+    output.reserve(output.size() + events.size() * 20); // Estimate 20 characters for each event.
+
+    int currentTempo = -1000;
+    for (auto it = events.begin(); it != events.end();) {
+        auto entryEnd = GetTimemapEntryEnd(it, events.end());
+        output += "{\"tstamp\":";
+        AppendTimemapNumber(output, it->m_realTime);
+        output += ",\"qstamp\":";
+        AppendTimemapNumber(output, (entryEnd - 1)->m_scoreTime);
+
+        const int newTempo = GetTimemapEntryTempo(it, entryEnd);
+        if ((newTempo != 0) && (newTempo != currentTempo)) {
+            currentTempo = newTempo;
+            output += ",\"tempo\":";
+            output += std::to_string(currentTempo);
         }
-        else {
-            output += ",\n";
+
+        for (bool isOn : { true, false }) {
+            bool first = true;
+            for (auto event = it; event != entryEnd; ++event) {
+                if (event->m_isOn != isOn) continue;
+                output += (first) ? ((isOn) ? ",\"on\":[" : ",\"off\":[") : ",";
+                output += std::to_string(indexes.at(event->m_element));
+                first = false;
+            }
+            if (!first) output += "]";
         }
+
+        output += "}\n";
+        it = entryEnd;
     }
-    output += "]\n";
 }
 
 void Doc::PrepareDrawing()
@@ -833,6 +1213,9 @@ void Doc::CastOffLineDoc()
 }
 void Doc::CastOffDocBase(bool useSb, bool usePb)
 {
+    // The pages and the systems created are layout objects
+    ObjectArenaScope arenaScope(this->GetLayoutArena());
+
     Pages *pages = this->GetPages();
     assert(pages);
 
@@ -841,6 +1224,9 @@ void Doc::CastOffDocBase(bool useSb, bool usePb)
         return;
     }
 
+    // Only the pages change, the timemap remains valid
+    m_playbackSchedule.ResetPages();
+
     this->SetCurrentScoreDefDoc();
 
     Page *contentPage = this->SetDrawingPage(0);
@@ -944,9 +1330,13 @@ void Doc::CastOffRunningElements(CastOffPagesParams *params)
 
 void Doc::UnCastOffDoc()
 {
+    ObjectArenaScope arenaScope(this->GetLayoutArena());
+
     Pages *pages = this->GetPages();
     assert(pages);
 
+    m_playbackSchedule.ResetPages();
+
     Page *contentPage = new Page();
     System *contentSystem = new System();
     contentPage->AddChild(contentSystem);
@@ -970,8 +1360,12 @@ void Doc::UnCastOffDoc()
 
 void Doc::CastOffEncodingDoc()
 {
+    ObjectArenaScope arenaScope(this->GetLayoutArena());
+
     this->SetCurrentScoreDefDoc();
 
+    m_playbackSchedule.ResetPages();
+
     Pages *pages = this->GetPages();
     assert(pages);
 
@@ -1010,6 +1404,8 @@ void Doc::CastOffEncodingDoc()
 
 void Doc::ConvertToPageBasedDoc()
 {
+    ObjectArenaScope arenaScope(this->GetLayoutArena());
+
     Score *score = this->GetScore();
     assert(score);
 
@@ -1054,6 +1450,9 @@ void Doc::ConvertToCastOffMensuralDoc()
 
     this->SetCurrentScoreDefDoc();
 
+    // The measures are rebuilt and the timing calculated for the previous ones is lost
+    this->ResetMidiTimemap();
+
     Pages *pages = this->GetPages();
     assert(pages);
 
@@ -1112,6 +1511,8 @@ void Doc::ConvertToUnCastOffMensuralDoc()
         this->UnCastOffDoc();
     }
 
+    this->ResetMidiTimemap();
+
     // We need to populate processing lists for processing the document by Layer
     PrepareProcessingListsParams prepareProcessingListsParams;
     Functor prepareProcessingLists(&Object::PrepareProcessingLists);
@@ -1649,6 +2050,9 @@ double Doc::GetTopMargin(const ClassId classId) const
 
 Page *Doc::SetDrawingPage(int pageIdx)
 {
+    // The alignments and the positioners created by the layout are layout objects
+    ObjectArenaScope arenaScope(this->GetLayoutArena());
+
     // out of range
     if (!HasPage(pageIdx)) {
         return NULL;
@@ -1729,6 +2133,39 @@ Page *Doc::SetDrawingPage(int pageIdx)
     return m_drawingPage;
 }
 
+Clef *Doc::GetFacsClef(LayerElement *element)
+{
+    assert(element);
+
+    // (Re-)build the cache when the content has changed (see Doc::Modify)
+    if (!m_isFacsClefCacheValid) {
+        m_facsClefs.clear();
+        ArrayOfObjects objects;
+        this->FillFlatList(&objects);
+        Clef *clef = NULL;
+        for (Object *object : objects) {
+            if (object->Is(CLEF)) {
+                clef = vrv_cast<Clef *>(object);
+                assert(clef);
+            }
+            if (clef && object->IsLayerElement()) {
+                m_facsClefs[object] = clef;
+            }
+        }
+        m_isFacsClefCacheValid = true;
+    }
+
+    auto iter = m_facsClefs.find(element);
+    return (iter != m_facsClefs.end()) ? iter->second : NULL;
+}
+
+void Doc::Modify(bool modified)
+{
+    if (modified) m_isFacsClefCacheValid = false;
+
+    Object::Modify(modified);
+}
+
 int Doc::CalcMusicFontSize()
 {
     return m_options->m_unit.GetValue() * 8;
@@ -75,6 +75,22 @@ BeamDrawingInterface::~BeamDrawingInterface()
     ClearCoords();
 }
 
+BeamDrawingInterface::BeamDrawingInterface(const BeamDrawingInterface &interface)
+{
+    // The coordinates are owned by the interface and are not copied
+    Reset();
+}
+
+BeamDrawingInterface &BeamDrawingInterface::operator=(const BeamDrawingInterface &interface)
+{
+    // The coordinates are owned by the interface and are not copied
+    if (this != &interface) {
+        ClearCoords();
+        Reset();
+    }
+    return *this;
+}
+
 void BeamDrawingInterface::Reset()
 {
     m_changingDur = false;
@@ -1095,15 +1095,14 @@ bool EditorToolkitNeume::SetText(std::string elementId, std::string text)
     if (element->Is(SYL)) {
         Syl *syl = vrv_cast<Syl *>(element);
         assert(syl);
-        Object *child = syl->GetFirst();
-        if (child == NULL) {
+        if (syl->GetChildCount() == 0) {
             Text *text = new Text();
             syl->AddChild(text);
             text->SetText(wtext);
             success = true;
         }
         else {
-            while (child != NULL) {
+            for (Object *child : syl->GetChildRange()) {
                 if (child->Is(TEXT)) {
                     Text *text = dynamic_cast<Text *>(child);
                     text->SetText(wtext);
@@ -1119,7 +1118,6 @@ bool EditorToolkitNeume::SetText(std::string elementId, std::string text)
                         success = true;
                     }
                 }
-                child = syl->Object::GetNext();
             }
         }
     }
@@ -1294,7 +1292,7 @@ bool EditorToolkitNeume::Split(std::string elementId, int x)
     Layer *splitLayer = dynamic_cast<Layer *>(splitStaff->GetFirst(LAYER));
 
     // Move any elements that should be on the second staff there.
-    for (Object *child = layer->GetFirst(); child != NULL; child = layer->GetNext()) {
+    for (Object *child : layer->GetChildRange()) {
         assert(child);
         FacsimileInterface *fi = dynamic_cast<FacsimileInterface *>(child);
         if (fi == NULL || !fi->HasFacs()) {
@@ -9,6 +9,7 @@
 
 //----------------------------------------------------------------------------
 
+#include <algorithm>
 #include <assert.h>
 #include <iostream>
 
@@ -27,18 +28,34 @@ namespace vrv {
 // ExpansionMap
 //----------------------------------------------------------------------------
 
-ExpansionMap::ExpansionMap() {}
+ExpansionMap::ExpansionMap()
+{
+    Reset();
+}
 
 ExpansionMap::~ExpansionMap() {}
 
 void ExpansionMap::Reset()
 {
     m_map.clear();
+    m_generatedIds.clear();
+    m_generatedNotatedIds.clear();
+    m_usedIds.clear();
+    m_hasUsedIds = false;
 }
 
 void ExpansionMap::Expand(const xsdAnyURI_List &expansionList, xsdAnyURI_List &existingList, Object *prevSect)
 {
     assert(prevSect);
+
+    // the derived ids of the renditions are checked against the ids of the document before any is added
+    if (!m_hasUsedIds) {
+        const Object *root = prevSect;
+        while (root->GetParent()) root = root->GetParent();
+        this->CollectUsedIds(root);
+        m_hasUsedIds = true;
+    }
+
     // find all siblings of expansion element to know what in MEI file
     const vrv::ArrayOfObjects *expansionSiblings = prevSect->GetParent()->GetChildren();
     assert(expansionSiblings);
@@ -72,19 +89,7 @@ void ExpansionMap::Expand(const xsdAnyURI_List &expansionList, xsdAnyURI_List &e
                 // clone current section/ending/rdg/lem and rename it, adding -"rend2" for the first repetition etc.
                 Object *clonedObject = currSect->Clone();
                 clonedObject->CloneReset();
-                clonedObject->SetUuid(currSect->GetUuid() + "-rend"
-                    + std::to_string(GetExpansionIdsForElement(currSect->GetUuid()).size() + 1));
-
-                // get IDs of old and new sections and add them to m_map
-                std::vector<std::string> oldIds;
-                oldIds.push_back(currSect->GetUuid());
-                this->GetUuidList(currSect, oldIds);
-                std::vector<std::string> clonedIds;
-                clonedIds.push_back(clonedObject->GetUuid());
-                this->GetUuidList(clonedObject, clonedIds);
-                for (int i = 0; (i < (int)oldIds.size()) && (i < (int)clonedIds.size()); i++) {
-                    this->AddExpandedIdToExpansionMap(oldIds.at(i), clonedIds.at(i));
-                }
+                this->AddRendition(currSect, clonedObject);
 
                 // go through cloned objects, find TimePointing/SpanningInterface, PListInterface, LinkingInterface
                 UpdateIds(clonedObject);
@@ -132,7 +137,7 @@ bool ExpansionMap::UpdateIds(Object *object)
             // @startid
             std::string oldStartId = interface->GetStartid();
             if (oldStartId.rfind("#", 0) == 0) oldStartId = oldStartId.substr(1, oldStartId.size() - 1);
-            std::string newStartId = GetExpansionIdsForElement(oldStartId).back();
+            std::string newStartId = this->GetLastRenditionId(oldStartId);
             if (!newStartId.empty()) interface->SetStartid("#" + newStartId);
         }
         if (o->HasInterface(INTERFACE_TIME_SPANNING)) {
@@ -141,12 +146,12 @@ bool ExpansionMap::UpdateIds(Object *object)
             // @startid
             std::string oldStartId = interface->GetStartid();
             if (oldStartId.rfind("#", 0) == 0) oldStartId = oldStartId.substr(1, oldStartId.size() - 1);
-            std::string newStartId = GetExpansionIdsForElement(oldStartId).back();
+            std::string newStartId = this->GetLastRenditionId(oldStartId);
             if (!newStartId.empty()) interface->SetStartid("#" + newStartId);
             // @endid
             oldStartId = interface->GetEndid();
             if (oldStartId.rfind("#", 0) == 0) oldStartId = oldStartId.substr(1, oldStartId.size() - 1);
-            std::string newEndId = GetExpansionIdsForElement(oldStartId).back();
+            std::string newEndId = this->GetLastRenditionId(oldStartId);
             if (!newEndId.empty()) interface->SetEndid("#" + newEndId);
         }
         if (o->HasInterface(INTERFACE_PLIST)) {
@@ -156,7 +161,7 @@ bool ExpansionMap::UpdateIds(Object *object)
             xsdAnyURI_List newList;
             for (std::string oldRefString : oldList) {
                 if (oldRefString.rfind("#", 0) == 0) oldRefString = oldRefString.substr(1, oldRefString.size() - 1);
-                newList.push_back("#" + GetExpansionIdsForElement(oldRefString).back());
+                newList.push_back("#" + this->GetLastRenditionId(oldRefString));
             }
             interface->SetPlist(newList);
         }
@@ -166,32 +171,32 @@ bool ExpansionMap::UpdateIds(Object *object)
             // @sameas
             std::string oldIdString = interface->GetSameas();
             if (oldIdString.rfind("#", 0) == 0) oldIdString = oldIdString.substr(1, oldIdString.size() - 1);
-            std::string newIdString = GetExpansionIdsForElement(oldIdString).back();
+            std::string newIdString = this->GetLastRenditionId(oldIdString);
             if (!newIdString.empty()) interface->SetSameas("#" + newIdString);
             // @next
             oldIdString = interface->GetNext();
             if (oldIdString.rfind("#", 0) == 0) oldIdString = oldIdString.substr(1, oldIdString.size() - 1);
-            newIdString = GetExpansionIdsForElement(oldIdString).back();
+            newIdString = this->GetLastRenditionId(oldIdString);
             if (!newIdString.empty()) interface->SetNext("#" + newIdString);
             // @prev
             oldIdString = interface->GetPrev();
             if (oldIdString.rfind("#", 0) == 0) oldIdString = oldIdString.substr(1, oldIdString.size() - 1);
-            newIdString = GetExpansionIdsForElement(oldIdString).back();
+            newIdString = this->GetLastRenditionId(oldIdString);
             if (!newIdString.empty()) interface->SetPrev("#" + newIdString);
             // @copyof
             oldIdString = interface->GetCopyof();
             if (oldIdString.rfind("#", 0) == 0) oldIdString = oldIdString.substr(1, oldIdString.size() - 1);
-            newIdString = GetExpansionIdsForElement(oldIdString).back();
+            newIdString = this->GetLastRenditionId(oldIdString);
             if (!newIdString.empty()) interface->SetCopyof("#" + newIdString);
             // @corresp
             oldIdString = interface->GetCorresp();
             if (oldIdString.rfind("#", 0) == 0) oldIdString = oldIdString.substr(1, oldIdString.size() - 1);
-            newIdString = GetExpansionIdsForElement(oldIdString).back();
+            newIdString = this->GetLastRenditionId(oldIdString);
             if (!newIdString.empty()) interface->SetCorresp("#" + newIdString);
             // @synch
             oldIdString = interface->GetSynch();
             if (oldIdString.rfind("#", 0) == 0) oldIdString = oldIdString.substr(1, oldIdString.size() - 1);
-            newIdString = GetExpansionIdsForElement(oldIdString).back();
+            newIdString = this->GetLastRenditionId(oldIdString);
             if (!newIdString.empty()) interface->SetSynch("#" + newIdString);
         }
         UpdateIds(o);
@@ -199,51 +204,101 @@ bool ExpansionMap::UpdateIds(Object *object)
     return true;
 }
 
-bool ExpansionMap::AddExpandedIdToExpansionMap(const std::string &origXmlId, std::string newXmlId)
+void ExpansionMap::AddRendition(const Object *object, Object *clone)
 {
-    auto list = m_map.find(origXmlId);
-    if (list != m_map.end()) {
-        list->second.push_back(newXmlId); // add to existing key
-        for (std::string s : list->second) {
-            if (s != list->second.front() && s != list->second.back()) {
-                m_map.at(s).push_back(newXmlId); // add to middle keys
-            }
-        }
-        m_map.insert({ newXmlId, m_map.at(origXmlId) }); // add new as key
+    assert(object);
+    assert(clone);
+
+    // an element that is itself a rendition adds a rendition to its notated element
+    const std::string notatedId = this->GetNotatedId(object->GetUuid());
+    int &renditions = m_map[notatedId];
+    renditions = std::max(renditions, 1) + 1;
+    const std::string derivedId = notatedId + "-rend" + std::to_string(renditions);
+    if (m_usedIds.count(derivedId)) {
+        // keep the generated id of the clone
+        clone->ResetUuid();
+        m_generatedIds[derivedId] = clone->GetUuid();
+        m_generatedNotatedIds[clone->GetUuid()] = notatedId;
     }
     else {
-        std::vector<std::string> s;
-        s.push_back(origXmlId);
-        s.push_back(newXmlId);
-        m_map.insert({ origXmlId, s });
-        m_map.insert({ newXmlId, s });
+        clone->SetUuid(derivedId);
+    }
+
+    // children that are not cloned are missing in the clone
+    ChildRange clonedChildren = clone->GetChildRange();
+    ChildRange::Iterator clonedChild = clonedChildren.begin();
+    for (Object *child : object->GetChildRange()) {
+        if (clonedChild == clonedChildren.end()) break;
+        if ((*clonedChild)->GetClassId() != child->GetClassId()) continue;
+        this->AddRendition(child, *clonedChild);
+        ++clonedChild;
     }
-    return true;
 }
 
-std::vector<std::string> ExpansionMap::GetExpansionIdsForElement(const std::string &xmlId)
+std::vector<std::string> ExpansionMap::GetExpansionIdsForElement(const std::string &xmlId) const
 {
-    try {
-        return m_map.at(xmlId);
-    }
-    catch (std::out_of_range &e) {
-        std::vector<std::string> ids;
-        ids.push_back(xmlId.c_str());
-        return ids;
+    const std::string notatedId = this->GetNotatedId(xmlId);
+    auto entry = m_map.find(notatedId);
+    if (entry == m_map.end()) return { xmlId };
+
+    std::vector<std::string> ids;
+    ids.reserve(entry->second);
+    for (int i = 1; i <= entry->second; ++i) ids.push_back(this->GetRenditionId(notatedId, i));
+    return ids;
+}
+
+std::string ExpansionMap::GetNotatedId(const std::string &xmlId) const
+{
+    if (m_map.count(xmlId)) return xmlId;
+    auto generated = m_generatedNotatedIds.find(xmlId);
+    if (generated != m_generatedNotatedIds.end()) return generated->second;
+
+    const size_t pos = xmlId.rfind("-rend");
+    if (pos == std::string::npos) return xmlId;
+    const std::string notatedId = xmlId.substr(0, pos);
+    auto entry = m_map.find(notatedId);
+    if (entry == m_map.end()) return xmlId;
+
+    // make sure the suffix is the number of an existing rendition
+    const std::string suffix = xmlId.substr(pos + 5);
+    if (suffix.empty() || (suffix.find_first_not_of("0123456789") != std::string::npos)) return xmlId;
+    const int rendition = atoi(suffix.c_str());
+    // an id that was already used is not the one of the rendition
+    if ((rendition < 2) || (rendition > entry->second) || (this->GetRenditionId(notatedId, rendition) != xmlId)) {
+        return xmlId;
     }
+    return notatedId;
 }
 
-bool ExpansionMap::HasExpansionMap()
+std::string ExpansionMap::GetLastRenditionId(const std::string &xmlId) const
 {
-    return (m_map.empty()) ? false : true;
+    const std::string notatedId = this->GetNotatedId(xmlId);
+    auto entry = m_map.find(notatedId);
+    if (entry == m_map.end()) return xmlId;
+    return this->GetRenditionId(notatedId, entry->second);
 }
 
-void ExpansionMap::GetUuidList(Object *object, std::vector<std::string> &idList)
+std::string ExpansionMap::GetRenditionId(const std::string &notatedId, int rendition) const
 {
-    for (Object *o : *object->GetChildren()) {
-        idList.push_back(o->GetUuid());
-        GetUuidList(o, idList);
+    if (rendition < 2) return notatedId;
+    const std::string derivedId = notatedId + "-rend" + std::to_string(rendition);
+    auto generated = m_generatedIds.find(derivedId);
+    return (generated != m_generatedIds.end()) ? generated->second : derivedId;
+}
+
+void ExpansionMap::CollectUsedIds(const Object *object)
+{
+    assert(object);
+
+    for (Object *child : object->GetChildRange()) {
+        if (child->GetUuid().find("-rend") != std::string::npos) m_usedIds.insert(child->GetUuid());
+        this->CollectUsedIds(child);
     }
 }
 
+bool ExpansionMap::HasExpansionMap()
+{
+    return (m_map.empty()) ? false : true;
+}
+
 } // namespace vrv
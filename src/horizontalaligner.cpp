@@ -31,6 +31,21 @@
 
 namespace vrv {
 
+/**
+ * Reset the time span index of the measure when the alignments or the references of its MeasureAligner change.
+ * The object is the aligner, an alignment or a reference. Nothing is done for the other aligners.
+ */
+static void ResetTimeSpanIndex(Object *object)
+{
+    Object *aligner = object;
+    while (aligner && !aligner->Is({ MEASURE_ALIGNER, GRACE_ALIGNER, TIMESTAMP_ALIGNER })) {
+        aligner = aligner->GetParent();
+    }
+    if (!aligner || !aligner->Is(MEASURE_ALIGNER)) return;
+    Measure *measure = vrv_cast<Measure *>(aligner->GetParent());
+    if (measure) measure->m_timeSpanIndex.Reset();
+}
+
 //----------------------------------------------------------------------------
 // HorizontalAligner
 //----------------------------------------------------------------------------
@@ -86,6 +101,7 @@ void HorizontalAligner::AddAlignment(Alignment *alignment, int idx)
     else {
         InsertChild(alignment, idx);
     }
+    ResetTimeSpanIndex(this);
 }
 
 //----------------------------------------------------------------------------
@@ -663,6 +679,7 @@ void AlignmentReference::AddChild(Object *child)
     assert(child->GetParent() && this->IsReferenceObject());
     children->push_back(child);
     Modify();
+    ResetTimeSpanIndex(this);
 }
 
 void AlignmentReference::AddToAccidSpace(Accid *accid)
@@ -1164,7 +1181,11 @@ int AlignmentReference::UnsetCurrentScoreDef(FunctorParams *functorParams)
         case ALIGNMENT_SCOREDEF_CAUTION_CLEF:
         case ALIGNMENT_SCOREDEF_CAUTION_KEYSIG:
         case ALIGNMENT_SCOREDEF_CAUTION_MENSUR:
-        case ALIGNMENT_SCOREDEF_CAUTION_METERSIG: this->ClearChildren(); break;
+        case ALIGNMENT_SCOREDEF_CAUTION_METERSIG:
+            this->ClearChildren();
+            // The scoreDef elements are about to be deleted
+            ResetTimeSpanIndex(this);
+            break;
         default: break;
     }
 
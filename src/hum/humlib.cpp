@@ -18977,16 +18977,8 @@ bool HumdrumFileBase::read(const char* filename) {
 
 
 bool HumdrumFileBase::read(istream& contents) {
-	clear();
-	m_displayError = true;
-	char buffer[123123] = {0};
-	HLp s;
-	while (contents.getline(buffer, sizeof(buffer), '\n')) {
-		s = new HumdrumLine(buffer);
-		s->setOwner(this);
-		m_lines.push_back(s);
-	}
-	return analyzeBaseFromLines();
+	string buffer((istreambuf_iterator<char>(contents)), istreambuf_iterator<char>());
+	return readBuffer(buffer.data(), (int)buffer.size());
 /*
 	if (!analyzeTokens()) { return isValid(); }
 	if (!analyzeLines() ) { return isValid(); }
@@ -19081,17 +19073,40 @@ bool HumdrumFileBase::analyzeBaseFromTokens(void) {
 //
 
 bool HumdrumFileBase::readString(const string& contents) {
-	stringstream infile;
-	infile << contents;
-	bool status = read(infile);
-	return status;
+	return readBuffer(contents.data(), (int)contents.size());
 }
 
 
 bool HumdrumFileBase::readString(const char* contents) {
-	stringstream infile;
-	infile << contents;
-	return read(infile);
+	return readBuffer(contents, (int)strlen(contents));
+}
+
+
+
+//////////////////////////////
+//
+// HumdrumFileBase::readBuffer -- Split the contents into lines in place,
+//    without copying them into an intermediate stream first.  Each line
+//    (and each of its tokens) is then allocated once from the buffer.
+//
+
+bool HumdrumFileBase::readBuffer(const char* contents, int length) {
+	clear();
+	m_displayError = true;
+	HLp s;
+	const char* end = contents + length;
+	const char* start = contents;
+	while (start < end) {
+		const char* newline = (const char*)memchr(start, '\n', end - start);
+		if (newline == NULL) {
+			newline = end;
+		}
+		s = new HumdrumLine(start, (int)(newline - start));
+		s->setOwner(this);
+		m_lines.push_back(s);
+		start = newline + 1;
+	}
+	return analyzeBaseFromLines();
 }
 
 
@@ -25181,7 +25196,7 @@ restarting:
 		return 0;
 	}
 
-	stringstream buffer;
+	string buffer;
 	int foundUniversalQ = 0;
 
 	// Start reading the input stream.  If !!!!SEGMENT: universal comment
@@ -25214,7 +25229,8 @@ restarting:
 	// then treat it as part of the current file.
 	if ((m_newfilebuffer.size() > 1) &&
 		 (strncmp(m_newfilebuffer.c_str(), "**", 2)) == 0) {
-		buffer << m_newfilebuffer << "\n";
+		buffer += m_newfilebuffer;
+		buffer += '\n';
 		m_newfilebuffer = "";
 		starstarFoundQ = 1;
 	}
@@ -25338,7 +25354,8 @@ restarting:
 		// should empty lines be treated somewhat as universal comments?
 
 		// store the data line for later parsing into HumdrumFile record:
-		buffer << templine << "\n";
+		buffer += templine;
+		buffer += '\n';
 	}
 
 	if (dataFoundQ == 0) {
@@ -25350,25 +25367,27 @@ restarting:
 	}
 
 	// Arriving here means that reading of the data stream is complete.
-	// The string stream variable "buffer" contains the HumdrumFile
+	// The string variable "buffer" contains the HumdrumFile
 	// content, so send it to the HumdrumFile variable.  Also, prepend
 	// Universal comments (demoted into Global comments) at the start
 	// of the data stream (maybe allow for postpending Universal comments
 	// in the future).
-	stringstream contents;
-	contents.str(""); // empty any contents in buffer
-	contents.clear(); // reset error flags in buffer
-
+	string contents;
 	for (int i=0; i<(int)m_universals.size(); i++) {
 		// Convert universals reference records to globals, but do not demote !!!!filter:
 		if (m_universals[i].compare(0, 11, "!!!!filter:") == 0) {
 			continue;
 		}
-		contents << &(m_universals[i][1]) << "\n";
+		contents.append(m_universals[i], 1, string::npos);
+		contents += '\n';
+	}
+	if (contents.empty()) {
+		contents.swap(buffer);
+	} else {
+		contents += buffer;
 	}
-	contents << buffer.str();
 	string filename = infile.getFilename();
-	infile.readNoRhythm(contents);
+	infile.readStringNoRhythm(contents);
 	if (!filename.empty()) {
 		infile.setFilename(filename);
 	}
@@ -27373,6 +27392,16 @@ HumdrumLine::HumdrumLine(const char* aString) : string(aString) {
 }
 
 
+HumdrumLine::HumdrumLine(const char* aString, int length) :
+		string(aString, ((length > 0) && (aString[length-1] == 0x0d)) ? length - 1 : length) {
+	m_owner = NULL;
+	m_duration = -1;
+	m_durationFromStart = -1;
+	setPrefix("!!");
+	createTokensFromLine();
+}
+
+
 HumdrumLine::HumdrumLine(HumdrumLine& line)  : string((string)line) {
 	m_lineindex           = line.m_lineindex;
 	m_duration            = line.m_duration;
@@ -28537,9 +28566,6 @@ int HumdrumLine::createTokensFromLine(void) {
 	m_tokens.clear();
 	m_tabs.clear();
 	HTp token;
-	char ch = 0;
-	char lastch = 0;
-	string tstring;
 
 	if (this->size() == 0) {
 		token = new HumdrumToken();
@@ -28552,34 +28578,35 @@ int HumdrumLine::createTokensFromLine(void) {
 		m_tokens.push_back(token);
 		m_tabs.push_back(0);
 	} else {
-		for (int i=0; i<(int)size(); i++) {
-			lastch = ch;
-			ch = getChar(i);
-			if (ch == '\t') {
-				// Parser now allows multiple tab characters in a
-				// row to represent a single tab.
-				if (lastch != '\t') {
-					token = new HumdrumToken(tstring);
-					token->setOwner(this);
-					m_tokens.push_back(token);
-					m_tabs.push_back(1);
-					tstring.clear();
-				} else {
-					if (m_tabs.size() > 0) {
-						m_tabs.back()++;
-					}
-				}
+		// Tokens are created directly from the line contents between
+		// tabs rather than being accumulated character by character.
+		const char* line = this->c_str();
+		int length = (int)this->size();
+		int start = 0;
+		for (int i=0; i<length; i++) {
+			if (line[i] != '\t') {
+				continue;
+			}
+			// Parser now allows multiple tab characters in a
+			// row to represent a single tab.
+			if ((i == 0) || (line[i-1] != '\t')) {
+				token = new HumdrumToken(line + start, i - start);
+				token->setOwner(this);
+				m_tokens.push_back(token);
+				m_tabs.push_back(1);
 			} else {
-				tstring += ch;
+				if (m_tabs.size() > 0) {
+					m_tabs.back()++;
+				}
 			}
+			start = i + 1;
+		}
+		if (start < length) {
+			token = new HumdrumToken(line + start, length - start);
+			token->setOwner(this);
+			m_tokens.push_back(token);
+			m_tabs.push_back(0);
 		}
-	}
-	if (tstring.size() > 0) {
-		token = new HumdrumToken(tstring);
-		token->setOwner(this);
-		m_tokens.push_back(token);
-		m_tabs.push_back(0);
-		tstring.clear();
 	}
 
 	return (int)m_tokens.size();
@@ -29546,6 +29573,16 @@ HumdrumToken::HumdrumToken(const char* aString) : string(aString) {
 }
 
 
+HumdrumToken::HumdrumToken(const char* aString, int length) :
+		string(aString, length) {
+	m_rhycheck = 0;
+	setPrefix("!");
+	m_strand = -1;
+	m_nullresolve = NULL;
+	m_strophe     = NULL;
+}
+
+
 HumdrumToken::HumdrumToken(const HumdrumToken& token) :
 		string((string)token), HumHash((HumHash)token) {
 	m_address         = token.m_address;
@@ -0,0 +1,575 @@
+/////////////////////////////////////////////////////////////////////////////
+// Name:        inflater.cpp
+// Author:      agent
+// Created:     2026
+// Copyright (c) Authors and others. All rights reserved.
+/////////////////////////////////////////////////////////////////////////////
+
+#include "inflater.h"
+
+//----------------------------------------------------------------------------
+
+#include <algorithm>
+#include <cstring>
+
+//----------------------------------------------------------------------------
+
+#include "vrv.h"
+
+namespace vrv {
+
+//----------------------------------------------------------------------------
+// Constants and static helpers
+//----------------------------------------------------------------------------
+
+/** The number of bits decoded with a single lookup in the huffman tables */
+#define INFLATE_FAST_BITS 9
+#define INFLATE_MAX_BITS 15
+/** The ratio to the compressed size above which the size given in a header is not trusted for reserving the output */
+#define INFLATE_MAX_RESERVE_RATIO 32
+
+static const unsigned short s_lengthBase[29] = { 3, 4, 5, 6, 7, 8, 9, 10, 11, 13, 15, 17, 19, 23, 27, 31, 35, 43, 51,
+    59, 67, 83, 99, 115, 131, 163, 195, 227, 258 };
+static const unsigned char s_lengthExtra[29]
+    = { 0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2, 3, 3, 3, 3, 4, 4, 4, 4, 5, 5, 5, 5, 0 };
+static const unsigned short s_distBase[30] = { 1, 2, 3, 4, 5, 7, 9, 13, 17, 25, 33, 49, 65, 97, 129, 193, 257, 385,
+    513, 769, 1025, 1537, 2049, 3073, 4097, 6145, 8193, 12289, 16385, 24577 };
+static const unsigned char s_distExtra[30]
+    = { 0, 0, 0, 0, 1, 1, 2, 2, 3, 3, 4, 4, 5, 5, 6, 6, 7, 7, 8, 8, 9, 9, 10, 10, 11, 11, 12, 12, 13, 13 };
+/** The order of the code length codes in a dynamic block header */
+static const unsigned char s_codeLengthOrder[19] = { 16, 17, 18, 0, 8, 7, 9, 6, 10, 5, 11, 4, 12, 3, 13, 2, 14, 1, 15 };
+
+static unsigned int ReadUInt16(const unsigned char *data)
+{
+    return (unsigned int)data[0] | ((unsigned int)data[1] << 8);
+}
+
+static size_t GetReserveSize(size_t headerSize, size_t compressedSize)
+{
+    return std::min(headerSize, compressedSize * INFLATE_MAX_RESERVE_RATIO);
+}
+
+static unsigned int ReadUInt32(const unsigned char *data)
+{
+    return (unsigned int)data[0] | ((unsigned int)data[1] << 8) | ((unsigned int)data[2] << 16)
+        | ((unsigned int)data[3] << 24);
+}
+
+static std::vector<unsigned int> BuildCrc32Table()
+{
+    std::vector<unsigned int> table(256);
+    for (unsigned int i = 0; i < 256; ++i) {
+        unsigned int value = i;
+        for (int bit = 0; bit < 8; ++bit) value = (value & 1) ? (0xEDB88320 ^ (value >> 1)) : (value >> 1);
+        table[i] = value;
+    }
+    return table;
+}
+
+//----------------------------------------------------------------------------
+// HuffmanTable
+//----------------------------------------------------------------------------
+
+/**
+ * A canonical huffman table.
+ * Codes up to INFLATE_FAST_BITS are decoded with a single lookup (length << 9 | symbol, 0 if longer),
+ * longer codes by walking the code lengths.
+ */
+struct HuffmanTable {
+    unsigned short m_fast[1 << INFLATE_FAST_BITS];
+    unsigned short m_count[INFLATE_MAX_BITS + 1];
+    unsigned short m_symbols[288];
+
+    bool Build(const unsigned char *lengths, int symbolCount)
+    {
+        memset(m_fast, 0, sizeof(m_fast));
+        memset(m_count, 0, sizeof(m_count));
+        for (int i = 0; i < symbolCount; ++i) ++m_count[lengths[i]];
+        m_count[0] = 0;
+
+        // Check for over-subscribed codes - incomplete codes are allowed (e.g., a single distance code)
+        int left = 1;
+        for (int len = 1; len <= INFLATE_MAX_BITS; ++len) {
+            left <<= 1;
+            left -= m_count[len];
+            if (left < 0) return false;
+        }
+
+        unsigned short offsets[INFLATE_MAX_BITS + 2];
+        offsets[1] = 0;
+        for (int len = 1; len <= INFLATE_MAX_BITS; ++len) offsets[len + 1] = offsets[len] + m_count[len];
+
+        unsigned int nextCode[INFLATE_MAX_BITS + 1];
+        unsigned int code = 0;
+        for (int len = 1; len <= INFLATE_MAX_BITS; ++len) {
+            nextCode[len] = code;
+            code = (code + m_count[len]) << 1;
+        }
+
+        for (int symbol = 0; symbol < symbolCount; ++symbol) {
+            int len = lengths[symbol];
+            if (len == 0) continue;
+            m_symbols[offsets[len]++] = symbol;
+            if (len > INFLATE_FAST_BITS) {
+                ++nextCode[len];
+                continue;
+            }
+            // Codes are stored most-significant bit first but read least-significant bit first
+            unsigned int reversed = 0;
+            unsigned int value = nextCode[len]++;
+            for (int i = 0; i < len; ++i) {
+                reversed = (reversed << 1) | (value & 1);
+                value >>= 1;
+            }
+            for (unsigned int i = reversed; i < (1 << INFLATE_FAST_BITS); i += (1 << len)) {
+                m_fast[i] = (unsigned short)((len << 9) | symbol);
+            }
+        }
+        return true;
+    }
+
+    static HuffmanTable BuildFixed(bool literals)
+    {
+        HuffmanTable table;
+        unsigned char lengths[288];
+        if (literals) {
+            for (int i = 0; i < 144; ++i) lengths[i] = 8;
+            for (int i = 144; i < 256; ++i) lengths[i] = 9;
+            for (int i = 256; i < 280; ++i) lengths[i] = 7;
+            for (int i = 280; i < 288; ++i) lengths[i] = 8;
+            table.Build(lengths, 288);
+        }
+        else {
+            for (int i = 0; i < 30; ++i) lengths[i] = 5;
+            table.Build(lengths, 30);
+        }
+        return table;
+    }
+};
+
+//----------------------------------------------------------------------------
+// InflateStream
+//----------------------------------------------------------------------------
+
+/**
+ * The bit reader and the block decoding of a DEFLATE stream.
+ */
+class InflateStream {
+public:
+    InflateStream(const unsigned char *data, size_t length, std::string &output)
+        : m_data(data), m_length(length), m_pos(0), m_bitBuffer(0), m_bitCount(0), m_error(false), m_output(output)
+    {
+        m_start = output.size();
+    }
+
+    bool Run()
+    {
+        bool last = false;
+        while (!last) {
+            last = this->GetBits(1);
+            int type = this->GetBits(2);
+            if (m_error) return false;
+            bool success = false;
+            if (type == 0) {
+                success = this->ReadStoredBlock();
+            }
+            else if (type == 1) {
+                success = this->ReadFixedBlock();
+            }
+            else if (type == 2) {
+                success = this->ReadDynamicBlock();
+            }
+            if (!success || m_error) return false;
+        }
+        return true;
+    }
+
+    /** The number of input bytes actually used, i.e., without the bytes still buffered */
+    size_t GetConsumed() const { return m_pos - (m_bitCount / 8); }
+
+private:
+    void Refill()
+    {
+        while ((m_bitCount <= 24) && (m_pos < m_length)) {
+            m_bitBuffer |= (unsigned int)m_data[m_pos++] << m_bitCount;
+            m_bitCount += 8;
+        }
+    }
+
+    unsigned int GetBits(int count)
+    {
+        if (count == 0) return 0;
+        if (m_bitCount < count) {
+            this->Refill();
+            if (m_bitCount < count) {
+                m_error = true;
+                return 0;
+            }
+        }
+        unsigned int value = m_bitBuffer & ((1u << count) - 1);
+        m_bitBuffer >>= count;
+        m_bitCount -= count;
+        return value;
+    }
+
+    int Decode(const HuffmanTable &table)
+    {
+        if (m_bitCount < INFLATE_FAST_BITS) this->Refill();
+        unsigned short entry = table.m_fast[m_bitBuffer & ((1 << INFLATE_FAST_BITS) - 1)];
+        int len = entry >> 9;
+        if ((entry != 0) && (len <= m_bitCount)) {
+            m_bitBuffer >>= len;
+            m_bitCount -= len;
+            return entry & 0x1FF;
+        }
+        // Slow path for long codes (or at the very end of the input)
+        int code = 0;
+        int first = 0;
+        int index = 0;
+        for (len = 1; len <= INFLATE_MAX_BITS; ++len) {
+            code |= this->GetBits(1);
+            if (m_error) return -1;
+            int count = table.m_count[len];
+            if (code - count < first) return table.m_symbols[index + (code - first)];
+            index += count;
+            first += count;
+            first <<= 1;
+            code <<= 1;
+        }
+        m_error = true;
+        return -1;
+    }
+
+    bool ReadStoredBlock()
+    {
+        // Skip the remaining bits of the current byte
+        this->GetBits(m_bitCount % 8);
+        unsigned int length = this->GetBits(16);
+        unsigned int check = this->GetBits(16);
+        if (m_error || (length != (~check & 0xFFFF))) return false;
+        // Use the bytes still in the bit buffer first
+        while ((length > 0) && (m_bitCount >= 8)) {
+            m_output.push_back((char)this->GetBits(8));
+            --length;
+        }
+        if (m_pos + length > m_length) return false;
+        m_output.append((const char *)m_data + m_pos, length);
+        m_pos += length;
+        return true;
+    }
+
+    bool ReadFixedBlock()
+    {
+        // The fixed tables are built only once
+        static const HuffmanTable s_fixedLiterals = HuffmanTable::BuildFixed(true);
+        static const HuffmanTable s_fixedDistances = HuffmanTable::BuildFixed(false);
+
+        return this->ReadCodes(s_fixedLiterals, s_fixedDistances);
+    }
+
+    bool ReadDynamicBlock()
+    {
+        int literalCount = this->GetBits(5) + 257;
+        int distanceCount = this->GetBits(5) + 1;
+        int codeLengthCount = this->GetBits(4) + 4;
+        if (m_error || (literalCount > 286) || (distanceCount > 30)) return false;
+
+        unsigned char lengths[288 + 32];
+        memset(lengths, 0, sizeof(lengths));
+        for (int i = 0; i < codeLengthCount; ++i) {
+            lengths[s_codeLengthOrder[i]] = this->GetBits(3);
+        }
+        HuffmanTable codeLengths;
+        if (m_error || !codeLengths.Build(lengths, 19)) return false;
+
+        memset(lengths, 0, sizeof(lengths));
+        int index = 0;
+        while (index < literalCount + distanceCount) {
+            int symbol = this->Decode(codeLengths);
+            if (symbol < 0) return false;
+            if (symbol < 16) {
+                lengths[index++] = symbol;
+                continue;
+            }
+            unsigned char value = 0;
+            int repeat = 0;
+            if (symbol == 16) {
+                if (index == 0) return false;
+                value = lengths[index - 1];
+                repeat = 3 + this->GetBits(2);
+            }
+            else if (symbol == 17) {
+                repeat = 3 + this->GetBits(3);
+            }
+            else {
+                repeat = 11 + this->GetBits(7);
+            }
+            if (m_error || (index + repeat > literalCount + distanceCount)) return false;
+            while (repeat--) lengths[index++] = value;
+        }
+        // The end-of-block code is required
+        if (lengths[256] == 0) return false;
+
+        HuffmanTable literals;
+        HuffmanTable distances;
+        if (!literals.Build(lengths, literalCount)) return false;
+        if (!distances.Build(lengths + literalCount, distanceCount)) return false;
+
+        return this->ReadCodes(literals, distances);
+    }
+
+    bool ReadCodes(const HuffmanTable &literals, const HuffmanTable &distances)
+    {
+        while (true) {
+            int symbol = this->Decode(literals);
+            if (symbol < 0) return false;
+            if (symbol < 256) {
+                m_output.push_back((char)symbol);
+                continue;
+            }
+            if (symbol == 256) return true;
+
+            symbol -= 257;
+            if (symbol >= 29) return false;
+            size_t length = s_lengthBase[symbol] + this->GetBits(s_lengthExtra[symbol]);
+            int distSymbol = this->Decode(distances);
+            if ((distSymbol < 0) || (distSymbol >= 30)) return false;
+            size_t distance = s_distBase[distSymbol] + this->GetBits(s_distExtra[distSymbol]);
+            if (m_error || (distance > m_output.size() - m_start)) return false;
+
+            // Reserve first so that the copy can read from the output while appending to it
+            if (m_output.capacity() < m_output.size() + length) {
+                m_output.reserve(std::max(m_output.capacity() * 2, m_output.size() + length));
+            }
+            size_t from = m_output.size() - distance;
+            for (size_t i = 0; i < length; ++i) {
+                m_output.push_back(m_output[from + i]);
+            }
+        }
+    }
+
+private:
+    const unsigned char *m_data;
+    size_t m_length;
+    size_t m_pos;
+    unsigned int m_bitBuffer;
+    int m_bitCount;
+    bool m_error;
+    std::string &m_output;
+    size_t m_start;
+};
+
+//----------------------------------------------------------------------------
+// ZipEntry
+//----------------------------------------------------------------------------
+
+/**
+ * An entry of the central directory of a zip archive.
+ */
+struct ZipEntry {
+    std::string m_name;
+    unsigned int m_method;
+    unsigned int m_crc;
+    unsigned int m_compressedSize;
+    unsigned int m_size;
+    unsigned int m_localOffset;
+};
+
+static bool ReadZipDirectory(const std::string &data, std::vector<ZipEntry> &entries)
+{
+    const unsigned char *bytes = (const unsigned char *)data.c_str();
+    const size_t size = data.size();
+    if (size < 22) return false;
+
+    // The end of central directory record is at the end, followed by a comment of at most 65535 bytes
+    size_t end = size - 22;
+    size_t limit = (end > 65535) ? end - 65535 : 0;
+    while (ReadUInt32(bytes + end) != 0x06054b50) {
+        if (end == limit) {
+            LogError("The zip archive has no central directory");
+            return false;
+        }
+        --end;
+    }
+
+    unsigned int entryCount = ReadUInt16(bytes + end + 10);
+    size_t offset = ReadUInt32(bytes + end + 16);
+    if (offset == 0xFFFFFFFF) {
+        LogError("Zip64 archives are not supported");
+        return false;
+    }
+
+    entries.clear();
+    for (unsigned int i = 0; i < entryCount; ++i) {
+        if ((offset + 46 > size) || (ReadUInt32(bytes + offset) != 0x02014b50)) {
+            LogError("The zip archive central directory is corrupted");
+            return false;
+        }
+        ZipEntry entry;
+        entry.m_method = ReadUInt16(bytes + offset + 10);
+        entry.m_crc = ReadUInt32(bytes + offset + 16);
+        entry.m_compressedSize = ReadUInt32(bytes + offset + 20);
+        entry.m_size = ReadUInt32(bytes + offset + 24);
+        unsigned int nameLength = ReadUInt16(bytes + offset + 28);
+        unsigned int extraLength = ReadUInt16(bytes + offset + 30);
+        unsigned int commentLength = ReadUInt16(bytes + offset + 32);
+        entry.m_localOffset = ReadUInt32(bytes + offset + 42);
+        if (offset + 46 + nameLength > size) return false;
+        entry.m_name.assign((const char *)bytes + offset + 46, nameLength);
+        entries.push_back(entry);
+        offset += 46 + nameLength + extraLength + commentLength;
+    }
+
+    return true;
+}
+
+//----------------------------------------------------------------------------
+// Inflater
+//----------------------------------------------------------------------------
+
+bool Inflater::IsGzip(const std::string &data)
+{
+    return ((data.size() >= 2) && ((unsigned char)data[0] == 0x1F) && ((unsigned char)data[1] == 0x8B));
+}
+
+bool Inflater::IsZip(const std::string &data)
+{
+    return ((data.size() >= 4) && (memcmp(data.c_str(), "PK\x03\x04", 4) == 0));
+}
+
+bool Inflater::Gunzip(const std::string &data, std::string &output)
+{
+    const unsigned char *bytes = (const unsigned char *)data.c_str();
+    const size_t size = data.size();
+
+    output.clear();
+    // The size of the (last) member is stored in the last four bytes, and checked against the output when inflated
+    if (size >= 18) output.reserve(GetReserveSize(ReadUInt32(bytes + size - 4), size));
+
+    // Concatenated gzip members are decompressed one after the other
+    size_t pos = 0;
+    while ((pos + 18 <= size) && (bytes[pos] == 0x1F) && (bytes[pos + 1] == 0x8B)) {
+        if (bytes[pos + 2] != 8) {
+            LogError("Unsupported gzip compression method %d", bytes[pos + 2]);
+            return false;
+        }
+        const unsigned char flags = bytes[pos + 3];
+        pos += 10;
+        // FEXTRA
+        if (flags & 0x04) {
+            if (pos + 2 > size) break;
+            pos += 2 + ReadUInt16(bytes + pos);
+        }
+        // FNAME and FCOMMENT are zero-terminated
+        for (unsigned char flag : { 0x08, 0x10 }) {
+            if (!(flags & flag)) continue;
+            while ((pos < size) && bytes[pos]) ++pos;
+            ++pos;
+        }
+        // FHCRC
+        if (flags & 0x02) pos += 2;
+        if (pos >= size) break;
+
+        size_t start = output.size();
+        size_t consumed = 0;
+        if (!Inflater::Inflate(bytes + pos, size - pos, output, consumed)) {
+            LogError("The gzip data is corrupted");
+            return false;
+        }
+        pos += consumed;
+        if (pos + 8 > size) break;
+        if ((Inflater::Crc32(output.c_str() + start, output.size() - start) != ReadUInt32(bytes + pos))
+            || ((unsigned int)(output.size() - start) != ReadUInt32(bytes + pos + 4))) {
+            LogError("The gzip data checksum does not match");
+            return false;
+        }
+        pos += 8;
+    }
+
+    if (pos != size) {
+        LogError("The gzip data is truncated");
+        return false;
+    }
+    return true;
+}
+
+bool Inflater::GetZipEntryNames(const std::string &data, std::vector<std::string> &names)
+{
+    std::vector<ZipEntry> entries;
+    if (!ReadZipDirectory(data, entries)) return false;
+
+    names.clear();
+    for (auto const &entry : entries) names.push_back(entry.m_name);
+    return true;
+}
+
+bool Inflater::Unzip(const std::string &data, const std::string &name, std::string &output)
+{
+    std::vector<ZipEntry> entries;
+    if (!ReadZipDirectory(data, entries)) return false;
+
+    auto entry = std::find_if(
+        entries.begin(), entries.end(), [&name](const ZipEntry &zipEntry) { return zipEntry.m_name == name; });
+    if (entry == entries.end()) return false;
+
+    const unsigned char *bytes = (const unsigned char *)data.c_str();
+    size_t offset = entry->m_localOffset;
+    if ((offset + 30 > data.size()) || (ReadUInt32(bytes + offset) != 0x04034b50)) {
+        LogError("The zip entry '%s' is corrupted", name.c_str());
+        return false;
+    }
+    offset += 30 + ReadUInt16(bytes + offset + 26) + ReadUInt16(bytes + offset + 28);
+    if (offset + entry->m_compressedSize > data.size()) {
+        LogError("The zip entry '%s' is truncated", name.c_str());
+        return false;
+    }
+
+    output.clear();
+    if (entry->m_method == 0) {
+        output.assign((const char *)bytes + offset, entry->m_compressedSize);
+    }
+    else if (entry->m_method == 8) {
+        output.reserve(GetReserveSize(entry->m_size, entry->m_compressedSize));
+        size_t consumed = 0;
+        if (!Inflater::Inflate(bytes + offset, entry->m_compressedSize, output, consumed)) {
+            LogError("The zip entry '%s' is corrupted", name.c_str());
+            return false;
+        }
+    }
+    else {
+        LogError("Unsupported compression method %d for the zip entry '%s'", entry->m_method, name.c_str());
+        return false;
+    }
+
+    if (output.size() != entry->m_size) {
+        LogError("The zip entry '%s' size does not match", name.c_str());
+        return false;
+    }
+    if (Inflater::Crc32(output.c_str(), output.size()) != entry->m_crc) {
+        LogError("The zip entry '%s' checksum does not match", name.c_str());
+        return false;
+    }
+    return true;
+}
+
+bool Inflater::Inflate(const unsigned char *data, size_t length, std::string &output, size_t &consumed)
+{
+    InflateStream stream(data, length, output);
+    bool success = stream.Run();
+    consumed = stream.GetConsumed();
+    return success;
+}
+
+unsigned int Inflater::Crc32(const char *data, size_t length)
+{
+    static const std::vector<unsigned int> s_table = BuildCrc32Table();
+
+    unsigned int crc = 0xFFFFFFFF;
+    const unsigned char *bytes = (const unsigned char *)data;
+    for (size_t i = 0; i < length; ++i) {
+        crc = s_table[(crc ^ bytes[i]) & 0xFF] ^ (crc >> 8);
+    }
+    return crc ^ 0xFFFFFFFF;
+}
+
+} // namespace vrv
@@ -9080,7 +9080,7 @@ void HumdrumInput::addExplicitStemDirection(FTrem *ftrem, hum::HTp start)
     // also deal with chords later
     for (int i = 0; i < count; ++i) {
         Object *obj = ftrem->GetChild(i);
-        if (obj->GetClassName() == "Note") {
+        if (obj->Is(NOTE)) {
             if (direction > 0) {
                 ((Note *)obj)->SetStemDir(STEMDIRECTION_up);
             }
@@ -10982,7 +10982,7 @@ void HumdrumInput::processLinkedDirection(int index, hum::HTp token, int staffin
             int count = dir->GetChildCount();
             for (int j = 0; j < count; j++) {
                 Object *obj = dir->GetChild(j);
-                if (obj->GetClassName() != "Rend") {
+                if (!obj->Is(REND)) {
                     continue;
                 }
                 Rend *item = (Rend *)obj;
@@ -12824,7 +12824,7 @@ void HumdrumInput::addTextElement(
     Text *text = new Text;
 
     std::string data = content;
-    if (element->GetClassName() == "Syl") {
+    if (element->Is(SYL)) {
         // Approximate centering of single-letter text on noteheads.
         // currently the text is left justified to the left edge of the notehead.
         if ((content.size() == 1) && addSpacer) {
@@ -18897,8 +18897,7 @@ template <class ELEMENT> hum::HumNum HumdrumInput::convertRhythm(ELEMENT element
                 int staff = m_currentstaff;
                 int staffindex = staff - 1;
                 std::vector<humaux::StaffStateVariables> &ss = m_staffstates;
-                if (ss[staffindex].righthalfstem
-                    && ((element->GetClassName() == "Note") || (element->GetClassName() == "Chord"))) {
+                if (ss[staffindex].righthalfstem && element->Is({ NOTE, CHORD })) {
                     m_setrightstem = true;
                 }
             } break;
@@ -133,12 +133,30 @@ namespace vrv {
 std::vector<std::string> MEIInput::s_editorialElementNames = { "abbr", "add", "app", "annot", "choice", "corr",
     "damage", "del", "expan", "orig", "ref", "reg", "restore", "sic", "subst", "supplied", "unclear" };
 
+//----------------------------------------------------------------------------
+// StringWriter
+//----------------------------------------------------------------------------
+
+/**
+ * A pugi::xml_writer appending directly to a std::string
+ */
+class StringWriter : public pugi::xml_writer {
+public:
+    StringWriter(std::string &output) : m_output(output) {}
+    virtual void write(const void *data, size_t size) { m_output.append(static_cast<const char *>(data), size); }
+
+private:
+    std::string &m_output;
+};
+
 //----------------------------------------------------------------------------
 // MEIOutput
 //----------------------------------------------------------------------------
 
 MEIOutput::MEIOutput(Doc *doc) : Output(doc)
 {
+    m_writer = NULL;
+    m_streamFlags = pugi::format_default;
     m_page = -1;
     m_indent = 5;
     m_scoreBasedMEI = false;
@@ -147,9 +165,49 @@ MEIOutput::MEIOutput(Doc *doc) : Output(doc)
 
 MEIOutput::~MEIOutput() {}
 
-bool MEIOutput::Export()
+bool MEIOutput::Export(std::ostream &output, int page)
 {
+    pugi::xml_writer_stream writer(output);
+    m_page = page;
+    bool success = this->Export(writer);
+    m_page = -1;
+
+    return success;
+}
+
+bool MEIOutput::Export(pugi::xml_writer &writer)
+{
+    m_streamFlags = pugi::format_default;
+    if (m_doc->GetOptions()->m_outputSmuflXmlEntities.GetValue()) {
+        m_streamFlags |= pugi::format_no_escapes;
+    }
+    m_streamIndent = (m_indent == -1) ? "\t" : std::string(m_indent, ' ');
+    m_streamedNodes.clear();
+    m_writer = &writer;
+
+    // Same as pugi::xml_document::save when the document has no declaration (page output)
+    if (m_page >= 0) {
+        const char *declaration = "<?xml version=\"1.0\"?>\n";
+        m_writer->write(declaration, strlen(declaration));
+    }
+
+    pugi::xml_document meiDoc;
+    bool success = this->ExportDocument(meiDoc);
+
+    if (success) {
+        // Write everything that is left and close the nodes still open
+        m_currentNode = meiDoc;
+        this->FlushStream(true);
+    }
+
+    m_writer = NULL;
+    m_streamedNodes.clear();
 
+    return success;
+}
+
+bool MEIOutput::ExportDocument(pugi::xml_document &meiDoc)
+{
     if (m_removeIds) {
         FindAllReferencedObjectsParams findAllReferencedObjectsParams(&m_referredObjects);
         Functor findAllReferencedObjects(&Object::FindAllReferencedObjects);
@@ -158,8 +216,6 @@ bool MEIOutput::Export()
     }
 
     try {
-        pugi::xml_document meiDoc;
-
         if (m_page < 0) {
             pugi::xml_node decl = meiDoc.prepend_child(pugi::node_declaration);
             decl.append_attribute("version") = "1.0";
@@ -218,14 +274,6 @@ bool MEIOutput::Export()
 
             page->Save(this);
         }
-
-        unsigned int output_flags = pugi::format_default;
-        if (m_doc->GetOptions()->m_outputSmuflXmlEntities.GetValue()) {
-            output_flags |= pugi::format_no_escapes;
-        }
-
-        std::string indent = (m_indent == -1) ? "\t" : std::string(m_indent, ' ');
-        meiDoc.save(m_streamStringOutput, indent.c_str(), output_flags);
     }
     catch (char *str) {
         LogError("%s", str);
@@ -237,11 +285,126 @@ bool MEIOutput::Export()
 
 std::string MEIOutput::GetOutput(int page)
 {
+    std::string output;
+    StringWriter writer(output);
     m_page = page;
-    this->Export();
+    this->Export(writer);
     m_page = -1;
 
-    return m_streamStringOutput.str();
+    return output;
+}
+
+void MEIOutput::FlushStream(bool final)
+{
+    assert(m_writer);
+
+    // The open nodes are the ancestors of the current node
+    std::vector<pugi::xml_node> openNodes;
+    if (!final) {
+        for (pugi::xml_node node = m_currentNode; node.type() == pugi::node_element; node = node.parent()) {
+            openNodes.insert(openNodes.begin(), node);
+        }
+    }
+
+    // Close the nodes started previously that are not open anymore, deepest first
+    size_t common = 0;
+    while ((common < m_streamedNodes.size()) && (common < openNodes.size())
+        && (m_streamedNodes.at(common) == openNodes.at(common))) {
+        ++common;
+    }
+    while (m_streamedNodes.size() > common) {
+        pugi::xml_node node = m_streamedNodes.back();
+        unsigned int depth = (unsigned int)m_streamedNodes.size() - 1;
+        while (pugi::xml_node child = node.first_child()) {
+            child.print(*m_writer, m_streamIndent.c_str(), m_streamFlags, pugi::encoding_auto, depth + 1);
+            node.remove_child(child);
+        }
+        this->WriteStreamEndTag(node, depth);
+        node.parent().remove_child(node);
+        m_streamedNodes.pop_back();
+    }
+
+    // Write the completed nodes preceding each open node and the start tags not written yet
+    pugi::xml_node parent = (final) ? m_currentNode : m_currentNode.root();
+    unsigned int depth = 0;
+    for (pugi::xml_node &node : openNodes) {
+        while (parent.first_child() != node) {
+            pugi::xml_node child = parent.first_child();
+            child.print(*m_writer, m_streamIndent.c_str(), m_streamFlags, pugi::encoding_auto, depth);
+            parent.remove_child(child);
+        }
+        if (depth >= m_streamedNodes.size()) {
+            this->WriteStreamStartTag(node, depth);
+            m_streamedNodes.push_back(node);
+        }
+        parent = node;
+        ++depth;
+    }
+
+    if (final) {
+        while (pugi::xml_node child = parent.first_child()) {
+            child.print(*m_writer, m_streamIndent.c_str(), m_streamFlags, pugi::encoding_auto, 0);
+            parent.remove_child(child);
+        }
+    }
+}
+
+void MEIOutput::WriteStreamIndent(unsigned int depth)
+{
+    for (unsigned int i = 0; i < depth; ++i) {
+        m_writer->write(m_streamIndent.c_str(), m_streamIndent.size());
+    }
+}
+
+void MEIOutput::WriteStreamStartTag(pugi::xml_node node, unsigned int depth)
+{
+    // This needs to match the output of pugi::xml_node::print with pugi::format_indent
+    this->WriteStreamIndent(depth);
+    m_writer->write("<", 1);
+    m_writer->write(node.name(), strlen(node.name()));
+    for (pugi::xml_attribute attr = node.first_attribute(); attr; attr = attr.next_attribute()) {
+        m_writer->write(" ", 1);
+        m_writer->write(attr.name(), strlen(attr.name()));
+        m_writer->write("=\"", 2);
+        this->WriteStreamEscaped(attr.value());
+        m_writer->write("\"", 1);
+    }
+    m_writer->write(">\n", 2);
+}
+
+void MEIOutput::WriteStreamEndTag(pugi::xml_node node, unsigned int depth)
+{
+    this->WriteStreamIndent(depth);
+    m_writer->write("</", 2);
+    m_writer->write(node.name(), strlen(node.name()));
+    m_writer->write(">\n", 2);
+}
+
+void MEIOutput::WriteStreamEscaped(const char *value)
+{
+    if (m_streamFlags & pugi::format_no_escapes) {
+        m_writer->write(value, strlen(value));
+        return;
+    }
+
+    // Same escaping as pugixml for attribute values
+    const char *start = value;
+    for (const char *c = value; *c; ++c) {
+        std::string escaped;
+        switch (*c) {
+            case '&': escaped = "&amp;"; break;
+            case '<': escaped = "&lt;"; break;
+            case '"': escaped = "&quot;"; break;
+            default:
+                if ((unsigned char)*c < 32) escaped = StringFormat("&#%02d;", (int)*c);
+                break;
+        }
+        if (escaped.empty()) continue;
+        m_writer->write(start, c - start);
+        m_writer->write(escaped.c_str(), escaped.size());
+        start = c + 1;
+    }
+    m_writer->write(start, strlen(start));
 }
 
 bool MEIOutput::WriteObject(Object *object)
@@ -783,6 +946,11 @@ bool MEIOutput::WriteObjectEnd(Object *object)
     m_nodeStack.pop_back();
     m_currentNode = m_nodeStack.back();
 
+    // When streaming, write the completed measures and system elements and release their nodes
+    if (m_writer && (object->Is(MEASURE) || object->IsSystemElement())) {
+        this->FlushStream(false);
+    }
+
     return true;
 }
 
@@ -1925,7 +2093,7 @@ void MEIOutput::WriteFacsimile(pugi::xml_node currentNode, Facsimile *facsimile)
     WriteXmlId(currentNode, facsimile);
 
     // Write Surface(s)
-    for (Object *child = facsimile->GetFirst(); child != NULL; child = facsimile->GetNext()) {
+    for (Object *child : facsimile->GetChildRange()) {
         if (child->GetClassId() == SURFACE) {
             pugi::xml_node childNode = currentNode.append_child("surface");
             WriteSurface(childNode, dynamic_cast<Surface *>(child));
@@ -1943,7 +2111,7 @@ void MEIOutput::WriteSurface(pugi::xml_node currentNode, Surface *surface)
     surface->WriteCoordinated(currentNode);
     surface->WriteTyped(currentNode);
 
-    for (Object *child = surface->GetFirst(); child != NULL; child = surface->GetNext()) {
+    for (Object *child : surface->GetChildRange()) {
         if (child->GetClassId() == ZONE) {
             pugi::xml_node childNode = currentNode.append_child("zone");
             WriteZone(childNode, dynamic_cast<Zone *>(child));
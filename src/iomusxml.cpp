@@ -96,7 +96,49 @@ enum MordentExtSymbolFlags {
 // MusicXmlInput
 //----------------------------------------------------------------------------
 
-MusicXmlInput::MusicXmlInput(Doc *doc) : Input(doc) {}
+MusicXmlInput::MusicXmlInput(Doc *doc)
+    : Input(doc)
+    , m_xpathMultipleRest(".//multiple-rest")
+    , m_xpathFirstPartParent("parent::part[not(preceding-sibling::part)]")
+    , m_xpathFirstPartAncestor("ancestor::part[not(preceding-sibling::part)]")
+    , m_xpathPrecedingKey("preceding-sibling::attributes/key")
+    , m_xpathMeasureRepeat("measure-style/measure-repeat")
+    , m_xpathMeasureSlash("measure-style/slash")
+    , m_xpathWords("direction-type/words")
+    , m_xpathDynamics("direction-type/dynamics")
+    , m_xpathDynamicsAndWords("direction-type/dynamics|direction-type/words")
+    , m_xpathSoundTempo("sound[@tempo]")
+    , m_xpathBracketOrDashes("bracket|dashes")
+    , m_xpathWedges("direction-type/wedge")
+    , m_xpathExtendStart("extend[@type='start']")
+    , m_xpathNotations("notations[not(@print-object='no')]")
+    , m_xpathCueType("type[@size='cue']")
+    , m_xpathBeamStart("beam[@number='1'][text()='begin']")
+    , m_xpathBeamEnd("beam[text()='end']")
+    , m_xpathBeamContinue("beam[text()='continue']")
+    , m_xpathTremolo("ornaments/tremolo")
+    , m_xpathTremoloStart("notations/ornaments/tremolo[@type='start']")
+    , m_xpathTieStart("tied[@type='start']")
+    , m_xpathTieStop("tied[@type='stop']")
+    , m_xpathUnplacedArticulation("articulations/*[not(@placement)]")
+    , m_xpathBreathMark("articulations/breath-mark")
+    , m_xpathFingering("technical/fingering")
+    , m_xpathGlissandi("glissando|slide")
+    , m_xpathMordent("ornaments/*[contains(name(), 'mordent')]")
+    , m_xpathExtOrnament("ornaments/*[contains(name(), 'schleifer') or contains(name(), 'haydn')]")
+    , m_xpathTrillMark("ornaments/trill-mark")
+    , m_xpathWavyLineStart("ornaments/wavy-line[@type='start']")
+    , m_xpathWavyLineStop("ornaments/wavy-line[@type='stop']")
+    , m_xpathTurn("ornaments/*[contains(name(), 'turn')]")
+    , m_xpathArpeggiate("*[contains(name(), 'arpeggiate')]")
+    , m_xpathSlurs("notations/slur")
+    , m_xpathTupletStart("notations/tuplet[@type='start']")
+    , m_xpathTupletStop("tuplet[@type='stop']")
+    , m_xpathNextBeamEnd("./following-sibling::note[beam[@number='1'][text()='end']]")
+    , m_xpathNextTupletStart("./following-sibling::note[notations[tuplet[@type='start']]]")
+    , m_xpathNextTupletStop("./following-sibling::note[notations[tuplet[@type='stop']]]")
+{
+}
 
 MusicXmlInput::~MusicXmlInput() {}
 
@@ -162,6 +204,14 @@ std::string MusicXmlInput::GetContent(const pugi::xml_node node) const
 
 std::string MusicXmlInput::GetContentOfChild(const pugi::xml_node node, const std::string &child) const
 {
+    // Use a plain child lookup when the child is given by its name only
+    if (child.find_first_of("/[*|@:.()") == std::string::npos) {
+        pugi::xml_node childNode = node.child(child.c_str());
+        if (childNode) {
+            return GetContent(childNode);
+        }
+        return "";
+    }
     pugi::xpath_node childNode = node.select_node(child.c_str());
     if (childNode.node()) {
         return GetContent(childNode.node());
@@ -554,12 +604,15 @@ void MusicXmlInput::PrintMetronome(pugi::xml_node metronome, Tempo *tempo)
         tempo->AddChild(text);
     }
 
-    int dotCount = (int)metronome.select_nodes("beat-unit-dot").size();
+    int dotCount = 0;
+    for (pugi::xml_node dot = metronome.child("beat-unit-dot"); dot; dot = dot.next_sibling("beat-unit-dot")) {
+        ++dotCount;
+    }
     if (dotCount) {
         tempo->SetMmDots(dotCount);
     }
 
-    pugi::xml_node beatunit = metronome.select_node("beat-unit").node();
+    pugi::xml_node beatunit = metronome.child("beat-unit");
     if (beatunit) {
         std::wstring verovioText;
         std::string content = GetContent(beatunit);
@@ -579,7 +632,7 @@ void MusicXmlInput::PrintMetronome(pugi::xml_node metronome, Tempo *tempo)
     }
 
     rawText = "";
-    pugi::xml_node perminute = metronome.select_node("per-minute").node();
+    pugi::xml_node perminute = metronome.child("per-minute");
     if (perminute) {
         std::string mm = GetContent(perminute);
         double mmval = 0.0;
@@ -772,9 +825,10 @@ bool MusicXmlInput::ReadMusicXml(pugi::xml_node root)
         else if (IsElement(xpathNode.node(), "score-part")) {
             // get the attributes element of the first measure of the part
             const std::string partId = xpathNode.node().attribute("id").as_string();
-            std::string xpath = StringFormat("/score-partwise/part[@id='%s']/measure[1]", partId.c_str());
-            pugi::xpath_node partFirstMeasure = root.select_node(xpath.c_str());
-            if (!partFirstMeasure.node().select_node("attributes")) {
+            pugi::xml_node part
+                = root.root().child("score-partwise").find_child_by_attribute("part", "id", partId.c_str());
+            pugi::xml_node partFirstMeasure = part.child("measure");
+            if (!partFirstMeasure.child("attributes")) {
                 LogWarning("MusicXML import: Could not find the 'attributes' element in the first "
                            "measure of part '%s'",
                     partId.c_str());
@@ -783,11 +837,12 @@ bool MusicXmlInput::ReadMusicXml(pugi::xml_node root)
             // part-name should be revised, as soon MEI can suppress labels
             std::string partName = GetContentOfChild(xpathNode.node(), "part-name[not(@print-object='no')]");
             std::string partAbbr = GetContentOfChild(xpathNode.node(), "part-abbreviation[not(@print-object='no')]");
-            pugi::xpath_node midiInstrument = xpathNode.node().select_node("midi-instrument");
+            pugi::xml_node midiInstrument = xpathNode.node().child("midi-instrument");
             if (!partName.empty() && !m_label) {
                 m_label = new Label();
-                if (xpathNode.node().select_node("part-name-display[not(@print-object='no')]")) {
-                    std::string name = StyleLabel(xpathNode.node().select_node("part-name-display").node());
+                pugi::xml_node nameDisplay = xpathNode.node().child("part-name-display");
+                if (nameDisplay && !HasAttributeWithValue(nameDisplay, "print-object", "no")) {
+                    std::string name = StyleLabel(nameDisplay);
                     Text *text = new Text();
                     text->SetText(UTF8to16(name));
                     m_label->AddChild(text);
@@ -809,8 +864,9 @@ bool MusicXmlInput::ReadMusicXml(pugi::xml_node root)
             }
             if (!partAbbr.empty() && !m_labelAbbr) {
                 m_labelAbbr = new LabelAbbr();
-                if (xpathNode.node().select_node("part-abbreviation-display[not(@print-object='no')]")) {
-                    std::string name = StyleLabel(xpathNode.node().select_node("part-abbreviation-display").node());
+                pugi::xml_node abbrDisplay = xpathNode.node().child("part-abbreviation-display");
+                if (abbrDisplay && !HasAttributeWithValue(abbrDisplay, "print-object", "no")) {
+                    std::string name = StyleLabel(abbrDisplay);
                     Text *text = new Text();
                     text->SetText(UTF8to16(name));
                     m_labelAbbr->AddChild(text);
@@ -833,21 +889,21 @@ bool MusicXmlInput::ReadMusicXml(pugi::xml_node root)
             if (midiInstrument && !m_instrdef) {
                 m_instrdef = new InstrDef;
                 m_instrdef->SetMidiInstrname(m_instrdef->AttMidiInstrument::StrToMidinames(
-                    midiInstrument.node().select_node("midi-name").node().text().as_string()));
-                pugi::xpath_node midiChannel = midiInstrument.node().select_node("midi-channel");
-                if (midiChannel) m_instrdef->SetMidiChannel(midiChannel.node().text().as_int() - 1);
-                // pugi::xpath_node midiPan = midiInstrument.node().select_node("pan");
-                // if (midiPan) instrdef->SetMidiPan(midiPan.node().text().as_int());
-                pugi::xpath_node midiProgram = midiInstrument.node().select_node("midi-program");
-                if (midiProgram) m_instrdef->SetMidiInstrnum(midiProgram.node().text().as_int() - 1);
-                pugi::xpath_node midiVolume = midiInstrument.node().select_node("volume");
-                if (midiVolume) m_instrdef->SetMidiVolume(midiVolume.node().text().as_int());
+                    midiInstrument.child("midi-name").text().as_string()));
+                pugi::xml_node midiChannel = midiInstrument.child("midi-channel");
+                if (midiChannel) m_instrdef->SetMidiChannel(midiChannel.text().as_int() - 1);
+                // pugi::xml_node midiPan = midiInstrument.child("pan");
+                // if (midiPan) instrdef->SetMidiPan(midiPan.text().as_int());
+                pugi::xml_node midiProgram = midiInstrument.child("midi-program");
+                if (midiProgram) m_instrdef->SetMidiInstrnum(midiProgram.text().as_int() - 1);
+                pugi::xml_node midiVolume = midiInstrument.child("volume");
+                if (midiVolume) m_instrdef->SetMidiVolume(midiVolume.text().as_int());
             }
             // create the staffDef(s)
             StaffGrp *partStaffGrp = new StaffGrp();
             partStaffGrp->SetUuid(partId.c_str());
             const int nbStaves
-                = ReadMusicXmlPartAttributesAsStaffDef(partFirstMeasure.node(), partStaffGrp, staffOffset);
+                = ReadMusicXmlPartAttributesAsStaffDef(partFirstMeasure, partStaffGrp, staffOffset);
             // if we have more than one staff in the part we create a new staffGrp
             if (nbStaves > 1) {
                 partStaffGrp->SetBarThru(BOOLEAN_true);
@@ -863,14 +919,12 @@ bool MusicXmlInput::ReadMusicXml(pugi::xml_node root)
                 delete partStaffGrp;
             }
 
-            // find the part and read it
-            xpath = StringFormat("/score-partwise/part[@id='%s']", partId.c_str());
-            pugi::xpath_node part = root.select_node(xpath.c_str());
+            // read the part
             if (!part) {
                 LogWarning("MusicXML import: Could not find the part '%s'", partId.c_str());
                 continue;
             }
-            ReadMusicXmlPart(part.node(), section, nbStaves, staffOffset);
+            ReadMusicXmlPart(part, section, nbStaves, staffOffset);
             // increment the staffOffset for reading the next part
             staffOffset += nbStaves;
         }
@@ -1105,7 +1159,6 @@ int MusicXmlInput::ReadMusicXmlPartAttributesAsStaffDef(pugi::xml_node node, Sta
         // we do not want to read it again, just change the name
         if (IsElement(*it, "attributes")) it->set_name("mei-read");
 
-        std::string xpath;
         // Create as many staffDef
         for (int i = 0; i < nbStaves; ++i) {
             // Find or create the staffDef
@@ -1127,31 +1180,29 @@ int MusicXmlInput::ReadMusicXmlPartAttributesAsStaffDef(pugi::xml_node node, Sta
                 // set initial octave shift
                 m_octDis.push_back(0);
             }
+            const std::string staffNum = std::to_string(i + 1);
 
             // clef sign - first look if we have a clef-sign with the corresponding staff @number
             Clef *clef = NULL;
-            pugi::xpath_node clefSign;
-            xpath = StringFormat("clef[@number='%d']/sign", i + 1);
-            clefSign = it->select_node(xpath.c_str());
+            pugi::xml_node clefSign = it->find_child_by_attribute("clef", "number", staffNum.c_str()).child("sign");
             // if not, look at a common one
             if (!clefSign) {
-                clefSign = it->select_node("clef/sign");
+                clefSign = it->child("clef").child("sign");
             }
-            if (clefSign.node().text()) {
+            if (clefSign.text()) {
                 if (!clef) clef = new Clef();
-                clef->SetShape(clef->AttClefShape::StrToClefshape(GetContent(clefSign.node()).substr(0, 4)));
+                clef->SetShape(clef->AttClefShape::StrToClefshape(GetContent(clefSign).substr(0, 4)));
             }
             // clef line
-            pugi::xpath_node clefLine;
-            xpath = StringFormat("clef[@number='%d']/line", i + 1);
-            clefLine = it->select_node(xpath.c_str());
+            pugi::xml_node clefLine = it->find_child_by_attribute("clef", "number", staffNum.c_str()).child("line");
             if (!clefLine) {
-                clefLine = it->select_node("clef/line[not(@number)]");
+                clefLine = it->child("clef").child("line");
+                if (clefLine.attribute("number")) clefLine = pugi::xml_node();
             }
-            if (clefLine.node().text()) {
+            if (clefLine.text()) {
                 if (!clef) clef = new Clef();
                 if (clef->GetShape() != CLEFSHAPE_perc) {
-                    clef->SetLine(clefLine.node().text().as_int());
+                    clef->SetLine(clefLine.text().as_int());
                 }
             }
             else if (clef) {
@@ -1164,14 +1215,13 @@ int MusicXmlInput::ReadMusicXmlPartAttributesAsStaffDef(pugi::xml_node node, Sta
                 }
             }
             // clef octave change
-            pugi::xpath_node clefOctaveChange;
-            xpath = StringFormat("clef[@number='%d']/clef-octave-change", i + 1);
-            clefOctaveChange = it->select_node(xpath.c_str());
+            pugi::xml_node clefOctaveChange
+                = it->find_child_by_attribute("clef", "number", staffNum.c_str()).child("clef-octave-change");
             if (!clefOctaveChange) {
-                clefOctaveChange = it->select_node("clef/clef-octave-change");
+                clefOctaveChange = it->child("clef").child("clef-octave-change");
             }
-            if (clefOctaveChange.node().text()) {
-                int change = clefOctaveChange.node().text().as_int();
+            if (clefOctaveChange.text()) {
+                int change = clefOctaveChange.text().as_int();
                 if (!clef) clef = new Clef();
                 if (abs(change) == 1)
                     clef->SetDis(OCTAVE_DIS_8);
@@ -1192,15 +1242,14 @@ int MusicXmlInput::ReadMusicXmlPartAttributesAsStaffDef(pugi::xml_node node, Sta
 
             // key sig
             KeySig *keySig = NULL;
-            xpath = StringFormat("key[@number='%d']", i + 1);
-            pugi::xpath_node key = it->select_node(xpath.c_str());
+            pugi::xml_node key = it->find_child_by_attribute("key", "number", staffNum.c_str());
             if (!key) {
-                key = it->select_node("key");
+                key = it->child("key");
             }
             if (key) {
                 if (!keySig) keySig = new KeySig();
-                if (key.node().select_node("fifths")) {
-                    int fifths = atoi(key.node().select_node("fifths").node().text().as_string());
+                if (key.child("fifths")) {
+                    int fifths = atoi(key.child("fifths").text().as_string());
                     std::string keySigStr;
                     if (fifths < 0)
                         keySigStr = StringFormat("%df", abs(fifths));
@@ -1210,8 +1259,8 @@ int MusicXmlInput::ReadMusicXmlPartAttributesAsStaffDef(pugi::xml_node node, Sta
                         keySigStr = "0";
                     keySig->SetSig(keySig->AttKeySigLog::StrToKeysignature(keySigStr));
                 }
-                else if (key.node().child("key-step")) {
-                    for (pugi::xml_node keyStep : key.node().children("key-step")) {
+                else if (key.child("key-step")) {
+                    for (pugi::xml_node keyStep : key.children("key-step")) {
                         KeyAccid *keyAccid = new KeyAccid();
                         keyAccid->SetPname(ConvertStepToPitchName(keyStep.text().as_string()));
                         if (std::strncmp(keyStep.next_sibling().name(), "key-alter", 9) == 0) {
@@ -1226,9 +1275,8 @@ int MusicXmlInput::ReadMusicXmlPartAttributesAsStaffDef(pugi::xml_node node, Sta
                         keySig->AddChild(keyAccid);
                     }
                 }
-                if (key.node().select_node("mode")) {
-                    keySig->SetMode(
-                        keySig->AttKeySigLog::StrToMode(key.node().select_node("mode").node().text().as_string()));
+                if (key.child("mode")) {
+                    keySig->SetMode(keySig->AttKeySigLog::StrToMode(key.child("mode").text().as_string()));
                 }
             }
             // add it if necessary
@@ -1237,39 +1285,35 @@ int MusicXmlInput::ReadMusicXmlPartAttributesAsStaffDef(pugi::xml_node node, Sta
             }
 
             // staff details
-            pugi::xpath_node staffDetails;
-            xpath = StringFormat("staff-details[@number='%d']", i + 1);
-            staffDetails = it->select_node(xpath.c_str());
+            pugi::xml_node staffDetails = it->find_child_by_attribute("staff-details", "number", staffNum.c_str());
             if (!staffDetails) {
-                staffDetails = it->select_node("staff-details");
+                staffDetails = it->child("staff-details");
             }
-            int staffLines = staffDetails.node().select_node("staff-lines").node().text().as_int();
+            int staffLines = staffDetails.child("staff-lines").text().as_int();
             if (staffLines) {
                 staffDef->SetLines(staffLines);
             }
             else if (!staffDef->HasLines()) {
                 staffDef->SetLines(5);
             }
-            std::string scaleStr = staffDetails.node().select_node("staff-size").node().text().as_string();
+            std::string scaleStr = staffDetails.child("staff-size").text().as_string();
             if (!scaleStr.empty()) {
                 staffDef->SetScale(staffDef->AttScalable::StrToPercent(scaleStr + "%"));
             }
-            pugi::xpath_node staffTuning = staffDetails.node().select_node("staff-tuning");
+            pugi::xml_node staffTuning = staffDetails.child("staff-tuning");
             if (staffTuning) {
                 staffDef->SetNotationtype(NOTATIONTYPE_tab);
             }
 
             // time
             MeterSig *meterSig = NULL;
-            pugi::xpath_node time;
-            xpath = StringFormat("time[@number='%d']", i + 1);
-            time = it->select_node(xpath.c_str());
+            pugi::xml_node time = it->find_child_by_attribute("time", "number", staffNum.c_str());
             if (!time) {
-                time = it->select_node("time");
+                time = it->child("time");
             }
             if (time) {
                 if (!meterSig) meterSig = new MeterSig();
-                std::string symbol = time.node().attribute("symbol").as_string();
+                std::string symbol = time.attribute("symbol").as_string();
                 if (!symbol.empty()) {
                     if (symbol == "cut" || symbol == "common")
                         meterSig->SetSym(meterSig->AttMeterSigVis::StrToMetersign(symbol.c_str()));
@@ -1278,27 +1322,27 @@ int MusicXmlInput::ReadMusicXmlPartAttributesAsStaffDef(pugi::xml_node node, Sta
                     else
                         meterSig->SetForm(METERFORM_norm);
                 }
-                if (time.node().select_node("senza-misura")) {
+                if (time.child("senza-misura")) {
                     meterSig->SetForm(METERFORM_invis);
                 }
-                if (time.node().select_nodes("beats").size() > 1) {
+                pugi::xml_node beats = time.child("beats");
+                if (beats.next_sibling("beats")) {
                     LogWarning("MusicXML import: Compound meter signatures are not supported");
                 }
-                pugi::xpath_node beats = time.node().select_node("beats");
-                if (beats.node().text()) {
-                    m_meterCount = beats.node().text().as_int();
+                if (beats.text()) {
+                    m_meterCount = beats.text().as_int();
                     // staffDef->AttMeterSigDefaultLog::StrToInt(beats.node().text().as_string());
                     // this is a little "hack", until libMEI is fixed
-                    std::string compound = beats.node().text().as_string();
+                    std::string compound = beats.text().as_string();
                     if (compound.find("+") != std::string::npos) {
                         m_meterCount += atoi(compound.substr(compound.find("+")).c_str());
                         LogWarning("MusicXML import: Compound time is not supported");
                     }
                     meterSig->SetCount(m_meterCount);
                 }
-                pugi::xpath_node beatType = time.node().select_node("beat-type");
-                if (beatType.node().text()) {
-                    m_meterUnit = beatType.node().text().as_int();
+                pugi::xml_node beatType = time.child("beat-type");
+                if (beatType.text()) {
+                    m_meterUnit = beatType.text().as_int();
                     meterSig->SetUnit(m_meterUnit);
                 }
             }
@@ -1309,24 +1353,22 @@ int MusicXmlInput::ReadMusicXmlPartAttributesAsStaffDef(pugi::xml_node node, Sta
             }
 
             // transpose
-            pugi::xpath_node transpose;
-            xpath = StringFormat("transpose[@number='%d']", i + 1);
-            transpose = it->select_node(xpath.c_str());
+            pugi::xml_node transpose = it->find_child_by_attribute("transpose", "number", staffNum.c_str());
             if (!transpose) {
-                transpose = it->select_node("transpose");
+                transpose = it->child("transpose");
             }
             if (transpose) {
-                staffDef->SetTransDiat(atoi(GetContentOfChild(transpose.node(), "diatonic").c_str()));
-                staffDef->SetTransSemi(atoi(GetContentOfChild(transpose.node(), "chromatic").c_str()));
+                staffDef->SetTransDiat(atoi(GetContentOfChild(transpose, "diatonic").c_str()));
+                staffDef->SetTransSemi(atoi(GetContentOfChild(transpose, "chromatic").c_str()));
             }
             // ppq
-            pugi::xpath_node divisions = it->select_node("divisions");
+            pugi::xml_node divisions = it->child("divisions");
             if (divisions) {
-                m_ppq = divisions.node().text().as_int();
+                m_ppq = divisions.text().as_int();
                 staffDef->SetPpq(m_ppq);
             }
             // measure style
-            pugi::xpath_node measureSlash = it->select_node("measure-style/slash");
+            pugi::xpath_node measureSlash = m_xpathMeasureSlash.evaluate_node(*it);
             if (measureSlash) {
                 if (HasAttributeWithValue(measureSlash.node(), "type", "start"))
                     m_slash = true;
@@ -1344,19 +1386,17 @@ bool MusicXmlInput::ReadMusicXmlPart(pugi::xml_node node, Section *section, int
     assert(node);
     assert(section);
 
-    pugi::xpath_node_set measures = node.select_nodes("measure");
-    if (measures.size() == 0) {
+    if (!node.child("measure")) {
         LogWarning("MusicXML import: No measure to load");
         return false;
     }
 
     int i = 0;
-    for (pugi::xpath_node_set::const_iterator it = measures.begin(); it != measures.end(); ++it) {
-        pugi::xpath_node xmlMeasure = *it;
+    for (pugi::xml_node xmlMeasure : node.children("measure")) {
         if (!IsMultirestMeasure(i)) {
             Measure *measure = new Measure();
             m_measureCounts[measure] = i;
-            ReadMusicXmlMeasure(xmlMeasure.node(), section, measure, nbStaves, staffOffset, i);
+            ReadMusicXmlMeasure(xmlMeasure, section, measure, nbStaves, staffOffset, i);
             // Add the measure to the system - if already there from a previous part we'll just merge the content
             AddMeasure(section, measure, i);
         }
@@ -1370,7 +1410,7 @@ bool MusicXmlInput::ReadMusicXmlPart(pugi::xml_node node, Section *section, int
                     [lastElementIter](
                         const std::pair<Measure *, int> &elem) { return lastElementIter->first == elem.second; });
                 if (measureIter != m_measureCounts.end()) {
-                    for (auto it = xmlMeasure.node().begin(); it != xmlMeasure.node().end(); ++it) {
+                    for (auto it = xmlMeasure.begin(); it != xmlMeasure.end(); ++it) {
                         if (IsElement(*it, "barline")) {
                             ReadMusicXmlBarLine(*it, measureIter->first, std::to_string(lastElementIter->first));
                         }
@@ -1437,10 +1477,11 @@ bool MusicXmlInput::ReadMusicXmlMeasure(
     // read the content of the measure
     for (pugi::xml_node::iterator it = node.begin(); it != node.end(); ++it) {
         // first check if there is a multi measure rest
-        if (it->select_node(".//multiple-rest")) {
-            const int multiRestLength = it->select_node(".//multiple-rest").node().text().as_int();
+        pugi::xml_node multipleRest = m_xpathMultipleRest.evaluate_node(*it).node();
+        if (multipleRest) {
+            const int multiRestLength = multipleRest.text().as_int();
             MultiRest *multiRest = new MultiRest;
-            if (it->select_node(".//multiple-rest[@use-symbols='yes']")) multiRest->SetBlock(BOOLEAN_false);
+            if (HasAttributeWithValue(multipleRest, "use-symbols", "yes")) multiRest->SetBlock(BOOLEAN_false);
             multiRest->SetNum(multiRestLength);
             Layer *layer = SelectLayer(1, measure);
             AddLayerElement(layer, multiRest);
@@ -1481,7 +1522,7 @@ bool MusicXmlInput::ReadMusicXmlMeasure(
             ReadMusicXmlNote(*it, measure, measureNum, staffOffset, section);
         }
         // for now only check first part
-        else if (IsElement(*it, "print") && node.select_node("parent::part[not(preceding-sibling::part)]")) {
+        else if (IsElement(*it, "print") && m_xpathFirstPartParent.evaluate_node(node)) {
             ReadMusicXmlPrint(*it, section);
         }
     }
@@ -1569,23 +1610,23 @@ void MusicXmlInput::ReadMusicXmlAttributes(
     assert(measure);
 
     // read clef changes as MEI clef and add them to the stack
-    pugi::xpath_node clef = node.select_node("clef");
+    pugi::xml_node clef = node.child("clef");
     if (clef) {
         // check if we have a staff number
-        int staffNum = clef.node().attribute("number").as_int();
+        int staffNum = clef.attribute("number").as_int();
         staffNum = (staffNum < 1) ? 1 : staffNum;
         Staff *staff = dynamic_cast<Staff *>(measure->GetChild(staffNum - 1, STAFF));
         assert(staff);
-        pugi::xpath_node clefSign = clef.node().select_node("sign");
-        pugi::xpath_node clefLine = clef.node().select_node("line");
+        pugi::xml_node clefSign = clef.child("sign");
+        pugi::xml_node clefLine = clef.child("line");
         if (clefSign && clefLine) {
             Clef *meiClef = new Clef();
-            meiClef->SetShape(meiClef->AttClefShape::StrToClefshape(GetContent(clefSign.node()).substr(0, 4)));
-            meiClef->SetLine(meiClef->AttClefShape::StrToInt(clefLine.node().text().as_string()));
+            meiClef->SetShape(meiClef->AttClefShape::StrToClefshape(GetContent(clefSign).substr(0, 4)));
+            meiClef->SetLine(meiClef->AttClefShape::StrToInt(clefLine.text().as_string()));
             // clef octave change
-            pugi::xpath_node clefOctaveChange = clef.node().select_node("clef-octave-change");
-            if (clefOctaveChange.node().text()) {
-                const int change = clefOctaveChange.node().text().as_int();
+            pugi::xml_node clefOctaveChange = clef.child("clef-octave-change");
+            if (clefOctaveChange.text()) {
+                const int change = clefOctaveChange.text().as_int();
                 if (abs(change) == 1)
                     meiClef->SetDis(OCTAVE_DIS_8);
                 else if (abs(change) == 2)
@@ -1597,22 +1638,21 @@ void MusicXmlInput::ReadMusicXmlAttributes(
                 else
                     meiClef->SetDisPlace(STAFFREL_basic_above);
             }
-            const bool afterBarline = clef.node().attribute("after-barline").as_bool();
+            const bool afterBarline = clef.attribute("after-barline").as_bool();
             m_ClefChangeStack.push_back(musicxml::ClefChange(measureNum, staff, meiClef, m_durTotal, afterBarline));
         }
     }
 
     // key and time change
-    pugi::xpath_node key = node.select_node("key");
-    pugi::xpath_node time = node.select_node("time");
+    pugi::xml_node key = node.child("key");
+    pugi::xml_node time = node.child("time");
     // for now only read first key change in first part and update scoreDef
-    if ((key || time) && node.select_node("ancestor::part[not(preceding-sibling::part)]")
-        && !node.select_node("preceding-sibling::attributes/key")) {
+    if ((key || time) && m_xpathFirstPartAncestor.evaluate_node(node) && !m_xpathPrecedingKey.evaluate_node(node)) {
         ScoreDef *scoreDef = new ScoreDef();
         KeySig *keySig = NULL;
-        if (key.node().select_node("fifths")) {
+        if (key.child("fifths")) {
             if (!keySig) keySig = new KeySig();
-            const int fifths = key.node().select_node("fifths").node().text().as_int();
+            const int fifths = key.child("fifths").text().as_int();
             std::string keySigStr;
             if (fifths < 0)
                 keySigStr = StringFormat("%df", abs(fifths));
@@ -1622,9 +1662,9 @@ void MusicXmlInput::ReadMusicXmlAttributes(
                 keySigStr = "0";
             keySig->SetSig(keySig->AttKeySigLog::StrToKeysignature(keySigStr));
         }
-        else if (key.node().child("key-step")) {
+        else if (key.child("key-step")) {
             if (!keySig) keySig = new KeySig();
-            for (pugi::xml_node keyStep = key.node().child("key-step"); keyStep;
+            for (pugi::xml_node keyStep = key.child("key-step"); keyStep;
                  keyStep = keyStep.next_sibling("key-step")) {
                 KeyAccid *keyAccid = new KeyAccid();
                 keyAccid->SetPname(ConvertStepToPitchName(keyStep.text().as_string()));
@@ -1640,17 +1680,17 @@ void MusicXmlInput::ReadMusicXmlAttributes(
                 keySig->AddChild(keyAccid);
             }
         }
-        if (key.node().select_node("mode")) {
+        if (key.child("mode")) {
             if (!keySig) keySig = new KeySig();
-            keySig->SetMode(keySig->AttKeySigLog::StrToMode(key.node().select_node("mode").node().text().as_string()));
+            keySig->SetMode(keySig->AttKeySigLog::StrToMode(key.child("mode").text().as_string()));
         }
-        if (key.node().select_node("cancel")) {
+        if (key.child("cancel")) {
             if (!keySig) keySig = new KeySig();
             keySig->SetSigShowchange(BOOLEAN_true);
         }
-        if (key.node().attribute("id")) {
+        if (key.attribute("id")) {
             if (!keySig) keySig = new KeySig();
-            keySig->SetUuid(key.node().attribute("id").as_string());
+            keySig->SetUuid(key.attribute("id").as_string());
         }
         // Add it if necessary
         if (keySig) {
@@ -1660,7 +1700,7 @@ void MusicXmlInput::ReadMusicXmlAttributes(
 
         if (time) {
             MeterSig *meterSig = NULL;
-            std::string symbol = time.node().attribute("symbol").as_string();
+            std::string symbol = time.attribute("symbol").as_string();
             if (!symbol.empty()) {
                 if (!meterSig) meterSig = new MeterSig();
                 if (symbol == "cut" || symbol == "common")
@@ -1670,26 +1710,26 @@ void MusicXmlInput::ReadMusicXmlAttributes(
                 else
                     meterSig->SetForm(METERFORM_norm);
             }
-            if (time.node().select_nodes("beats").size() > 1) {
+            pugi::xml_node beats = time.child("beats");
+            if (beats.next_sibling("beats")) {
                 LogWarning("MusicXML import: Compound meter signatures are not supported");
             }
-            pugi::xpath_node beats = time.node().select_node("beats");
-            if (beats.node().text()) {
+            if (beats.text()) {
                 if (!meterSig) meterSig = new MeterSig();
-                m_meterCount = beats.node().text().as_int();
+                m_meterCount = beats.text().as_int();
                 // staffDef->AttMeterSigDefaultLog::StrToInt(beats.node().text().as_string());
                 // this is a little "hack", until libMEI is fixed
-                std::string compound = beats.node().text().as_string();
+                std::string compound = beats.text().as_string();
                 if (compound.find("+") != std::string::npos) {
                     m_meterCount += atoi(compound.substr(compound.find("+")).c_str());
                     LogWarning("MusicXML import: Compound time is not supported");
                 }
                 meterSig->SetCount(m_meterCount);
             }
-            pugi::xpath_node beatType = time.node().select_node("beat-type");
-            if (beatType.node().text()) {
+            pugi::xml_node beatType = time.child("beat-type");
+            if (beatType.text()) {
                 if (!meterSig) meterSig = new MeterSig();
-                m_meterUnit = beatType.node().text().as_int();
+                m_meterUnit = beatType.text().as_int();
                 meterSig->SetUnit(m_meterUnit);
             }
             // add it if necessary
@@ -1703,8 +1743,8 @@ void MusicXmlInput::ReadMusicXmlAttributes(
         section->AddChild(scoreDef);
     }
 
-    pugi::xpath_node measureRepeat = node.select_node("measure-style/measure-repeat");
-    pugi::xpath_node measureSlash = node.select_node("measure-style/slash");
+    pugi::xpath_node measureRepeat = m_xpathMeasureRepeat.evaluate_node(node);
+    pugi::xpath_node measureSlash = m_xpathMeasureSlash.evaluate_node(node);
     if (measureRepeat) {
         if (HasAttributeWithValue(measureRepeat.node(), "type", "start"))
             m_mRpt = true;
@@ -1738,7 +1778,7 @@ void MusicXmlInput::ReadMusicXmlBarLine(pugi::xml_node node, Measure *measure, c
     assert(staff);
 
     std::string barStyle = GetContentOfChild(node, "bar-style");
-    pugi::xpath_node repeat = node.select_node("repeat");
+    pugi::xml_node repeat = node.child("repeat");
     if (!barStyle.empty()) {
         data_BARRENDITION barRendition = ConvertStyleToRend(barStyle, repeat);
         if (HasAttributeWithValue(node, "location", "left")) {
@@ -1772,11 +1812,11 @@ void MusicXmlInput::ReadMusicXmlBarLine(pugi::xml_node node, Measure *measure, c
     }
 
     // parse endings (prima volta, seconda volta...)
-    pugi::xpath_node ending = node.select_node("ending");
+    pugi::xml_node ending = node.child("ending");
     if (ending) {
-        std::string endingNumber = ending.node().attribute("number").as_string();
-        std::string endingType = ending.node().attribute("type").as_string();
-        std::string endingText = ending.node().text().as_string();
+        std::string endingNumber = ending.attribute("number").as_string();
+        std::string endingType = ending.attribute("type").as_string();
+        std::string endingText = ending.text().as_string();
         // LogMessage("ending number/type/text: %s/%s/%s.", endingNumber.c_str(), endingType.c_str(),
         // endingText.c_str());
         if (endingType == "start") {
@@ -1831,24 +1871,24 @@ void MusicXmlInput::ReadMusicXmlDirection(
     assert(node);
     assert(measure);
 
-    const pugi::xpath_node staffNode = node.select_node("staff");
+    const pugi::xml_node staffNode = node.child("staff");
 
     const std::string directionId = node.attribute("id").as_string();
     const std::string placeStr = node.attribute("placement").as_string();
-    const int offset = node.select_node("offset").node().text().as_int();
+    const int offset = node.child("offset").text().as_int();
     const double timeStamp = (double)(m_durTotal + offset) * (double)m_meterUnit / (double)(4 * m_ppq) + 1.0;
 
-    const pugi::xpath_node voice = node.select_node("voice");
+    const pugi::xml_node voice = node.child("voice");
     if (voice) m_prevLayer = SelectLayer(node, measure);
 
-    const pugi::xml_node type = node.select_node("direction-type").node();
+    const pugi::xml_node type = node.child("direction-type");
 
     // Bracket
-    pugi::xpath_node bracket = type.select_node("bracket");
+    pugi::xml_node bracket = type.child("bracket");
     if (bracket) {
-        int voiceNumber = bracket.node().attribute("number").as_int();
+        int voiceNumber = bracket.attribute("number").as_int();
         voiceNumber = (voiceNumber < 1) ? 1 : voiceNumber;
-        if (HasAttributeWithValue(bracket.node(), "type", "stop")) {
+        if (HasAttributeWithValue(bracket, "type", "stop")) {
             if (m_bracketStack.empty()) {
                 // if this is empty, most likely we're dealing with an extender
             }
@@ -1856,7 +1896,7 @@ void MusicXmlInput::ReadMusicXmlDirection(
                 const int measureDifference
                     = m_measureCounts.at(measure) - m_bracketStack.front().second.m_lastMeasureCount;
                 m_bracketStack.front().first->SetLendsym(
-                    ConvertLineEndSymbol(bracket.node().attribute("line-end").as_string()));
+                    ConvertLineEndSymbol(bracket.attribute("line-end").as_string()));
                 if (measureDifference >= 0) {
                     m_bracketStack.front().first->SetTstamp2(std::pair<int, double>(measureDifference, timeStamp));
                 }
@@ -1866,12 +1906,12 @@ void MusicXmlInput::ReadMusicXmlDirection(
         else {
             BracketSpan *bracketSpan = new BracketSpan();
             musicxml::OpenSpanner openBracket(voiceNumber, m_measureCounts.at(measure));
-            bracketSpan->SetColor(bracket.node().attribute("color").as_string());
+            bracketSpan->SetColor(bracket.attribute("color").as_string());
             bracketSpan->SetLform(
-                bracketSpan->AttLineRendBase::StrToLineform(bracket.node().attribute("line-type").as_string()));
+                bracketSpan->AttLineRendBase::StrToLineform(bracket.attribute("line-type").as_string()));
             // bracketSpan->SetPlace(bracketSpan->AttPlacement::StrToStaffrel(placeStr.c_str()));
             bracketSpan->SetFunc("unclear");
-            bracketSpan->SetLstartsym(ConvertLineEndSymbol(bracket.node().attribute("line-end").as_string()));
+            bracketSpan->SetLstartsym(ConvertLineEndSymbol(bracket.attribute("line-end").as_string()));
             bracketSpan->SetTstamp(timeStamp);
             m_controlElements.push_back(std::make_pair(measureNum, bracketSpan));
             m_bracketStack.push_back(std::make_pair(bracketSpan, openBracket));
@@ -1879,14 +1919,14 @@ void MusicXmlInput::ReadMusicXmlDirection(
     }
 
     // Coda
-    pugi::xpath_node coda = type.select_node("coda");
+    pugi::xml_node coda = type.child("coda");
     if (coda) {
         Dir *dir = new Dir();
         dir->SetPlace(dir->AttPlacement::StrToStaffrel(placeStr.c_str()));
         dir->SetTstamp(timeStamp - 1.0);
         dir->SetType("coda");
         dir->SetStaff(dir->AttStaffIdent::StrToXsdPositiveIntegerList("1"));
-        if (coda.node().attribute("id")) dir->SetUuid(coda.node().attribute("id").as_string());
+        if (coda.attribute("id")) dir->SetUuid(coda.attribute("id").as_string());
         Rend *rend = new Rend;
         rend->SetFontname("VerovioText");
         rend->SetFontstyle(FONTSTYLE_normal);
@@ -1900,13 +1940,12 @@ void MusicXmlInput::ReadMusicXmlDirection(
     }
 
     // Dashes (to be connected with previous <dir> or <dynam> as @extender and @tstamp2 attribute
-    pugi::xpath_node dashes = type.select_node("bracket|dashes");
+    pugi::xpath_node dashes = m_xpathBracketOrDashes.evaluate_node(type);
     if (dashes) {
         int dashesNumber = dashes.node().attribute("number").as_int();
         dashesNumber = (dashesNumber < 1) ? 1 : dashesNumber;
         int staffNum = 1;
-        pugi::xpath_node staffNode = node.select_node("staff");
-        if (staffNode) staffNum = staffNode.node().text().as_int() + staffOffset;
+        if (staffNode) staffNum = staffNode.text().as_int() + staffOffset;
         if (HasAttributeWithValue(dashes.node(), "type", "stop")) {
             std::vector<std::pair<ControlElement *, musicxml::OpenDashes> >::iterator iter = m_openDashesStack.begin();
             while (iter != m_openDashesStack.end()) {
@@ -1967,14 +2006,14 @@ void MusicXmlInput::ReadMusicXmlDirection(
         }
     }
 
-    pugi::xpath_node_set words = node.select_nodes("direction-type/words");
+    pugi::xpath_node_set words = m_xpathWords.evaluate_node_set(node);
     const bool containsWords = !words.empty();
-    bool containsDynamics = !node.select_node("direction-type/dynamics").node().empty();
+    bool containsDynamics = !m_xpathDynamics.evaluate_node(node).node().empty();
+    const bool hasSoundTempo = m_xpathSoundTempo.evaluate_node(node);
 
     // Directive
     int defaultY = 0; // y position attribute, only for directives and dynamics
-    if (containsWords && !containsDynamics && !node.select_node("sound[@tempo]")) {
-        pugi::xpath_node_set words = node.select_nodes("direction-type/words");
+    if (containsWords && !containsDynamics && !hasSoundTempo) {
         defaultY = words.first().node().attribute("default-y").as_int();
         std::string wordStr = words.first().node().text().as_string();
         if (wordStr.rfind("cresc", 0) == 0 || wordStr.rfind("dim", 0) == 0 || wordStr.rfind("decresc", 0) == 0) {
@@ -1988,10 +2027,9 @@ void MusicXmlInput::ReadMusicXmlDirection(
             dir->SetPlace(dir->AttPlacement::StrToStaffrel(placeStr.c_str()));
             dir->SetTstamp(timeStamp);
             dir->SetType(node.child("sound").first_attribute().name());
-            pugi::xpath_node staffNode = node.select_node("staff");
             if (staffNode) {
                 dir->SetStaff(dir->AttStaffIdent::StrToXsdPositiveIntegerList(
-                    std::to_string(staffNode.node().text().as_int() + staffOffset)));
+                    std::to_string(staffNode.text().as_int() + staffOffset)));
             }
             else if (m_prevLayer) {
                 dir->SetStaff(dir->AttStaffIdent::StrToXsdPositiveIntegerList(
@@ -2008,7 +2046,7 @@ void MusicXmlInput::ReadMusicXmlDirection(
             if (!strcmp(extender.node().name(), "bracket") || !strcmp(extender.node().name(), "dashes")) {
                 int extNumber = extender.node().attribute("number").as_int();
                 extNumber = (extNumber < 1) ? 1 : extNumber;
-                int staffNum = staffNode.node().text().as_int() + staffOffset;
+                int staffNum = staffNode.text().as_int() + staffOffset;
                 staffNum = (staffNum < 1) ? 1 : staffNum;
                 dir->SetExtender(BOOLEAN_true);
                 if (std::strncmp(extender.node().name(), "bracket", 7) == 0) {
@@ -2026,8 +2064,8 @@ void MusicXmlInput::ReadMusicXmlDirection(
 
     // Dynamics
     if (containsDynamics) {
-        pugi::xpath_node_set dynamics = node.select_nodes(
-            containsWords ? "direction-type/dynamics|direction-type/words" : "direction-type/dynamics");
+        pugi::xpath_node_set dynamics = containsWords ? m_xpathDynamicsAndWords.evaluate_node_set(node)
+                                                      : m_xpathDynamics.evaluate_node_set(node);
 
         dynamics.sort();
 
@@ -2036,15 +2074,15 @@ void MusicXmlInput::ReadMusicXmlDirection(
         dynam->SetTstamp(timeStamp);
         if (staffNode) {
             dynam->SetStaff(dynam->AttStaffIdent::StrToXsdPositiveIntegerList(
-                std::to_string(staffNode.node().text().as_int() + staffOffset)));
+                std::to_string(staffNode.text().as_int() + staffOffset)));
         }
         else if (m_prevLayer) {
             dynam->SetStaff(dynam->AttStaffIdent::StrToXsdPositiveIntegerList(
                 std::to_string(dynamic_cast<Staff *>(m_prevLayer->GetParent())->GetN())));
         }
 
-        if (node.select_node("sound")) {
-            const float dynamics = node.select_node("sound").node().attribute("dynamics").as_float(-1.0);
+        if (node.child("sound")) {
+            const float dynamics = node.child("sound").attribute("dynamics").as_float(-1.0);
             if (dynamics >= 0.0) {
                 dynam->SetVal(ConvertDynamicsToMidiVal(dynamics));
             }
@@ -2062,7 +2100,7 @@ void MusicXmlInput::ReadMusicXmlDirection(
         if (!strcmp(extender.node().name(), "bracket") || !strcmp(extender.node().name(), "dashes")) {
             int extNumber = extender.node().attribute("number").as_int();
             extNumber = (extNumber < 1) ? 1 : extNumber;
-            int staffNum = staffNode.node().text().as_int() + staffOffset;
+            int staffNum = staffNode.text().as_int() + staffOffset;
             staffNum = (staffNum < 1) ? 1 : staffNum;
             dynam->SetExtender(BOOLEAN_true);
             if (std::strncmp(extender.node().name(), "bracket", 7) == 0) {
@@ -2078,7 +2116,7 @@ void MusicXmlInput::ReadMusicXmlDirection(
     }
 
     // Hairpins
-    pugi::xpath_node_set wedges = node.select_nodes("direction-type/wedge");
+    pugi::xpath_node_set wedges = m_xpathWedges.evaluate_node_set(node);
     for (pugi::xpath_node_set::const_iterator wedge = wedges.begin(); wedge != wedges.end(); ++wedge) {
         int hairpinNumber = wedge->node().attribute("number").as_int();
         hairpinNumber = (hairpinNumber < 1) ? 1 : hairpinNumber;
@@ -2123,7 +2161,7 @@ void MusicXmlInput::ReadMusicXmlDirection(
             hairpin->SetPlace(hairpin->AttPlacement::StrToStaffrel(placeStr.c_str()));
             hairpin->SetTstamp(timeStamp);
             if (wedge->node().attribute("id")) hairpin->SetUuid(wedge->node().attribute("id").as_string());
-            int staffNum = node.select_node("staff").node().text().as_int();
+            int staffNum = staffNode.text().as_int();
             staffNum = (!staffNum && m_prevLayer) ? dynamic_cast<Staff *>(m_prevLayer->GetParent())->GetN() : staffNum;
             if (staffNum != 0) {
                 hairpin->SetStaff(
@@ -2153,11 +2191,10 @@ void MusicXmlInput::ReadMusicXmlDirection(
     }
 
     // Ottava
-    pugi::xpath_node xmlShift = type.select_node("octave-shift");
+    pugi::xml_node xmlShift = type.child("octave-shift");
     if (xmlShift) {
-        pugi::xpath_node staffNode = node.select_node("staff");
-        const int staffN = (!staffNode) ? 1 : staffNode.node().text().as_int() + staffOffset;
-        if (HasAttributeWithValue(xmlShift.node(), "type", "stop")) {
+        const int staffN = (!staffNode) ? 1 : staffNode.text().as_int() + staffOffset;
+        if (HasAttributeWithValue(xmlShift, "type", "stop")) {
             m_octDis[staffN] = 0;
             std::vector<std::pair<std::string, ControlElement *> >::iterator iter;
             for (iter = m_controlElements.begin(); iter != m_controlElements.end(); ++iter) {
@@ -2168,7 +2205,7 @@ void MusicXmlInput::ReadMusicXmlDirection(
                     if (std::find(staffAttr.begin(), staffAttr.end(), staffN) != staffAttr.end()) {
                         octave->SetEndid(m_ID);
                     }
-                    else if (xmlShift.node().attribute("number").as_string() == octave->GetN()) {
+                    else if (xmlShift.attribute("number").as_string() == octave->GetN()) {
                         octave->SetEndid(m_ID);
                     }
                     else {
@@ -2179,13 +2216,13 @@ void MusicXmlInput::ReadMusicXmlDirection(
         }
         else {
             Octave *octave = new Octave();
-            octave->SetColor(xmlShift.node().attribute("color").as_string());
+            octave->SetColor(xmlShift.attribute("color").as_string());
             octave->SetDisPlace(octave->AttOctaveDisplacement::StrToStaffrelBasic(placeStr.c_str()));
-            octave->SetN(xmlShift.node().attribute("number").as_string());
-            const int octDisNum = xmlShift.node().attribute("size") ? xmlShift.node().attribute("size").as_int() : 8;
+            octave->SetN(xmlShift.attribute("number").as_string());
+            const int octDisNum = xmlShift.attribute("size") ? xmlShift.attribute("size").as_int() : 8;
             octave->SetDis(octave->AttOctaveDisplacement::StrToOctaveDis(std::to_string(octDisNum)));
             m_octDis[staffN] = (octDisNum + 2) / 8;
-            if (HasAttributeWithValue(xmlShift.node(), "type", "up")) {
+            if (HasAttributeWithValue(xmlShift, "type", "up")) {
                 octave->SetDisPlace(STAFFREL_basic_below);
                 m_octDis[staffN] *= -1;
             }
@@ -2197,32 +2234,31 @@ void MusicXmlInput::ReadMusicXmlDirection(
     }
 
     // Pedal
-    pugi::xpath_node xmlPedal = type.select_node("pedal");
+    pugi::xml_node xmlPedal = type.child("pedal");
     if (xmlPedal) {
-        std::string pedalType = xmlPedal.node().attribute("type").as_string();
-        bool pedalLine = xmlPedal.node().attribute("line").as_bool();
+        std::string pedalType = xmlPedal.attribute("type").as_string();
+        bool pedalLine = xmlPedal.attribute("line").as_bool();
         if (pedalType != "continue") {
             Pedal *pedal = new Pedal();
-            pedal->SetColor(xmlPedal.node().attribute("color").as_string());
-            // pedal->SetN(xmlPedal.node().attribute("number").as_string());
+            pedal->SetColor(xmlPedal.attribute("color").as_string());
+            // pedal->SetN(xmlPedal.attribute("number").as_string());
             if (!placeStr.empty()) pedal->SetPlace(pedal->AttPlacement::StrToStaffrel(placeStr.c_str()));
             pedal->SetDir(ConvertPedalTypeToDir(pedalType));
             if (pedalLine) pedal->SetForm(pedalVis_FORM_line);
-            if (xmlPedal.node().attribute("abbreviated")) {
+            if (xmlPedal.attribute("abbreviated")) {
                 pedal->SetExternalsymbols(pedal, "glyph.auth", "smufl");
                 pedal->SetExternalsymbols(pedal, "glyph.num", "U+E651");
             }
             if (pedalType == "sostenuto") {
                 pedal->SetFunc("sostenuto");
-                if (xmlPedal.node().attribute("abbreviated")) {
+                if (xmlPedal.attribute("abbreviated")) {
                     pedal->SetExternalsymbols(pedal, "glyph.auth", "smufl");
                     pedal->SetExternalsymbols(pedal, "glyph.num", "U+E65A");
                 }
             }
-            pugi::xpath_node staffNode = node.select_node("staff");
             if (staffNode) {
                 pedal->SetStaff(pedal->AttStaffIdent::StrToXsdPositiveIntegerList(
-                    std::to_string(staffNode.node().text().as_int() + staffOffset)));
+                    std::to_string(staffNode.text().as_int() + staffOffset)));
             }
             else if (m_prevLayer) {
                 pedal->SetStaff(pedal->AttStaffIdent::StrToXsdPositiveIntegerList(
@@ -2230,7 +2266,7 @@ void MusicXmlInput::ReadMusicXmlDirection(
             }
             pedal->SetTstamp(timeStamp);
             if (pedalType == "stop") pedal->SetTstamp(timeStamp - 0.1);
-            int defaultY = xmlPedal.node().attribute("default-y").as_int();
+            int defaultY = xmlPedal.attribute("default-y").as_int();
             // parse the default_y attribute and transform to vgrp value, to vertically align pedal starts and stops
             defaultY = (defaultY < 0) ? std::abs(defaultY) : defaultY + 200;
             pedal->SetVgrp(defaultY);
@@ -2240,11 +2276,11 @@ void MusicXmlInput::ReadMusicXmlDirection(
     }
 
     // Principal voice
-    pugi::xpath_node lead = type.select_node("principal-voice");
+    pugi::xml_node lead = type.child("principal-voice");
     if (lead) {
-        int voiceNumber = lead.node().attribute("number").as_int();
+        int voiceNumber = lead.attribute("number").as_int();
         voiceNumber = (voiceNumber < 1) ? 1 : voiceNumber;
-        if (HasAttributeWithValue(lead.node(), "type", "stop")) {
+        if (HasAttributeWithValue(lead, "type", "stop")) {
             const int measureDifference
                 = m_measureCounts.at(measure) - m_bracketStack.front().second.m_lastMeasureCount;
             if (measureDifference >= 0) {
@@ -2253,13 +2289,13 @@ void MusicXmlInput::ReadMusicXmlDirection(
             m_bracketStack.erase(m_bracketStack.begin());
         }
         else {
-            // std::string symbol = lead.node().attribute("symbol").as_string();
+            // std::string symbol = lead.attribute("symbol").as_string();
             BracketSpan *bracketSpan = new BracketSpan();
             musicxml::OpenSpanner openBracket(voiceNumber, m_measureCounts.at(measure));
-            bracketSpan->SetColor(lead.node().attribute("color").as_string());
+            bracketSpan->SetColor(lead.attribute("color").as_string());
             // bracketSpan->SetPlace(bracketSpan->AttPlacement::StrToStaffrel(placeStr.c_str()));
             bracketSpan->SetFunc("analytical");
-            bracketSpan->SetLstartsym(ConvertLineEndSymbol(lead.node().attribute("symbol").as_string()));
+            bracketSpan->SetLstartsym(ConvertLineEndSymbol(lead.attribute("symbol").as_string()));
             bracketSpan->SetTstamp(timeStamp);
             bracketSpan->SetType("principal-voice");
             m_controlElements.push_back(std::make_pair(measureNum, bracketSpan));
@@ -2268,26 +2304,25 @@ void MusicXmlInput::ReadMusicXmlDirection(
     }
 
     // Rehearsal
-    pugi::xpath_node rehearsal = type.select_node("rehearsal");
+    pugi::xml_node rehearsal = type.child("rehearsal");
     if (rehearsal) {
         Reh *reh = new Reh();
         reh->SetPlace(reh->AttPlacement::StrToStaffrel(placeStr.c_str()));
-        std::string halign = rehearsal.node().attribute("halign").as_string();
-        std::string lang = rehearsal.node().attribute("xml:lang").as_string();
+        std::string halign = rehearsal.attribute("halign").as_string();
+        std::string lang = rehearsal.attribute("xml:lang").as_string();
         if (lang.empty()) lang = "it";
-        std::string textStr = GetContent(rehearsal.node());
-        reh->SetColor(rehearsal.node().attribute("color").as_string());
+        std::string textStr = GetContent(rehearsal);
+        reh->SetColor(rehearsal.attribute("color").as_string());
         reh->SetTstamp(timeStamp);
-        pugi::xpath_node staffNode = node.select_node("staff");
-        int staffNum = staffNode.node().text().as_int() + staffOffset;
+        int staffNum = staffNode.text().as_int() + staffOffset;
         staffNum = (staffNum < 1) ? 1 : staffNum;
         reh->SetStaff(reh->AttStaffIdent::StrToXsdPositiveIntegerList(std::to_string(staffNum)));
         reh->SetLang(lang);
         Rend *rend = new Rend();
         rend->SetFontweight(
-            rend->AttTypography::StrToFontweight(rehearsal.node().attribute("font-weight").as_string()));
+            rend->AttTypography::StrToFontweight(rehearsal.attribute("font-weight").as_string()));
         rend->SetHalign(rend->AttHorizontalAlign::StrToHorizontalalignment(halign));
-        rend->SetRend(ConvertEnclosure(rehearsal.node().attribute("enclosure").as_string()));
+        rend->SetRend(ConvertEnclosure(rehearsal.attribute("enclosure").as_string()));
         Text *text = new Text();
         text->SetText(UTF8to16(textStr));
         rend->AddChild(text);
@@ -2296,14 +2331,14 @@ void MusicXmlInput::ReadMusicXmlDirection(
     }
 
     // Segno
-    pugi::xpath_node segno = type.select_node("segno");
+    pugi::xml_node segno = type.child("segno");
     if (segno) {
         Dir *dir = new Dir();
         dir->SetPlace(dir->AttPlacement::StrToStaffrel(placeStr.c_str()));
         dir->SetTstamp(timeStamp - 1.0);
         dir->SetType("segno");
         dir->SetStaff(dir->AttStaffIdent::StrToXsdPositiveIntegerList("1"));
-        if (segno.node().attribute("id")) dir->SetUuid(segno.node().attribute("id").as_string());
+        if (segno.attribute("id")) dir->SetUuid(segno.attribute("id").as_string());
         Rend *rend = new Rend;
         rend->SetFontname("VerovioText");
         rend->SetFontstyle(FONTSTYLE_normal);
@@ -2317,8 +2352,8 @@ void MusicXmlInput::ReadMusicXmlDirection(
     }
 
     // Tempo
-    pugi::xpath_node metronome = type.select_node("metronome");
-    if (node.select_node("sound[@tempo]") || metronome) {
+    pugi::xml_node metronome = type.child("metronome");
+    if (hasSoundTempo || metronome) {
         Tempo *tempo = new Tempo();
         if (!words.empty()) {
             tempo->SetLang(words.first().node().attribute("xml:lang").as_string());
@@ -2326,15 +2361,14 @@ void MusicXmlInput::ReadMusicXmlDirection(
         tempo->SetPlace(tempo->AttPlacement::StrToStaffrel(placeStr.c_str()));
         if (words.size() != 0) TextRendition(words, tempo);
         if (metronome)
-            PrintMetronome(metronome.node(), tempo);
+            PrintMetronome(metronome, tempo);
         else {
-            tempo->SetMidiBpm(node.select_node("sound").node().attribute("tempo").as_int());
+            tempo->SetMidiBpm(node.child("sound").attribute("tempo").as_int());
         }
         tempo->SetTstamp(timeStamp);
-        pugi::xpath_node staffNode = node.select_node("staff");
         if (staffNode) {
             tempo->SetStaff(tempo->AttStaffIdent::StrToXsdPositiveIntegerList(
-                std::to_string(staffNode.node().text().as_int() + staffOffset)));
+                std::to_string(staffNode.text().as_int() + staffOffset)));
         }
         m_controlElements.push_back(std::make_pair(measureNum, tempo));
         m_tempoStack.push_back(tempo);
@@ -2364,12 +2398,12 @@ void MusicXmlInput::ReadMusicXmlFigures(pugi::xml_node node, Measure *measure, c
         for (pugi::xml_node figure : node.children("figure")) {
             std::string textStr;
             if (paren) textStr.append("(");
-            textStr.append(ConvertFigureGlyph(figure.select_node("prefix").node().text().as_string()));
-            textStr.append(figure.select_node("figure-number").node().text().as_string());
-            textStr.append(ConvertFigureGlyph(figure.select_node("suffix").node().text().as_string()));
+            textStr.append(ConvertFigureGlyph(figure.child("prefix").text().as_string()));
+            textStr.append(figure.child("figure-number").text().as_string());
+            textStr.append(ConvertFigureGlyph(figure.child("suffix").text().as_string()));
             if (paren) textStr.append(")");
             F *f = new F();
-            if (figure.select_node("extend[@type='start']")) f->SetExtender(BOOLEAN_true);
+            if (m_xpathExtendStart.evaluate_node(figure)) f->SetExtender(BOOLEAN_true);
             Text *text = new Text();
             text->SetText(UTF8to16(textStr));
             f->AddChild(text);
@@ -2377,7 +2411,7 @@ void MusicXmlInput::ReadMusicXmlFigures(pugi::xml_node node, Measure *measure, c
         }
         harm->AddChild(fb);
         harm->SetTstamp((double)(m_durTotal + m_durFb) * (double)m_meterUnit / (double)(4 * m_ppq) + 1.0);
-        m_durFb += node.select_node("duration").node().text().as_int();
+        m_durFb += node.child("duration").text().as_int();
         m_controlElements.push_back(std::make_pair(measureNum, harm));
         m_harmStack.push_back(harm);
     }
@@ -2398,31 +2432,31 @@ void MusicXmlInput::ReadMusicXmlHarmony(pugi::xml_node node, Measure *measure, c
 
     int durOffset = 0;
 
-    std::string harmText = GetContentOfChild(node, "root/root-step");
-    pugi::xpath_node alter = node.select_node("root/root-alter");
-    if (alter) harmText += ConvertAlterToSymbol(GetContent(alter.node()));
-    pugi::xpath_node kind = node.select_node("kind");
+    std::string harmText = GetContentOfChild(node.child("root"), "root-step");
+    pugi::xml_node alter = node.child("root").child("root-alter");
+    if (alter) harmText += ConvertAlterToSymbol(GetContent(alter));
+    pugi::xml_node kind = node.child("kind");
     if (kind) {
-        if (HasAttributeWithValue(kind.node(), "use-symbols", "yes")) {
-            harmText = harmText + ConvertKindToSymbol(GetContent(kind.node()));
+        if (HasAttributeWithValue(kind, "use-symbols", "yes")) {
+            harmText = harmText + ConvertKindToSymbol(GetContent(kind));
         }
-        else if (kind.node().attribute("text") && std::strcmp(kind.node().text().as_string(), "none")) {
-            harmText = harmText + kind.node().attribute("text").as_string();
+        else if (kind.attribute("text") && std::strcmp(kind.text().as_string(), "none")) {
+            harmText = harmText + kind.attribute("text").as_string();
         }
         else {
-            harmText = harmText + ConvertKindToText(GetContent(kind.node()));
+            harmText = harmText + ConvertKindToText(GetContent(kind));
         }
     }
-    pugi::xpath_node degree = node.select_node("degree");
+    pugi::xml_node degree = node.child("degree");
     if (degree) {
-        pugi::xpath_node alter = node.select_node("degree/degree-alter");
-        harmText += ConvertAlterToSymbol(GetContent(alter.node())) + GetContentOfChild(node, "degree/degree-value");
+        pugi::xml_node alter = degree.child("degree-alter");
+        harmText += ConvertAlterToSymbol(GetContent(alter)) + GetContentOfChild(degree, "degree-value");
     }
-    pugi::xpath_node bass = node.select_node("bass");
+    pugi::xml_node bass = node.child("bass");
     if (bass) {
-        harmText += "/" + GetContentOfChild(node, "bass/bass-step");
-        pugi::xpath_node alter = node.select_node("bass/bass-alter");
-        if (alter) harmText += ConvertAlterToSymbol(GetContent(alter.node()));
+        harmText += "/" + GetContentOfChild(bass, "bass-step");
+        pugi::xml_node alter = bass.child("bass-alter");
+        if (alter) harmText += ConvertAlterToSymbol(GetContent(alter));
     }
     Harm *harm = new Harm();
     Text *text = new Text();
@@ -2430,8 +2464,8 @@ void MusicXmlInput::ReadMusicXmlHarmony(pugi::xml_node node, Measure *measure, c
     harm->SetPlace(harm->AttPlacement::StrToStaffrel(node.attribute("placement").as_string()));
     harm->SetType(node.attribute("type").as_string());
     harm->AddChild(text);
-    pugi::xpath_node offset = node.select_node("offset");
-    if (offset) durOffset = offset.node().text().as_int();
+    pugi::xml_node offset = node.child("offset");
+    if (offset) durOffset = offset.text().as_int();
     harm->SetTstamp((double)(m_durTotal + durOffset) * (double)m_meterUnit / (double)(4 * m_ppq) + 1.0);
     m_controlElements.push_back(std::make_pair(measureNum, harm));
     m_harmStack.push_back(harm);
@@ -2450,7 +2484,7 @@ void MusicXmlInput::ReadMusicXmlNote(
     Staff *staff = vrv_cast<Staff *>(layer->GetFirstAncestor(STAFF));
     assert(staff);
 
-    bool isChord = node.select_node("chord");
+    bool isChord = node.child("chord");
 
     // reset figured bass offset
     m_durFb = 0;
@@ -2472,21 +2506,24 @@ void MusicXmlInput::ReadMusicXmlNote(
         return;
     }
 
-    pugi::xpath_node notations = node.select_node("notations[not(@print-object='no')]");
+    pugi::xpath_node notations = m_xpathNotations.evaluate_node(node);
 
-    const bool cue = (node.select_node("cue") || node.select_node("type[@size='cue']")) ? true : false;
-    pugi::xml_node grace = node.select_node("grace").node();
+    const bool cue = (node.child("cue") || m_xpathCueType.evaluate_node(node)) ? true : false;
+    pugi::xml_node grace = node.child("grace");
 
     // duration string and dots
     std::string typeStr = GetContentOfChild(node, "type");
-    int dots = (int)node.select_nodes("dot").size();
+    int dots = 0;
+    for (pugi::xml_node dot = node.child("dot"); dot; dot = dot.next_sibling("dot")) {
+        ++dots;
+    }
 
     ReadMusicXmlBeamsAndTuplets(node, layer, isChord);
 
     // beam start
-    bool beamStart = node.select_node("beam[@number='1'][text()='begin']");
+    bool beamStart = m_xpathBeamStart.evaluate_node(node);
     // tremolos
-    pugi::xpath_node tremolo = notations.node().select_node("ornaments/tremolo");
+    pugi::xpath_node tremolo = m_xpathTremolo.evaluate_node(notations);
     int tremSlashNum = -1;
     if (tremolo) {
         if (HasAttributeWithValue(tremolo.node(), "type", "start")) {
@@ -2496,10 +2533,15 @@ void MusicXmlInput::ReadMusicXmlNote(
                 m_elementStackMap.at(layer).push_back(fTrem);
                 int beamFloatNum = tremolo.node().text().as_int(); // number of floating beams
                 int beamAttachedNum = 0; // number of attached beams
-                while (beamStart && beamAttachedNum < 8) { // count number of (attached) beams, max 8
-                    std::ostringstream o;
-                    o << "beam[@number='" << ++beamAttachedNum + 1 << "'][text()='begin']";
-                    beamStart = node.select_node(o.str().c_str());
+                if (beamStart) {
+                    // count number of (attached) beams, max 8
+                    std::set<int> beamNumbers;
+                    for (pugi::xml_node beam : node.children("beam")) {
+                        if (strcmp(beam.text().as_string(), "begin")) continue;
+                        beamNumbers.insert(beam.attribute("number").as_int());
+                    }
+                    beamAttachedNum = 1;
+                    while (beamAttachedNum < 8 && beamNumbers.count(beamAttachedNum + 1)) ++beamAttachedNum;
                 }
                 fTrem->SetBeams(beamFloatNum + beamAttachedNum);
                 fTrem->SetBeamsFloat(beamFloatNum);
@@ -2524,12 +2566,12 @@ void MusicXmlInput::ReadMusicXmlNote(
     }
 
     const std::string noteID = node.attribute("id").as_string();
-    const int duration = node.select_node("duration").node().text().as_int();
-    const int noteStaffNum = node.select_node("staff").node().text().as_int();
-    pugi::xpath_node rest = node.select_node("rest");
+    const int duration = node.child("duration").text().as_int();
+    const int noteStaffNum = node.child("staff").text().as_int();
+    pugi::xml_node rest = node.child("rest");
     if (rest) {
-        std::string stepStr = GetContentOfChild(rest.node(), "display-step");
-        std::string octaveStr = GetContentOfChild(rest.node(), "display-octave");
+        std::string stepStr = GetContentOfChild(rest, "display-step");
+        std::string octaveStr = GetContentOfChild(rest, "display-octave");
         if (HasAttributeWithValue(node, "print-object", "no")) {
             Space *space = new Space();
             element = space;
@@ -2555,7 +2597,7 @@ void MusicXmlInput::ReadMusicXmlNote(
             }
         }
         // we assume /note without /type or with duration of an entire bar to be mRest
-        else if (typeStr.empty() || HasAttributeWithValue(rest.node(), "measure", "yes")) {
+        else if (typeStr.empty() || HasAttributeWithValue(rest, "measure", "yes")) {
             if (m_slash) {
                 for (int i = m_meterCount; i > 0; --i) {
                     BeatRpt *slash = new BeatRpt;
@@ -2578,7 +2620,7 @@ void MusicXmlInput::ReadMusicXmlNote(
         else {
             Rest *rest = new Rest();
             element = rest;
-            rest->SetColor(node.attribute("color").as_string());
+            if (node.attribute("color")) rest->SetColor(node.attribute("color").as_string());
             rest->SetDur(ConvertTypeToDur(typeStr));
             rest->SetDurPpq(duration);
             if (dots > 0) rest->SetDots(dots);
@@ -2599,7 +2641,7 @@ void MusicXmlInput::ReadMusicXmlNote(
         Note *note = new Note();
         element = note;
         note->SetVisible(ConvertWordToBool(node.append_attribute("print-object").as_string()));
-        note->SetColor(node.attribute("color").as_string());
+        if (node.attribute("color")) note->SetColor(node.attribute("color").as_string());
         if (!noteID.empty()) {
             note->SetUuid(noteID);
         }
@@ -2610,22 +2652,22 @@ void MusicXmlInput::ReadMusicXmlNote(
                 note->AttStaffIdent::StrToXsdPositiveIntegerList(std::to_string(noteStaffNum + staffOffset)));
 
         // accidental
-        pugi::xpath_node accidental = node.select_node("accidental");
+        pugi::xml_node accidental = node.child("accidental");
         if (accidental) {
             Accid *accid = new Accid();
-            accid->SetAccid(ConvertAccidentalToAccid(accidental.node().text().as_string()));
-            accid->SetColor(accidental.node().attribute("color").as_string());
-            if (HasAttributeWithValue(accidental.node(), "cautionary", "yes")) accid->SetFunc(accidLog_FUNC_caution);
-            if (HasAttributeWithValue(accidental.node(), "editorial", "yes")) accid->SetFunc(accidLog_FUNC_edit);
-            if (HasAttributeWithValue(accidental.node(), "bracket", "yes")) accid->SetEnclose(ENCLOSURE_brack);
-            if (HasAttributeWithValue(accidental.node(), "parentheses", "yes")) accid->SetEnclose(ENCLOSURE_paren);
+            accid->SetAccid(ConvertAccidentalToAccid(accidental.text().as_string()));
+            accid->SetColor(accidental.attribute("color").as_string());
+            if (HasAttributeWithValue(accidental, "cautionary", "yes")) accid->SetFunc(accidLog_FUNC_caution);
+            if (HasAttributeWithValue(accidental, "editorial", "yes")) accid->SetFunc(accidLog_FUNC_edit);
+            if (HasAttributeWithValue(accidental, "bracket", "yes")) accid->SetEnclose(ENCLOSURE_brack);
+            if (HasAttributeWithValue(accidental, "parentheses", "yes")) accid->SetEnclose(ENCLOSURE_paren);
             note->AddChild(accid);
         }
 
         // stem direction - taken into account below for the chord or the note
         data_STEMDIRECTION stemDir = STEMDIRECTION_NONE;
-        pugi::xpath_node stem = node.select_node("stem");
-        std::string stemText = stem.node().text().as_string();
+        pugi::xml_node stem = node.child("stem");
+        std::string stemText = stem.text().as_string();
         if (stemText == "down") {
             stemDir = STEMDIRECTION_down;
         }
@@ -2634,10 +2676,10 @@ void MusicXmlInput::ReadMusicXmlNote(
         }
 
         // pitch and octave
-        pugi::xpath_node pitch = node.select_node("pitch");
+        pugi::xml_node pitch = node.child("pitch");
         if (pitch) {
-            const std::string stepStr = GetContentOfChild(pitch.node(), "step");
-            const std::string octaveStr = GetContentOfChild(pitch.node(), "octave");
+            const std::string stepStr = GetContentOfChild(pitch, "step");
+            const std::string octaveStr = GetContentOfChild(pitch, "octave");
             if (!stepStr.empty()) note->SetPname(ConvertStepToPitchName(stepStr));
             if (!octaveStr.empty()) {
                 if (m_octDis[staff->GetN()] != 0) {
@@ -2648,7 +2690,7 @@ void MusicXmlInput::ReadMusicXmlNote(
                     note->SetOct(atoi(octaveStr.c_str()));
                 }
             }
-            const std::string alterStr = GetContentOfChild(pitch.node(), "alter");
+            const std::string alterStr = GetContentOfChild(pitch, "alter");
             if (!alterStr.empty()) {
                 Accid *accid = dynamic_cast<Accid *>(note->GetFirst(ACCID));
                 if (!accid) {
@@ -2667,19 +2709,19 @@ void MusicXmlInput::ReadMusicXmlNote(
         }
 
         // notehead
-        pugi::xpath_node notehead = node.select_node("notehead");
+        pugi::xml_node notehead = node.child("notehead");
         if (notehead) {
-            note->SetHeadColor(notehead.node().attribute("color").as_string());
-            note->SetHeadShape(ConvertNotehead(notehead.node().text().as_string()));
-            if (notehead.node().attribute("parentheses").as_bool()) note->SetHeadMod(NOTEHEADMODIFIER_paren);
-            auto noteHeadFill = notehead.node().attribute("filled");
+            note->SetHeadColor(notehead.attribute("color").as_string());
+            note->SetHeadShape(ConvertNotehead(notehead.text().as_string()));
+            if (notehead.attribute("parentheses").as_bool()) note->SetHeadMod(NOTEHEADMODIFIER_paren);
+            auto noteHeadFill = notehead.attribute("filled");
             if (noteHeadFill) note->SetHeadFill(noteHeadFill.as_bool() ? FILL_solid : FILL_void);
-            if (!std::strncmp(notehead.node().text().as_string(), "none", 4)) note->SetHeadVisible(BOOLEAN_false);
+            if (!std::strncmp(notehead.text().as_string(), "none", 4)) note->SetHeadVisible(BOOLEAN_false);
         }
 
         // look at the next note to see if we are starting or ending a chord
-        pugi::xpath_node nextNote = node.select_node("./following-sibling::note");
-        if (nextNote.node().select_node("chord")) nextIsChord = true;
+        pugi::xml_node nextNote = node.next_sibling("note");
+        if (nextNote.child("chord")) nextIsChord = true;
         Chord *chord = NULL;
         if (nextIsChord) {
             // create the chord if we are starting a new chord
@@ -2688,7 +2730,7 @@ void MusicXmlInput::ReadMusicXmlNote(
                 chord->SetDur(ConvertTypeToDur(typeStr));
                 chord->SetDurPpq(atoi(GetContentOfChild(node, "duration").c_str()));
                 if (dots > 0) chord->SetDots(dots);
-                chord->SetStemDir(stemDir);
+                if (stemDir != STEMDIRECTION_NONE) chord->SetStemDir(stemDir);
                 if (stemText == "none") chord->SetStemVisible(BOOLEAN_false);
                 if (tremSlashNum > 0) {
                     chord->SetStemMod(chord->AttStems::StrToStemmodifier(std::to_string(tremSlashNum) + "slash"));
@@ -2712,7 +2754,7 @@ void MusicXmlInput::ReadMusicXmlNote(
             }
         }
         // If the current note is part of a chord.
-        if (nextIsChord || node.select_node("chord")) {
+        if (nextIsChord || isChord) {
             if (chord == NULL && m_elementStackMap.at(layer).size() > 0
                 && m_elementStackMap.at(layer).back()->Is(CHORD)) {
                 chord = dynamic_cast<Chord *>(m_elementStackMap.at(layer).back());
@@ -2749,10 +2791,10 @@ void MusicXmlInput::ReadMusicXmlNote(
             note->SetDur(ConvertTypeToDur(typeStr));
             note->SetDurPpq(atoi(GetContentOfChild(node, "duration").c_str()));
             if (dots > 0) note->SetDots(dots);
-            note->SetStemDir(stemDir);
-            if (node.attribute("default-y") && stem.node().attribute("default-y")) {
+            if (stemDir != STEMDIRECTION_NONE) note->SetStemDir(stemDir);
+            if (node.attribute("default-y") && stem.attribute("default-y")) {
                 float stemLen
-                    = abs(node.attribute("default-y").as_float() - stem.node().attribute("default-y").as_float()) / 5;
+                    = abs(node.attribute("default-y").as_float() - stem.attribute("default-y").as_float()) / 5;
                 note->SetStemLen(stemLen);
             }
             if (stemText == "none") note->SetStemVisible(BOOLEAN_false);
@@ -2765,9 +2807,7 @@ void MusicXmlInput::ReadMusicXmlNote(
         }
 
         // verse / syl
-        pugi::xpath_node_set lyrics = node.select_nodes("lyric");
-        for (pugi::xpath_node_set::const_iterator it = lyrics.begin(); it != lyrics.end(); ++it) {
-            pugi::xml_node lyric = it->node();
+        for (pugi::xml_node lyric : node.children("lyric")) {
             int lyricNumber = lyric.attribute("number").as_int();
             lyricNumber = (lyricNumber < 1) ? 1 : lyricNumber;
             Verse *verse = new Verse();
@@ -2787,7 +2827,7 @@ void MusicXmlInput::ReadMusicXmlNote(
                     if (textNode.next_sibling("elision")) {
                         syl->SetCon(sylLog_CON_b);
                     }
-                    else if (lyric.select_node("extend")) {
+                    else if (lyric.child("extend")) {
                         syl->SetCon(sylLog_CON_u);
                     }
                     else if (GetContentOfChild(lyric, "syllabic") == "single") {
@@ -2828,8 +2868,8 @@ void MusicXmlInput::ReadMusicXmlNote(
         }
 
         // ties
-        pugi::xpath_node startTie = notations.node().select_node("tied[@type='start']");
-        pugi::xpath_node endTie = notations.node().select_node("tied[@type='stop']");
+        pugi::xpath_node startTie = m_xpathTieStart.evaluate_node(notations);
+        pugi::xpath_node endTie = m_xpathTieStop.evaluate_node(notations);
         if (endTie) { // add to stack if (endTie) or if pitch/oct match to open tie on m_tieStack
             if (!m_tieStack.empty() && note->GetPname() == m_tieStack.back().second->GetPname()
                 && note->GetOct() == m_tieStack.back().second->GetOct()) {
@@ -2859,7 +2899,7 @@ void MusicXmlInput::ReadMusicXmlNote(
         // articulation
         std::vector<data_ARTICULATION> artics;
         for (pugi::xml_node articulations : notations.node().children("articulations")) {
-            if (notations.node().select_node("articulations/*[not(@placement)]")) {
+            if (m_xpathUnplacedArticulation.evaluate_node(notations)) {
                 Artic *artic = new Artic();
                 for (pugi::xml_node articulation : articulations.children()) {
                     artics.push_back(ConvertArticulations(articulation.name()));
@@ -2944,7 +2984,7 @@ void MusicXmlInput::ReadMusicXmlNote(
     m_ID = "#" + element->GetUuid();
 
     // breath marks
-    pugi::xpath_node xmlBreath = notations.node().select_node("articulations/breath-mark");
+    pugi::xpath_node xmlBreath = m_xpathBreathMark.evaluate_node(notations);
     if (xmlBreath) {
         Breath *breath = new Breath();
         m_controlElements.push_back(std::make_pair(measureNum, breath));
@@ -2955,17 +2995,17 @@ void MusicXmlInput::ReadMusicXmlNote(
     }
 
     // dynamics
-    pugi::xpath_node xmlDynam = notations.node().select_node("dynamics");
+    pugi::xml_node xmlDynam = notations.node().child("dynamics");
     if (xmlDynam) {
         Dynam *dynam = new Dynam();
         m_controlElements.push_back(std::make_pair(measureNum, dynam));
         dynam->SetStaff(staff->AttNInteger::StrToXsdPositiveIntegerList(std::to_string(staff->GetN())));
         dynam->SetStartid(m_ID);
-        if (xmlDynam.node().attribute("id")) dynam->SetUuid(xmlDynam.node().attribute("id").as_string());
+        if (xmlDynam.attribute("id")) dynam->SetUuid(xmlDynam.attribute("id").as_string());
         // place
-        dynam->SetPlace(dynam->AttPlacement::StrToStaffrel(xmlDynam.node().attribute("placement").as_string()));
+        dynam->SetPlace(dynam->AttPlacement::StrToStaffrel(xmlDynam.attribute("placement").as_string()));
         std::string dynamStr;
-        for (pugi::xml_node xmlDynamPart : xmlDynam.node().children()) {
+        for (pugi::xml_node xmlDynamPart : xmlDynam.children()) {
             if (xmlDynamPart.text()) {
                 dynamStr += xmlDynamPart.text().as_string();
             }
@@ -2979,18 +3019,18 @@ void MusicXmlInput::ReadMusicXmlNote(
     }
 
     // fermatas
-    pugi::xpath_node xmlFermata = notations.node().select_node("fermata");
+    pugi::xml_node xmlFermata = notations.node().child("fermata");
     if (xmlFermata) {
         Fermata *fermata = new Fermata();
         m_controlElements.push_back(std::make_pair(measureNum, fermata));
         fermata->SetStartid(m_ID);
         fermata->SetStaff(staff->AttNInteger::StrToXsdPositiveIntegerList(std::to_string(staff->GetN())));
-        if (xmlFermata.node().attribute("id")) fermata->SetUuid(xmlFermata.node().attribute("id").as_string());
-        ShapeFermata(fermata, xmlFermata.node());
+        if (xmlFermata.attribute("id")) fermata->SetUuid(xmlFermata.attribute("id").as_string());
+        ShapeFermata(fermata, xmlFermata);
     }
 
     // fingering
-    auto xmlFing = notations.node().select_node("technical/fingering");
+    auto xmlFing = m_xpathFingering.evaluate_node(notations);
     if (xmlFing) {
         std::string fingText = GetContent(xmlFing.node());
         Fing *fing = new Fing();
@@ -3004,7 +3044,7 @@ void MusicXmlInput::ReadMusicXmlNote(
     }
 
     // glissando and slide
-    pugi::xpath_node_set glissandi = notations.node().select_nodes("glissando|slide");
+    pugi::xpath_node_set glissandi = m_xpathGlissandi.evaluate_node_set(notations);
     for (pugi::xpath_node_set::const_iterator it = glissandi.begin(); it != glissandi.end(); ++it) {
         std::string noteID = m_ID;
         // prevent from using chords
@@ -3038,7 +3078,7 @@ void MusicXmlInput::ReadMusicXmlNote(
     }
 
     // mordents
-    pugi::xpath_node xmlMordent = notations.node().select_node("ornaments/*[contains(name(), 'mordent')]");
+    pugi::xpath_node xmlMordent = m_xpathMordent.evaluate_node(notations);
     if (xmlMordent) {
         Mordent *mordent = new Mordent();
         m_controlElements.push_back(std::make_pair(measureNum, mordent));
@@ -3084,8 +3124,7 @@ void MusicXmlInput::ReadMusicXmlNote(
     }
 
     // schleifer/haydn (counts as mordent with different glyph)
-    pugi::xpath_node xmlExtOrnament
-        = notations.node().select_node("ornaments/*[contains(name(), 'schleifer') or contains(name(), 'haydn')]");
+    pugi::xpath_node xmlExtOrnament = m_xpathExtOrnament.evaluate_node(notations);
     if (xmlExtOrnament) {
         Mordent *mordent = new Mordent();
         m_controlElements.push_back(std::make_pair(measureNum, mordent));
@@ -3102,8 +3141,8 @@ void MusicXmlInput::ReadMusicXmlNote(
     }
 
     // trill
-    pugi::xpath_node xmlTrill = notations.node().select_node("ornaments/trill-mark");
-    pugi::xpath_node xmlTrillLine = notations.node().select_node("ornaments/wavy-line[@type='start']");
+    pugi::xpath_node xmlTrill = m_xpathTrillMark.evaluate_node(notations);
+    pugi::xpath_node xmlTrillLine = m_xpathWavyLineStart.evaluate_node(notations);
     if (xmlTrill || xmlTrillLine) {
         Trill *trill = new Trill();
         m_controlElements.push_back(std::make_pair(measureNum, trill));
@@ -3134,9 +3173,10 @@ void MusicXmlInput::ReadMusicXmlNote(
             }
         }
     }
-    if (!m_trillStack.empty() && notations.node().select_node("ornaments/wavy-line[@type='stop']")) {
-        int extNumber
-            = notations.node().select_node("ornaments/wavy-line[@type='stop']").node().attribute("number").as_int();
+    pugi::xpath_node xmlTrillLineStop;
+    if (!m_trillStack.empty()) xmlTrillLineStop = m_xpathWavyLineStop.evaluate_node(notations);
+    if (xmlTrillLineStop) {
+        int extNumber = xmlTrillLineStop.node().attribute("number").as_int();
         std::vector<std::pair<Trill *, musicxml::OpenSpanner> >::iterator iter = m_trillStack.begin();
         while (iter != m_trillStack.end()) {
             const int measureDifference = m_measureCounts.at(measure) - iter->second.m_lastMeasureCount;
@@ -3153,7 +3193,7 @@ void MusicXmlInput::ReadMusicXmlNote(
     }
 
     // turns
-    pugi::xpath_node xmlTurn = notations.node().select_node("ornaments/*[contains(name(), 'turn')]");
+    pugi::xpath_node xmlTurn = m_xpathTurn.evaluate_node(notations);
     if (xmlTurn) {
         Turn *turn = new Turn();
         m_controlElements.push_back(std::make_pair(measureNum, turn));
@@ -3189,7 +3229,7 @@ void MusicXmlInput::ReadMusicXmlNote(
     }
 
     // arpeggio
-    pugi::xpath_node xmlArpeggiate = notations.node().select_node("*[contains(name(), 'arpeggiate')]");
+    pugi::xpath_node xmlArpeggiate = m_xpathArpeggiate.evaluate_node(notations);
     if (xmlArpeggiate) {
         int arpegN = xmlArpeggiate.node().attribute("number").as_int();
         arpegN = (arpegN < 1) ? 1 : arpegN;
@@ -3233,7 +3273,7 @@ void MusicXmlInput::ReadMusicXmlNote(
     }
 
     // slur
-    pugi::xpath_node_set slurs = node.select_nodes("notations/slur");
+    pugi::xpath_node_set slurs = m_xpathSlurs.evaluate_node_set(node);
     for (pugi::xpath_node_set::const_iterator it = slurs.begin(); it != slurs.end(); ++it) {
         pugi::xml_node slur = it->node();
         int slurNumber = slur.attribute("number").as_int();
@@ -3267,15 +3307,15 @@ void MusicXmlInput::ReadMusicXmlNote(
     }
 
     // tuplet end
-    pugi::xpath_node tupletEnd = notations.node().select_node("tuplet[@type='stop']");
+    pugi::xpath_node tupletEnd = m_xpathTupletStop.evaluate_node(notations);
     if (tupletEnd) {
         RemoveLastFromStack(TUPLET, layer);
     }
 
     // beam end
-    bool beamEnd = node.select_node("beam[text()='end']");
+    bool beamEnd = m_xpathBeamEnd.evaluate_node(node);
     if (beamEnd) {
-        int breakSec = (int)node.select_nodes("beam[text()='continue']").size();
+        int breakSec = (int)m_xpathBeamContinue.evaluate_node_set(node).size();
         if (breakSec) {
             if (element->Is(NOTE)) {
                 Note *note = dynamic_cast<Note *>(element);
@@ -3366,16 +3406,16 @@ void MusicXmlInput::ReadMusicXmlPrint(pugi::xml_node node, Section *section)
 
 void MusicXmlInput::ReadMusicXmlBeamsAndTuplets(const pugi::xml_node &node, Layer *layer, bool isChord)
 {
-    pugi::xpath_node beamStart = node.select_node("beam[@number='1'][text()='begin']");
-    pugi::xpath_node tupletStart = node.select_node("notations/tuplet[@type='start']");
+    pugi::xpath_node beamStart = m_xpathBeamStart.evaluate_node(node);
+    pugi::xpath_node tupletStart = m_xpathTupletStart.evaluate_node(node);
+    if (!beamStart && !tupletStart) return;
 
-    const auto measureNodeChildren = node.select_node("../.").node().children();
+    const auto measureNodeChildren = node.parent().children();
     std::vector<pugi::xml_node> currentMeasureNodes(measureNodeChildren.begin(), measureNodeChildren.end());
     // in case note is a start of both beam and tuplet - need to figure which one is longer
     if (beamStart && tupletStart) {
-        pugi::xml_node beamEnd = node.select_node("./following-sibling::note[beam[@number='1'][text()='end']]").node();
-        pugi::xml_node tupletEnd
-            = node.select_node("./following-sibling::note[notations[tuplet[@type='stop']]]").node();
+        pugi::xml_node beamEnd = m_xpathNextBeamEnd.evaluate_node(node).node();
+        pugi::xml_node tupletEnd = m_xpathNextTupletStop.evaluate_node(node).node();
 
         const auto beamEndIterator = std::find(currentMeasureNodes.begin(), currentMeasureNodes.end(), beamEnd);
         const auto tupletEndIterator = std::find(currentMeasureNodes.begin(), currentMeasureNodes.end(), tupletEnd);
@@ -3395,12 +3435,10 @@ void MusicXmlInput::ReadMusicXmlBeamsAndTuplets(const pugi::xml_node &node, Laye
     // If note is a start of the beam only - check if there is a tuplet starting/ending in the span of
     // the whole duration of this beam
     else if (beamStart) {
-        pugi::xml_node beamEnd = node.select_node("./following-sibling::note[beam[@number='1'][text()='end']]").node();
+        pugi::xml_node beamEnd = m_xpathNextBeamEnd.evaluate_node(node).node();
         // find whether there is a tuplet that starts during the span of the beam
-        pugi::xpath_node nextTupletStart
-            = node.select_node("./following-sibling::note[notations[tuplet[@type='start']]]").node();
-        pugi::xml_node tupletEnd
-            = node.select_node("./following-sibling::note[notations[tuplet[@type='stop']]]").node();
+        pugi::xpath_node nextTupletStart = m_xpathNextTupletStart.evaluate_node(node);
+        pugi::xml_node tupletEnd = m_xpathNextTupletStop.evaluate_node(node).node();
 
         // find start and end of the beam
         const auto beamStartIterator = std::find(currentMeasureNodes.begin(), currentMeasureNodes.end(), node);
@@ -3439,11 +3477,11 @@ void MusicXmlInput::ReadMusicXmlTupletStart(const pugi::xml_node &node, const pu
     Tuplet *tuplet = new Tuplet();
     AddLayerElement(layer, tuplet);
     m_elementStackMap.at(layer).push_back(tuplet);
-    int num = node.select_node("time-modification/actual-notes").node().text().as_int();
-    int numbase = node.select_node("time-modification/normal-notes").node().text().as_int();
+    int num = node.child("time-modification").child("actual-notes").text().as_int();
+    int numbase = node.child("time-modification").child("normal-notes").text().as_int();
     if (tupletStart.first_child()) {
-        num = tupletStart.select_node("tuplet-actual/tuplet-number").node().text().as_int();
-        numbase = tupletStart.select_node("tuplet-normal/tuplet-number").node().text().as_int();
+        num = tupletStart.child("tuplet-actual").child("tuplet-number").text().as_int();
+        numbase = tupletStart.child("tuplet-normal").child("tuplet-number").text().as_int();
     }
     if (num) tuplet->SetNum(num);
     if (numbase) tuplet->SetNumbase(numbase);
@@ -3456,7 +3494,7 @@ void MusicXmlInput::ReadMusicXmlTupletStart(const pugi::xml_node &node, const pu
 
 void MusicXmlInput::ReadMusicXmlBeamStart(const pugi::xml_node &node, const pugi::xml_node &beamStart, Layer *layer)
 {
-    if (!beamStart || (node.select_node("notations/ornaments/tremolo[@type='start']"))) return;
+    if (!beamStart || (m_xpathTremoloStart.evaluate_node(node))) return;
 
     Beam *beam = new Beam();
     if (beamStart.attribute("id")) beam->SetUuid(beamStart.attribute("id").as_string());
@@ -3946,7 +3984,7 @@ void MusicXmlInput::ShapeFermata(Fermata *fermata, pugi::xml_node node)
     assert(fermata);
 
     // color
-    fermata->SetColor(node.attribute("color").as_string());
+    if (node.attribute("color")) fermata->SetColor(node.attribute("color").as_string());
     // shape
     fermata->SetShape(ConvertFermataShape(node.text().as_string()));
     // form and place
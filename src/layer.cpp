@@ -74,6 +74,8 @@ void Layer::Reset()
 
     ResetStaffDefObjects();
 
+    m_previousClefs.clear();
+
     m_drawingStemDir = STEMDIRECTION_NONE;
     m_crossStaffFromAbove = false;
     m_crossStaffFromBelow = false;
@@ -83,6 +85,8 @@ void Layer::CloneReset()
 {
     Object::CloneReset();
 
+    m_previousClefs.clear();
+
     m_drawKeySigCancellation = false;
     m_staffDefClef = NULL;
     m_staffDefKeySig = NULL;
@@ -169,9 +173,8 @@ LayerElement *Layer::GetAtPos(int x)
     assert(element);
     if (element->GetDrawingX() > x) return NULL;
 
-    Object *next;
-    while ((next = this->GetNext())) {
-        if (!next->IsLayerElement()) continue;
+    for (Object *next : this->GetChildRange()) {
+        if ((next == first) || !next->IsLayerElement()) continue;
         LayerElement *nextLayerElement = vrv_cast<LayerElement *>(next);
         assert(nextLayerElement);
         if (nextLayerElement->GetDrawingX() > x) return element;
@@ -183,23 +186,20 @@ LayerElement *Layer::GetAtPos(int x)
 
 Clef *Layer::GetClef(LayerElement *test)
 {
-    Object *testObject = test;
-
     if (!test) {
         return GetCurrentClef();
     }
 
-    // make sure list is set
-    ResetList(this);
-    if (!test->Is(CLEF)) {
-        testObject = GetListFirstBackward(testObject, CLEF);
-    }
-
-    if (testObject && testObject->Is(CLEF)) {
-        Clef *clef = vrv_cast<Clef *>(testObject);
+    if (test->Is(CLEF)) {
+        Clef *clef = vrv_cast<Clef *>(test);
         assert(clef);
         return clef;
     }
+
+    Clef *previousClef = this->GetPreviousClef(test);
+    if (previousClef) {
+        return previousClef;
+    }
     Clef *facsClef = this->GetClefFacs(test);
     if (facsClef != NULL) {
         return facsClef;
@@ -212,16 +212,39 @@ Clef *Layer::GetClefFacs(LayerElement *test)
     Doc *doc = vrv_cast<Doc *>(this->GetFirstAncestor(DOC));
     assert(doc);
     if (doc->GetType() == Facs) {
-        ListOfObjects clefs;
-        ClassIdComparison ac(CLEF);
-        doc->FindAllDescendantBetween(&clefs, &ac, doc->GetFirst(CLEF), test);
-        if (clefs.size() > 0) {
-            return dynamic_cast<Clef *>(*clefs.rbegin());
-        }
+        return doc->GetFacsClef(test);
     }
     return NULL;
 }
 
+Clef *Layer::GetPreviousClef(LayerElement *test)
+{
+    assert(test);
+
+    // make sure list and the clefs are set
+    ResetList(this);
+
+    auto iter = m_previousClefs.find(test);
+    return (iter != m_previousClefs.end()) ? iter->second : NULL;
+}
+
+void Layer::FilterList(ArrayOfObjects *childList)
+{
+    m_previousClefs.clear();
+
+    // The list is in the order of the layer, so we only need to keep track of the last clef we have seen
+    Clef *clef = NULL;
+    for (Object *object : *childList) {
+        if (clef && object->IsLayerElement()) {
+            m_previousClefs[object] = clef;
+        }
+        if (object->Is(CLEF)) {
+            clef = vrv_cast<Clef *>(object);
+            assert(clef);
+        }
+    }
+}
+
 int Layer::GetClefLocOffset(LayerElement *test)
 {
     Clef *clef = GetClef(test);
@@ -316,19 +339,8 @@ int Layer::GetLayerCountInTimeSpan(double time, double duration, Measure *measur
 {
     assert(measure);
 
-    Functor layerCountInTimeSpan(&Object::LayerCountInTimeSpan);
-    LayerCountInTimeSpanParams layerCountInTimeSpanParams(
-        GetCurrentMeterSig(), GetCurrentMensur(), &layerCountInTimeSpan);
-    layerCountInTimeSpanParams.m_time = time;
-    layerCountInTimeSpanParams.m_duration = duration;
-
-    ArrayOfComparisons filters;
-    AttNIntegerComparison matchStaff(ALIGNMENT_REFERENCE, staff);
-    filters.push_back(&matchStaff);
-
-    measure->m_measureAligner.Process(&layerCountInTimeSpan, &layerCountInTimeSpanParams, NULL, &filters);
-
-    return (int)layerCountInTimeSpanParams.m_layers.size();
+    return measure->m_timeSpanIndex.GetLayerCount(
+        measure, staff, time, duration, GetCurrentMeterSig(), GetCurrentMensur());
 }
 
 ListOfObjects Layer::GetLayerElementsForTimeSpanOf(LayerElement *element)
@@ -356,18 +368,8 @@ ListOfObjects Layer::GetLayerElementsInTimeSpan(double time, double duration, Me
 {
     assert(measure);
 
-    Functor layerElementsInTimeSpan(&Object::LayerElementsInTimeSpan);
-    LayerElementsInTimeSpanParams layerElementsInTimeSpanParams(GetCurrentMeterSig(), GetCurrentMensur(), this);
-    layerElementsInTimeSpanParams.m_time = time;
-    layerElementsInTimeSpanParams.m_duration = duration;
-
-    ArrayOfComparisons filters;
-    AttNIntegerComparison matchStaff(ALIGNMENT_REFERENCE, staff);
-    filters.push_back(&matchStaff);
-
-    measure->m_measureAligner.Process(&layerElementsInTimeSpan, &layerElementsInTimeSpanParams, NULL, &filters);
-
-    return layerElementsInTimeSpanParams.m_elements;
+    return measure->m_timeSpanIndex.GetLayerElements(
+        measure, staff, this, time, duration, GetCurrentMeterSig(), GetCurrentMensur());
 }
 
 Clef *Layer::GetCurrentClef() const
@@ -1655,74 +1655,6 @@ int LayerElement::PrepareTimeSpanning(FunctorParams *functorParams)
     return FUNCTOR_CONTINUE;
 }
 
-int LayerElement::LayerCountInTimeSpan(FunctorParams *functorParams)
-{
-    LayerCountInTimeSpanParams *params = vrv_params_cast<LayerCountInTimeSpanParams *>(functorParams);
-    assert(params);
-
-    if (this->IsScoreDefElement()) return FUNCTOR_SIBLINGS;
-
-    // For mRest we do not look at the time span
-    if (this->Is(MREST)) {
-        // Add the layerN to the list of layer element occuring in this time frame
-        if (std::find(params->m_layers.begin(), params->m_layers.end(), this->GetAlignmentLayerN())
-            == params->m_layers.end()) {
-            params->m_layers.push_back(this->GetAlignmentLayerN());
-        }
-        return FUNCTOR_SIBLINGS;
-    }
-
-    if (!this->GetDurationInterface() || this->Is(MSPACE) || this->Is(SPACE) || this->HasSameasLink())
-        return FUNCTOR_CONTINUE;
-
-    double duration = this->GetAlignmentDuration(params->m_mensur, params->m_meterSig);
-    double time = m_alignment->GetTime();
-
-    // The event is starting after the end of the element
-    if ((time + duration) <= params->m_time) {
-        return FUNCTOR_CONTINUE;
-    }
-    // The element is starting after the event end - we can stop here
-    else if (time >= (params->m_time + params->m_duration)) {
-        return FUNCTOR_STOP;
-    }
-
-    // Add the layerN to the list of layer element occuring in this time frame
-    if (std::find(params->m_layers.begin(), params->m_layers.end(), this->GetAlignmentLayerN())
-        == params->m_layers.end()) {
-        params->m_layers.push_back(this->GetAlignmentLayerN());
-    }
-
-    // Not need to recurse for chords? Not quite sure about it.
-    return (this->Is(CHORD)) ? FUNCTOR_SIBLINGS : FUNCTOR_CONTINUE;
-}
-
-int LayerElement::LayerElementsInTimeSpan(FunctorParams *functorParams)
-{
-    LayerElementsInTimeSpanParams *params = vrv_params_cast<LayerElementsInTimeSpanParams *>(functorParams);
-    assert(params);
-
-    Layer *currentLayer = vrv_cast<Layer *>(GetFirstAncestor(LAYER));
-    if (!currentLayer || (currentLayer != params->m_layer) || IsScoreDefElement() || Is(MREST)) return FUNCTOR_SIBLINGS;
-    if (!GetDurationInterface() || Is(MSPACE) || Is(SPACE) || HasSameasLink()) return FUNCTOR_CONTINUE;
-
-    const double duration = !GetParent()->Is(CHORD)
-        ? GetAlignmentDuration(params->m_mensur, params->m_meterSig)
-        : vrv_cast<Chord *>(GetParent())->GetAlignmentDuration(params->m_mensur, params->m_meterSig);
-
-    const double time = m_alignment->GetTime();
-
-    // The event is starting after the end of the element
-    if ((time + duration) <= params->m_time) return FUNCTOR_CONTINUE;
-    // The element is starting after the event end - we can stop here
-    if (time >= (params->m_time + params->m_duration)) return FUNCTOR_STOP;
-
-    params->m_elements.push_back(this);
-
-    // Not need to recurse for chords
-    return Is(CHORD) ? FUNCTOR_SIBLINGS : FUNCTOR_CONTINUE;
-}
-
 int LayerElement::FindSpannedLayerElements(FunctorParams *functorParams)
 {
     FindSpannedLayerElementsParams *params = vrv_params_cast<FindSpannedLayerElementsParams *>(functorParams);
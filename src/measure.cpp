@@ -91,6 +91,7 @@ void Measure::CloneReset()
 
     m_measureAligner.Reset();
     m_measureAligner.SetParent(this);
+    m_timeSpanIndex.Reset();
     // Idem for timestamps
     m_timestampAligner.SetParent(this);
     // Idem for barlines
@@ -393,8 +394,7 @@ Staff *Measure::GetBottomVisibleStaff()
 int Measure::EnclosesTime(int time) const
 {
     int repeat = 1;
-    int timeDuration = int(
-        m_measureAligner.GetRightAlignment()->GetTime() * DURATION_4 / DUR_MAX * 60.0 / m_currentTempo * 1000.0 + 0.5);
+    int timeDuration = this->GetRealTimeDurationMilliseconds();
     std::vector<double>::const_iterator iter;
     for (iter = m_realTimeOffsetMilliseconds.begin(); iter != m_realTimeOffsetMilliseconds.end(); ++iter) {
         if ((time >= *iter) && (time <= *iter + timeDuration)) return repeat;
@@ -409,6 +409,39 @@ double Measure::GetRealTimeOffsetMilliseconds(int repeat) const
     return m_realTimeOffsetMilliseconds.at(repeat - 1);
 }
 
+int Measure::GetRealTimeDurationMilliseconds() const
+{
+    return int(
+        m_measureAligner.GetRightAlignment()->GetTime() * DURATION_4 / DUR_MAX * 60.0 / m_currentTempo * 1000.0 + 0.5);
+}
+
+double Measure::GetScoreTimeDuration() const
+{
+    return m_measureAligner.GetRightAlignment()->GetTime() * DURATION_4 / DUR_MAX;
+}
+
+int Measure::CheckPlaybackRange(PlaybackRange &range) const
+{
+    if (range.m_isEnded) return FUNCTOR_STOP;
+
+    if (range.m_startMeasure && !range.m_isStarted) {
+        if (range.m_startMeasure != this) return FUNCTOR_SIBLINGS;
+        range.m_isStarted = true;
+    }
+    // The end measure is still processed, the traversal stops with the next one
+    if (range.m_endMeasure == this) range.m_isEnded = true;
+
+    // Deal with repeated music later, for now use the last times as for the output
+    const double realTimeOffset = m_realTimeOffsetMilliseconds.back();
+    if ((range.m_endTime >= 0.0) && (realTimeOffset > range.m_endTime)) {
+        range.m_isEnded = true;
+        return FUNCTOR_STOP;
+    }
+    if (realTimeOffset + this->GetRealTimeDurationMilliseconds() < range.m_startTime) return FUNCTOR_SIBLINGS;
+
+    return FUNCTOR_CONTINUE;
+}
+
 void Measure::SetDrawingBarLines(Measure *previous, bool systemBreak, bool scoreDefInsert)
 {
     // First set the right barline. If none then set a single one.
@@ -644,6 +677,7 @@ int Measure::AlignHorizontally(FunctorParams *functorParams)
 
     // clear the content of the measureAligner
     m_measureAligner.Reset();
+    m_timeSpanIndex.Reset();
 
     // point to it
     params->m_measureAligner = &m_measureAligner;
@@ -1186,14 +1220,28 @@ int Measure::GenerateMIDI(FunctorParams *functorParams)
     GenerateMIDIParams *params = vrv_params_cast<GenerateMIDIParams *>(functorParams);
     assert(params);
 
+    if (params->m_range.IsSet()) {
+        const int code = this->CheckPlaybackRange(params->m_range);
+        if (code != FUNCTOR_CONTINUE) return code;
+        // No end time yet means that this is the first measure of the range, with which the output starts
+        params->m_isRangeStart = (params->m_scoreTimeEnd < 0.0);
+        if (params->m_isRangeStart) params->m_scoreTimeStart = m_scoreTimeOffset.back();
+        params->m_scoreTimeEnd = m_scoreTimeOffset.back() + this->GetScoreTimeDuration();
+    }
+
     // Here we need to update the m_totalTime from the starting time of the measure.
-    params->m_totalTime = m_scoreTimeOffset.back();
+    params->m_totalTime = m_scoreTimeOffset.back() - params->m_scoreTimeStart;
 
     if (m_currentTempo != params->m_currentTempo) {
-        params->m_midiFile->addTempo(0, m_scoreTimeOffset.back() * params->m_midiFile->getTPQ(), m_currentTempo);
+        params->m_midiFile->addTempo(0, params->m_totalTime * params->m_midiFile->getTPQ(), m_currentTempo);
         params->m_currentTempo = m_currentTempo;
     }
 
+    if (params->m_schedule) {
+        params->m_schedule->AddMeasure(
+            this, m_scoreTimeOffset.back(), m_realTimeOffsetMilliseconds.back(), m_currentTempo);
+    }
+
     return FUNCTOR_CONTINUE;
 }
 
@@ -1202,6 +1250,11 @@ int Measure::GenerateTimemap(FunctorParams *functorParams)
     GenerateTimemapParams *params = vrv_params_cast<GenerateTimemapParams *>(functorParams);
     assert(params);
 
+    if (params->m_range.IsSet()) {
+        const int code = this->CheckPlaybackRange(params->m_range);
+        if (code != FUNCTOR_CONTINUE) return code;
+    }
+
     // Deal with repeated music later, for now get the last times.
     params->m_scoreTimeOffset = m_scoreTimeOffset.back();
     params->m_realTimeOffsetMilliseconds = m_realTimeOffsetMilliseconds.back();
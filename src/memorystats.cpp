@@ -0,0 +1,87 @@
+/////////////////////////////////////////////////////////////////////////////
+// Name:        memorystats.cpp
+// Author:      agent
+// Created:     2026
+// Copyright (c) Authors and others. All rights reserved.
+/////////////////////////////////////////////////////////////////////////////
+
+#include "memorystats.h"
+
+//----------------------------------------------------------------------------
+
+#include <assert.h>
+
+//----------------------------------------------------------------------------
+
+#include "object.h"
+#include "objectarena.h"
+
+namespace vrv {
+
+//----------------------------------------------------------------------------
+// MemoryStats
+//----------------------------------------------------------------------------
+
+MemoryStats::MemoryStats() {}
+
+MemoryStats::~MemoryStats() {}
+
+void MemoryStats::Reset()
+{
+    m_objects.clear();
+    m_structures.clear();
+}
+
+void MemoryStats::AddObject(const Object *object, size_t size)
+{
+    assert(object);
+
+    Entry &entry = m_objects[object->GetClassName()];
+    ++entry.m_count;
+    entry.m_size += size;
+}
+
+void MemoryStats::AddDescendants(const Object *object, const std::string &structure)
+{
+    assert(object);
+
+    // The children of a reference object are owned elsewhere
+    if (object->IsReferenceObject()) return;
+
+    for (Object *child : object->GetChildRange()) {
+        if (structure.empty()) {
+            this->AddObject(child, GetAllocatedSize(child));
+        }
+        else {
+            this->AddStructure(structure, 1, GetAllocatedSize(child));
+        }
+        this->AddDescendants(child, structure);
+    }
+}
+
+void MemoryStats::AddStructure(const std::string &structure, int count, size_t size)
+{
+    Entry &entry = m_structures[structure];
+    entry.m_count += count;
+    entry.m_size += size;
+}
+
+size_t MemoryStats::GetAllocatedSize(const BoundingBox *boundingBox)
+{
+    assert(boundingBox);
+
+    // The block starts at the most derived object
+    return ObjectArena::GetBlockSize(dynamic_cast<const void *>(boundingBox));
+}
+
+MemoryStats::Entry MemoryStats::GetTotal(const std::map<std::string, Entry> &entries)
+{
+    Entry total;
+    for (auto const &entry : entries) {
+        total.m_count += entry.second.m_count;
+        total.m_size += entry.second.m_size;
+    }
+    return total;
+}
+
+} // namespace vrv
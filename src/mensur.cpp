@@ -62,18 +62,4 @@ void Mensur::Reset()
     ResetStaffLoc();
 }
 
-//----------------------------------------------------------------------------
-// Functors methods
-//----------------------------------------------------------------------------
-
-int Mensur::LayerCountInTimeSpan(FunctorParams *functorParams)
-{
-    LayerCountInTimeSpanParams *params = vrv_params_cast<LayerCountInTimeSpanParams *>(functorParams);
-    assert(params);
-
-    params->m_mensur = this;
-
-    return FUNCTOR_CONTINUE;
-}
-
 } // namespace vrv
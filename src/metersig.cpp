@@ -40,18 +40,4 @@ void MeterSig::Reset()
     ResetMeterSigVis();
 }
 
-//----------------------------------------------------------------------------
-// Functors methods
-//----------------------------------------------------------------------------
-
-int MeterSig::LayerCountInTimeSpan(FunctorParams *functorParams)
-{
-    LayerCountInTimeSpanParams *params = vrv_params_cast<LayerCountInTimeSpanParams *>(functorParams);
-    assert(params);
-
-    params->m_meterSig = this;
-
-    return FUNCTOR_CONTINUE;
-}
-
 } // namespace vrv
@@ -0,0 +1,153 @@
+/////////////////////////////////////////////////////////////////////////////
+// Name:        midiwriter.cpp
+// Author:      agent
+// Created:     2026
+// Copyright (c) Authors and others. All rights reserved.
+/////////////////////////////////////////////////////////////////////////////
+
+#include "midiwriter.h"
+
+//----------------------------------------------------------------------------
+
+#include <assert.h>
+#include <functional>
+#include <queue>
+
+//----------------------------------------------------------------------------
+
+#include "MidiFile.h"
+
+namespace vrv {
+
+//----------------------------------------------------------------------------
+// MIDIWriter
+//----------------------------------------------------------------------------
+
+MIDIWriter::MIDIWriter() {}
+
+MIDIWriter::~MIDIWriter() {}
+
+void MIDIWriter::Write(const smf::MidiFile &midiFile, std::string &output)
+{
+    assert(midiFile.isAbsoluteTicks());
+
+    const int trackCount = midiFile.getTrackCount();
+
+    output.append("MThd");
+    WriteBigEndian(6, 4, output);
+    WriteBigEndian((trackCount == 1) ? 0 : 1, 2, output);
+    WriteBigEndian(trackCount, 2, output);
+    WriteBigEndian(midiFile.getTicksPerQuarterNote(), 2, output);
+
+    for (int i = 0; i < trackCount; ++i) {
+        this->WriteTrack(midiFile[i], output);
+    }
+}
+
+void MIDIWriter::WriteTrack(const smf::MidiEventList &track, std::string &output)
+{
+    const int eventCount = track.getEventCount();
+
+    // Split the track into runs of events in order
+    m_keys.resize(eventCount);
+    m_runs.clear();
+    for (int i = 0; i < eventCount; ++i) {
+        m_keys.at(i) = GetEventKey(track[i].tick, track[i]);
+        if ((i == 0) || (m_keys.at(i) < m_keys.at(i - 1))) {
+            if (!m_runs.empty()) m_runs.back().m_end = i;
+            m_runs.push_back({ i, eventCount });
+        }
+    }
+
+    output.append("MTrk");
+    const size_t sizePosition = output.size();
+    WriteBigEndian(0, 4, output);
+    const size_t dataPosition = output.size();
+
+    // Merge the runs by key, and by run for equal keys so that simultaneous events remain in the document order
+    typedef std::pair<int64_t, int> RunHead;
+    std::priority_queue<RunHead, std::vector<RunHead>, std::greater<RunHead> > heads;
+    for (int run = 0; run < (int)m_runs.size(); ++run) {
+        heads.push({ m_keys.at(m_runs.at(run).m_current), run });
+    }
+
+    int tick = 0;
+    while (!heads.empty()) {
+        const int runIndex = heads.top().second;
+        heads.pop();
+        EventRun &run = m_runs.at(runIndex);
+        const smf::MidiEvent &event = track[run.m_current];
+        ++run.m_current;
+        if (run.m_current < run.m_end) heads.push({ m_keys.at(run.m_current), runIndex });
+
+        // Empty events are not written, and the end of track is added after the last event
+        if (event.empty() || event.isEndOfTrack()) continue;
+
+        WriteVLValue(event.tick - tick, output);
+        tick = event.tick;
+        // A sysex is written with the length of the message after its first byte
+        if ((event.getCommandByte() == 0xf0) || (event.getCommandByte() == 0xf7)) {
+            output.push_back(event[0]);
+            WriteVLValue((int)event.size() - 1, output);
+            output.append(event.begin() + 1, event.end());
+        }
+        else {
+            output.append(event.begin(), event.end());
+        }
+    }
+
+    // The end of track is always the last event
+    output.append({ 0x00, (char)0xff, 0x2f, 0x00 });
+
+    std::string chunkSize;
+    WriteBigEndian((uint32_t)(output.size() - dataPosition), 4, chunkSize);
+    output.replace(sizePosition, 4, chunkSize);
+}
+
+int64_t MIDIWriter::GetEventKey(int tick, const std::vector<unsigned char> &message)
+{
+    // The order of the event types follows the comparison of smf::MidiEventList::sort
+    int type = 1;
+    int controller = 0;
+    const unsigned char command = (message.empty()) ? 0 : message.at(0);
+    if (command == 0xff) {
+        // Meta messages come first, except the end of track which comes last
+        type = ((message.size() > 1) && (message.at(1) == 0x2f)) ? 4 : 0;
+    }
+    else if (((command & 0xf0) == 0x90) && (message.size() > 2) && (message.at(2) != 0)) {
+        type = 3;
+    }
+    else if (((command & 0xf0) == 0x90) || ((command & 0xf0) == 0x80)) {
+        type = 2;
+    }
+    else if (((command & 0xf0) == 0xb0) && (message.size() > 2)) {
+        // Controllers are ordered by number and value (e.g., a pedal off before a pedal on)
+        controller = ((message.at(1) << 8) | message.at(2)) + 1;
+    }
+
+    return ((int64_t)tick << 20) | (type << 16) | controller;
+}
+
+void MIDIWriter::WriteVLValue(int value, std::string &output)
+{
+    // Values are limited to four bytes
+    unsigned char bytes[4];
+    int count = 0;
+    uint32_t remaining = ((uint32_t)value < (1 << 28)) ? (uint32_t)value : 0x0fffffff;
+    bytes[count++] = remaining & 0x7f;
+    while (remaining >>= 7) {
+        bytes[count++] = (remaining & 0x7f) | 0x80;
+    }
+    while (count > 0) {
+        output.push_back(bytes[--count]);
+    }
+}
+
+void MIDIWriter::WriteBigEndian(uint32_t value, int byteCount, std::string &output)
+{
+    for (int shift = (byteCount - 1) * 8; shift >= 0; shift -= 8) {
+        output.push_back((value >> shift) & 0xff);
+    }
+}
+
+} // namespace vrv
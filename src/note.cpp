@@ -24,6 +24,7 @@
 #include "glyph.h"
 #include "layer.h"
 #include "ligature.h"
+#include "measure.h"
 #include "plica.h"
 #include "slur.h"
 #include "smufl.h"
@@ -84,6 +85,15 @@ Note::Note()
 
 Note::~Note() {}
 
+void Note::CloneReset()
+{
+    LayerElement::CloneReset();
+
+    // The cluster belongs to the original chord
+    m_cluster = NULL;
+    m_clusterPosition = 0;
+}
+
 void Note::Reset()
 {
     LayerElement::Reset();
@@ -510,6 +520,23 @@ double Note::GetScoreTimeTiedDuration()
     return m_scoreTimeTiedDuration;
 }
 
+double Note::GetFollowingTiedDuration()
+{
+    double duration = 0.0;
+    Note *note = this;
+    // Ties are looked for in the measure of their start note
+    while (Measure *measure = dynamic_cast<Measure *>(note->GetFirstAncestor(MEASURE))) {
+        PointingToComparison pointingToComparison(TIE, note);
+        Tie *tie = dynamic_cast<Tie *>(measure->FindDescendantByComparison(&pointingToComparison, 1));
+        if (!tie) break;
+        Note *next = dynamic_cast<Note *>(tie->GetEnd());
+        if (!next || (next == note)) break;
+        duration += next->GetScoreTimeDuration();
+        note = next;
+    }
+    return duration;
+}
+
 double Note::GetScoreTimeDuration()
 {
     return GetScoreTimeOffset() - GetScoreTimeOnset();
@@ -1157,8 +1184,13 @@ int Note::GenerateMIDI(FunctorParams *functorParams)
     assert(note);
 
     // If the note is a secondary tied note, then ignore it
-    if (note->GetScoreTimeTiedDuration() < 0.0) {
-        return FUNCTOR_SIBLINGS;
+    // Unless the tie comes from before the range being output, in which case it is played for the rest of the tie
+    double tiedDuration = note->GetScoreTimeTiedDuration();
+    if (tiedDuration < 0.0) {
+        if (!params->m_isRangeStart || (note->GetScoreTimeOnset() > 0.0)) {
+            return FUNCTOR_SIBLINGS;
+        }
+        tiedDuration = note->GetFollowingTiedDuration();
     }
 
     // For now just ignore grace notes
@@ -1204,13 +1236,15 @@ int Note::GenerateMIDI(FunctorParams *functorParams)
     if (note->HasVel()) velocity = note->GetVel();
 
     double starttime = params->m_totalTime + note->GetScoreTimeOnset();
-    double stoptime = params->m_totalTime + note->GetScoreTimeOffset() + note->GetScoreTimeTiedDuration();
+    double stoptime = params->m_totalTime + note->GetScoreTimeOffset() + tiedDuration;
 
     int tpq = params->m_midiFile->getTPQ();
 
     params->m_midiFile->addNoteOn(params->m_midiTrack, starttime * tpq, channel, pitch, velocity);
     params->m_midiFile->addNoteOff(params->m_midiTrack, stoptime * tpq, channel, pitch);
 
+    if (params->m_schedule) params->m_schedule->AddNote(this, starttime, stoptime, pitch, velocity, channel);
+
     return FUNCTOR_SIBLINGS;
 }
 
@@ -1228,21 +1262,9 @@ int Note::GenerateTimemap(FunctorParams *functorParams)
     double realTimeEnd = params->m_realTimeOffsetMilliseconds + note->GetRealTimeOffsetMilliseconds();
     double scoreTimeEnd = params->m_scoreTimeOffset + note->GetScoreTimeOffset();
 
-    // Should check if value for realTimeStart already exists and if so, then
-    // ensure that it is equal to scoreTimeStart:
-    params->realTimeToScoreTime[realTimeStart] = scoreTimeStart;
-
-    // Store the element ID in list to turn on at given time.
-    params->realTimeToOnElements[realTimeStart].push_back(this->GetUuid());
-
-    // Should check if value for realTimeEnd already exists and if so, then
-    // ensure that it is equal to scoreTimeEnd:
-    params->realTimeToScoreTime[realTimeEnd] = scoreTimeEnd;
-
-    // Store the element ID in list to turn off at given time.
-    params->realTimeToOffElements[realTimeEnd].push_back(this->GetUuid());
-
-    params->realTimeToTempo[realTimeStart] = params->m_currentTempo;
+    // Store the element to turn on and off at given times, sorted by real time once all are collected
+    params->m_events.push_back({ realTimeStart, scoreTimeStart, params->m_currentTempo, true, this });
+    params->m_events.push_back({ realTimeEnd, scoreTimeEnd, params->m_currentTempo, false, this });
 
     return FUNCTOR_SIBLINGS;
 }
@@ -11,8 +11,10 @@
 
 #include <assert.h>
 #include <climits>
+#include <deque>
 #include <iostream>
 #include <math.h>
+#include <mutex>
 #include <sstream>
 
 //----------------------------------------------------------------------------
@@ -52,6 +54,139 @@
 
 namespace vrv {
 
+//----------------------------------------------------------------------------
+// ObjectMetadata
+//----------------------------------------------------------------------------
+
+/** The mutex protecting the creation of the interned metadata, which are shared by all the documents */
+static std::mutex s_metadataMutex;
+
+/** The number of lists the metadata with only the uuid prefix are spread over */
+#define METADATA_ROOT_LISTS 64
+
+ObjectMetadata::ObjectMetadata(const std::string &classid) : m_next(NULL)
+{
+    m_classid = classid;
+}
+
+const ObjectMetadata *ObjectMetadata::Get(const std::string &classid)
+{
+    static std::atomic<const Entry *> s_roots[METADATA_ROOT_LISTS];
+
+    std::atomic<const Entry *> &roots = s_roots[std::hash<std::string>()(classid) % METADATA_ROOT_LISTS];
+    auto find = [&classid](const Entry *entry) -> const ObjectMetadata * {
+        for (; entry; entry = entry->m_next) {
+            if (entry->m_metadata->m_classid == classid) return entry->m_metadata;
+        }
+        return NULL;
+    };
+
+    const ObjectMetadata *root = find(roots.load(std::memory_order_acquire));
+    if (root) return root;
+
+    // Look again once locked since another thread might have created it in the meantime
+    std::lock_guard<std::mutex> lock(s_metadataMutex);
+    const Entry *first = roots.load(std::memory_order_relaxed);
+    root = find(first);
+    if (!root) {
+        root = new ObjectMetadata(classid);
+        roots.store(new Entry{ 0, root, first }, std::memory_order_release);
+    }
+    return root;
+}
+
+const ObjectMetadata *ObjectMetadata::AddAttClass(AttClassId attClassId) const
+{
+    return this->GetNext(attClassId, [attClassId](ObjectMetadata *metadata) {
+        metadata->m_attClasses.set(attClassId);
+    });
+}
+
+const ObjectMetadata *ObjectMetadata::AddInterface(
+    const std::vector<AttClassId> *attClasses, InterfaceId interfaceId) const
+{
+    assert(attClasses);
+
+    // The att classes of an interface are always the same, so the interface is enough as key
+    return this->GetNext(ATT_CLASS_max + interfaceId, [attClasses, interfaceId](ObjectMetadata *metadata) {
+        for (AttClassId attClassId : *attClasses) metadata->m_attClasses.set(attClassId);
+        metadata->m_interfaces.set(interfaceId);
+    });
+}
+
+template <class FUNCTION> const ObjectMetadata *ObjectMetadata::GetNext(int key, FUNCTION addTo) const
+{
+    // The objects of a class always register the same att classes, so the list has usually only one entry
+    auto find = [key](const Entry *entry) -> const ObjectMetadata * {
+        for (; entry; entry = entry->m_next) {
+            if (entry->m_key == key) return entry->m_metadata;
+        }
+        return NULL;
+    };
+
+    const ObjectMetadata *next = find(m_next.load(std::memory_order_acquire));
+    if (next) return next;
+
+    std::lock_guard<std::mutex> lock(s_metadataMutex);
+    const Entry *first = m_next.load(std::memory_order_relaxed);
+    next = find(first);
+    if (next) return next;
+
+    ObjectMetadata *metadata = new ObjectMetadata(m_classid);
+    metadata->m_attClasses = m_attClasses;
+    metadata->m_interfaces = m_interfaces;
+    addTo(metadata);
+    m_next.store(new Entry{ key, metadata, first }, std::memory_order_release);
+    return metadata;
+}
+
+//----------------------------------------------------------------------------
+// ProcessFrame
+//----------------------------------------------------------------------------
+
+/**
+ * The state of an ancestor object on the stack of Object::Process, restored once its current child is processed.
+ * The deepness is the one left for the children once the object is entered.
+ */
+class ProcessFrame {
+public:
+    ProcessFrame(Object *object, int deepness, int next, bool processChildren)
+    {
+        m_object = object;
+        m_deepness = deepness;
+        m_next = next;
+        m_processChildren = processChildren;
+    }
+
+    Object *m_object;
+    int m_deepness;
+    int m_next;
+    bool m_processChildren;
+};
+
+/**
+ * Return true if the children of an object are hidden and must not be processed by a functor on visible objects only.
+ */
+static bool IsHiddenForProcessing(Object *object)
+{
+    if (object->IsEditorialElement()) {
+        EditorialElement *editorialElement = vrv_cast<EditorialElement *>(object);
+        assert(editorialElement);
+        return (editorialElement->m_visibility == Hidden);
+    }
+    else if (object->Is(MDIV)) {
+        Mdiv *mdiv = vrv_cast<Mdiv *>(object);
+        assert(mdiv);
+        return (mdiv->m_visibility == Hidden);
+    }
+    else if (object->IsSystemElement()) {
+        SystemElement *systemElement = vrv_cast<SystemElement *>(object);
+        assert(systemElement);
+        return (systemElement->m_visibility == Hidden);
+    }
+    return false;
+}
+
 //----------------------------------------------------------------------------
 // Object
 //----------------------------------------------------------------------------
@@ -86,7 +221,6 @@ Object::Object(const Object &object) : BoundingBox(object)
     ClearChildren();
     ResetBoundingBox(); // It does not make sense to keep the values of the BBox
 
-    m_classid = object.m_classid;
     m_parent = NULL;
 
     // Flags
@@ -94,9 +228,8 @@ Object::Object(const Object &object) : BoundingBox(object)
     m_isModified = true;
     m_isReferenceObject = object.m_isReferenceObject;
 
-    // Also copy attribute classes
-    m_attClasses = object.m_attClasses;
-    m_interfaces = object.m_interfaces;
+    // Also copy the uuid prefix and attribute classes
+    m_metadata = object.m_metadata;
     // New uuid
     this->GenerateUuid();
     // For now do not copy them
@@ -132,16 +265,14 @@ Object &Object::operator=(const Object &object)
         ClearChildren();
         ResetBoundingBox(); // It does not make sense to keep the values of the BBox
 
-        m_classid = object.m_classid;
         m_parent = NULL;
         // Flags
         m_isAttribute = object.m_isAttribute;
         m_isModified = true;
         m_isReferenceObject = object.m_isReferenceObject;
 
-        // Also copy attribute classes
-        m_attClasses = object.m_attClasses;
-        m_interfaces = object.m_interfaces;
+        // Also copy the uuid prefix and attribute classes
+        m_metadata = object.m_metadata;
         // New uuid
         this->GenerateUuid();
         // For now do now copy them
@@ -152,9 +283,11 @@ Object &Object::operator=(const Object &object)
             for (i = 0; i < (int)object.m_children.size(); ++i) {
                 Object *current = object.m_children.at(i);
                 Object *clone = current->Clone();
-                clone->SetParent(this);
-                clone->CloneReset();
-                m_children.push_back(clone);
+                if (clone) {
+                    clone->SetParent(this);
+                    clone->CloneReset();
+                    m_children.push_back(clone);
+                }
             }
         }
     }
@@ -168,15 +301,14 @@ Object::~Object()
 
 void Object::Init(const std::string &classid)
 {
-    m_classid = classid;
+    m_metadata = ObjectMetadata::Get(classid);
     m_parent = NULL;
     // Flags
     m_isAttribute = false;
     m_isModified = true;
     m_isReferenceObject = false;
     // Comments
-    m_comment = "";
-    m_closingComment = "";
+    m_comments.reset();
 
     this->GenerateUuid();
 
@@ -205,8 +337,7 @@ void Object::Reset()
 
 void Object::RegisterInterface(std::vector<AttClassId> *attClasses, InterfaceId interfaceId)
 {
-    m_attClasses.insert(m_attClasses.end(), attClasses->begin(), attClasses->end());
-    m_interfaces.push_back(interfaceId);
+    m_metadata = m_metadata->AddInterface(attClasses, interfaceId);
 }
 
 bool Object::IsBoundaryElement()
@@ -300,6 +431,18 @@ void Object::SetUuid(std::string uuid)
     m_uuid = uuid;
 }
 
+void Object::SetComment(std::string comment)
+{
+    if (!m_comments) m_comments.reset(new Comments());
+    m_comments->m_comment = comment;
+}
+
+void Object::SetClosingComment(std::string endComment)
+{
+    if (!m_comments) m_comments.reset(new Comments());
+    m_comments->m_closingComment = endComment;
+}
+
 void Object::SwapUuid(Object *other)
 {
     assert(other);
@@ -376,19 +519,10 @@ bool Object::HasAttribute(std::string attribute, std::string value) const
     return false;
 }
 
-Object *Object::GetFirst(const ClassId classId)
+Object *Object::GetFirst(const ClassId classId) const
 {
-    m_iteratorElementType = classId;
-    m_iteratorEnd = m_children.end();
-    m_iteratorCurrent = std::find_if(m_children.begin(), m_iteratorEnd, ObjectComparison(m_iteratorElementType));
-    return (m_iteratorCurrent == m_iteratorEnd) ? NULL : *m_iteratorCurrent;
-}
-
-Object *Object::GetNext()
-{
-    m_iteratorCurrent++;
-    m_iteratorCurrent = std::find_if(m_iteratorCurrent, m_iteratorEnd, ObjectComparison(m_iteratorElementType));
-    return (m_iteratorCurrent == m_iteratorEnd) ? NULL : *m_iteratorCurrent;
+    ArrayOfObjects::const_iterator iter = std::find_if(m_children.begin(), m_children.end(), ObjectComparison(classId));
+    return (iter == m_children.end()) ? NULL : *iter;
 }
 
 Object *Object::GetNext(const Object *child, const ClassId classId)
@@ -589,7 +723,7 @@ void Object::GenerateUuid()
     // I do not want to use a stream for doing this!
     snprintf(str, 17, "%016d", nr);
 
-    m_uuid = m_classid + std::string(str);
+    m_uuid = m_metadata->GetClassid() + std::string(str);
 }
 
 void Object::ResetUuid()
@@ -624,7 +758,7 @@ bool Object::IsSupportedChild(Object *child)
 
 void Object::AddChild(Object *child)
 {
-    if (!((child->GetClassName() == "Staff") && (this->GetClassName() == "Section"))) {
+    if (!(child->Is(STAFF) && this->Is(SECTION))) {
         // temporarily allowing staff in section for issue https://github.com/MeasuringPolyphony/mp_editor/issues/62
         if (!this->IsSupportedChild(child)) {
             LogError("Adding '%s' to a '%s'", child->GetClassName().c_str(), this->GetClassName().c_str());
@@ -778,94 +912,121 @@ void Object::Process(Functor *functor, FunctorParams *functorParams, Functor *en
         return;
     }
 
-    bool processChildren = true;
-    if (functor->m_visibleOnly) {
-        if (this->IsEditorialElement()) {
-            EditorialElement *editorialElement = vrv_cast<EditorialElement *>(this);
-            assert(editorialElement);
-            if (editorialElement->m_visibility == Hidden) {
-                processChildren = false;
-            }
-        }
-        else if (this->Is(MDIV)) {
-            Mdiv *mdiv = vrv_cast<Mdiv *>(this);
-            assert(mdiv);
-            if (mdiv->m_visibility == Hidden) {
-                processChildren = false;
-            }
-        }
-        else if (this->IsSystemElement()) {
-            SystemElement *systemElement = vrv_cast<SystemElement *>(this);
-            assert(systemElement);
-            if (systemElement->m_visibility == Hidden) {
-                processChildren = false;
-            }
+    const bool hasFilters = (filters && !filters->empty());
+
+    // The tree is traversed with an explicit stack so deeply nested objects cannot overflow the call stack
+    // Functors can call Process again, so we keep one stack per nesting level and reuse them between the calls
+    thread_local std::deque<std::vector<ProcessFrame>> s_stacks;
+    thread_local size_t s_nesting = 0;
+    if (s_stacks.size() <= s_nesting) s_stacks.emplace_back();
+    std::vector<ProcessFrame> &stack = s_stacks[s_nesting];
+
+    // The filters are looked up by ClassId in a table filled for the call, with the first filter of each class
+    thread_local std::deque<std::vector<Comparison *>> s_filterTables;
+    if (s_filterTables.size() <= s_nesting) s_filterTables.emplace_back(UNSPECIFIED + 1, (Comparison *)NULL);
+    std::vector<Comparison *> &filterTable = s_filterTables[s_nesting];
+    if (hasFilters) {
+        for (auto iter = filters->rbegin(); iter != filters->rend(); ++iter) {
+            ClassIdComparison *classIdComparison = vrv_cast<ClassIdComparison *>(*iter);
+            assert(classIdComparison);
+            filterTable.at(classIdComparison->GetType()) = *iter;
         }
     }
+    ++s_nesting;
 
-    functor->Call(this, functorParams);
+    // The current frame is kept in local variables and only the ancestors are on the stack
+    Object *object = this;
+    int next = 0;
+    bool processChildren = true;
+    bool entering = true;
+
+    while (true) {
+        bool done = false;
+        if (entering) {
+            entering = false;
+            if (functor->m_returnCode == FUNCTOR_STOP) {
+                done = true;
+            }
+            else {
+                processChildren = (!functor->m_visibleOnly || !IsHiddenForProcessing(object));
 
-    // do not go any deeper in this case
-    if (functor->m_returnCode == FUNCTOR_SIBLINGS) {
-        functor->m_returnCode = FUNCTOR_CONTINUE;
-        return;
-    }
-    else if (this->IsEditorialElement()) {
-        // since editorial object doesn't count, we increase the deepness limit
-        deepness++;
-    }
-    if (deepness == 0) {
-        // any need to change the functor m_returnCode?
-        return;
-    }
-    deepness--;
-
-    if (processChildren) {
-        auto filterPredicate = [filters](Object *iter) -> bool {
-            if (filters && !filters->empty()) {
-                // first we look if there is a comparison object for the object type (e.g., a Staff)
-                ClassId classId = iter->GetClassId();
-                ArrayOfComparisons::iterator comparisonIter
-                    = std::find_if(filters->begin(), filters->end(), [classId](Comparison *iter) -> bool {
-                          ClassIdComparison *attComparison = vrv_cast<ClassIdComparison *>(iter);
-                          assert(attComparison);
-                          return classId == attComparison->GetType();
-                      });
-
-                if (comparisonIter != filters->end()) {
-                    // use the operator of the Comparison object to evaluate the attribute
-                    if (!(**comparisonIter)(iter)) {
-                        // the attribute value doesn't match
-                        return false;
-                    }
+                functor->Call(object, functorParams);
+
+                // do not go any deeper in this case
+                if (functor->m_returnCode == FUNCTOR_SIBLINGS) {
+                    functor->m_returnCode = FUNCTOR_CONTINUE;
+                    done = true;
                 }
-            }
-            return true;
-        };
-
-        // We need a pointer to the array for the option to work on a reversed copy
-        ArrayOfObjects *children = &this->m_children;
-        if (direction == BACKWARD) {
-            for (ArrayOfObjects::reverse_iterator iter = children->rbegin(); iter != children->rend(); ++iter) {
-                // we will end here if there is no filter at all or for the current child type
-                if (filterPredicate(*iter)) {
-                    (*iter)->Process(functor, functorParams, endFunctor, filters, deepness, direction);
+                else {
+                    if (object->IsEditorialElement()) {
+                        // since editorial object doesn't count, we increase the deepness limit
+                        deepness++;
+                    }
+                    if (deepness == 0) {
+                        done = true;
+                    }
+                    else {
+                        deepness--;
+                        // When going backward, the next child index counts down from the end
+                        next = (direction == BACKWARD) ? (int)object->m_children.size() : 0;
+                    }
                 }
             }
         }
-        else {
-            for (ArrayOfObjects::iterator iter = children->begin(); iter != children->end(); ++iter) {
-                // we will end here if there is no filter at all or for the current child type
-                if (filterPredicate(*iter)) {
-                    (*iter)->Process(functor, functorParams, endFunctor, filters, deepness, direction);
+
+        if (!done) {
+            // Look for the next child to process - children can be added by the functors while we iterate
+            // Once the functor is stopped, the remaining children would not be processed anyway
+            Object *child = NULL;
+            if (processChildren && (functor->m_returnCode != FUNCTOR_STOP)) {
+                const ArrayOfObjects &children = object->m_children;
+                while (!child) {
+                    if (direction == BACKWARD) {
+                        if (next <= 0) break;
+                        child = children[--next];
+                    }
+                    else {
+                        if (next >= (int)children.size()) break;
+                        child = children[next++];
+                    }
+                    // we will end here if there is no filter at all or for the current child type
+                    if (hasFilters) {
+                        // use the operator of the Comparison object for the object type (e.g., a Staff) if any
+                        Comparison *filter = filterTable[child->GetClassId()];
+                        if (filter && !(*filter)(child)) child = NULL;
+                    }
                 }
             }
+
+            if (child) {
+                stack.push_back(ProcessFrame(object, deepness, next, processChildren));
+                object = child;
+                entering = true;
+                continue;
+            }
+
+            // All children are processed
+            if (endFunctor) {
+                endFunctor->Call(object, functorParams);
+            }
         }
+
+        // Go back to the parent
+        if (stack.empty()) break;
+        const ProcessFrame &frame = stack.back();
+        object = frame.m_object;
+        deepness = frame.m_deepness;
+        next = frame.m_next;
+        processChildren = frame.m_processChildren;
+        stack.pop_back();
     }
 
-    if (endFunctor) {
-        endFunctor->Call(this, functorParams);
+    if (hasFilters) {
+        for (Comparison *filter : *filters) {
+            filterTable.at(vrv_cast<ClassIdComparison *>(filter)->GetType()) = NULL;
+        }
     }
+    --s_nesting;
 }
 
 int Object::Save(Output *output)
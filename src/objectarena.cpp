@@ -0,0 +1,229 @@
+/////////////////////////////////////////////////////////////////////////////
+// Name:        objectarena.cpp
+// Author:      agent
+// Created:     2026
+// Copyright (c) Authors and others. All rights reserved.
+/////////////////////////////////////////////////////////////////////////////
+
+#include "objectarena.h"
+
+//----------------------------------------------------------------------------
+
+#include <algorithm>
+#include <assert.h>
+#include <atomic>
+#include <mutex>
+#include <new>
+
+#if defined(__APPLE__)
+#include <malloc/malloc.h>
+#elif defined(__GLIBC__) || defined(__EMSCRIPTEN__) || defined(_WIN32)
+#include <malloc.h>
+#endif
+
+namespace vrv {
+
+/**
+ * The header at the beginning of each arena block, padded to keep the objects aligned.
+ * Blocks allocated from the heap have no header.
+ */
+struct BlockHeader {
+    ObjectArena *m_arena;
+    int m_sizeClass;
+    unsigned int m_size;
+};
+
+static const size_t BLOCK_HEADER_SIZE = 16;
+static_assert(sizeof(BlockHeader) <= BLOCK_HEADER_SIZE, "The block header does not fit in its padding");
+
+/** The current arena for each thread */
+static thread_local ObjectArena *s_currentArena = NULL;
+
+/**
+ * The chunks of all the arenas, sorted by address, for finding whether a block is in an arena.
+ * It is shared by all the threads because a document can be deleted or modified by another thread than the one
+ * that loaded it. The count is zero as long as no arena allocates a block, in which case all the blocks are from the
+ * heap and the registry is not locked.
+ */
+static std::mutex s_arenaChunksMutex;
+static std::vector<const char *> s_arenaChunks;
+static std::atomic<int> s_arenaChunkCount(0);
+
+static bool IsArenaBlock(const void *ptr)
+{
+    if (s_arenaChunkCount.load() == 0) return false;
+
+    const char *block = static_cast<const char *>(ptr);
+    std::lock_guard<std::mutex> lock(s_arenaChunksMutex);
+    auto iter = std::upper_bound(s_arenaChunks.begin(), s_arenaChunks.end(), block);
+    if (iter == s_arenaChunks.begin()) return false;
+    --iter;
+    return (block < *iter + ObjectArena::CHUNK_SIZE);
+}
+
+static void AddArenaChunk(const char *chunk)
+{
+    std::lock_guard<std::mutex> lock(s_arenaChunksMutex);
+    s_arenaChunks.insert(std::upper_bound(s_arenaChunks.begin(), s_arenaChunks.end(), chunk), chunk);
+    s_arenaChunkCount.store((int)s_arenaChunks.size());
+}
+
+static void RemoveArenaChunk(const char *chunk)
+{
+    std::lock_guard<std::mutex> lock(s_arenaChunksMutex);
+    auto iter = std::lower_bound(s_arenaChunks.begin(), s_arenaChunks.end(), chunk);
+    assert((iter != s_arenaChunks.end()) && (*iter == chunk));
+    if ((iter != s_arenaChunks.end()) && (*iter == chunk)) s_arenaChunks.erase(iter);
+    s_arenaChunkCount.store((int)s_arenaChunks.size());
+}
+
+//----------------------------------------------------------------------------
+// ObjectArena
+//----------------------------------------------------------------------------
+
+ObjectArena::ObjectArena()
+{
+    m_current = NULL;
+    m_end = NULL;
+    m_freeLists.resize(MAX_BLOCK_SIZE / BLOCK_ALIGNMENT + 1, NULL);
+    m_objectCount = 0;
+    m_isReleased = false;
+}
+
+ObjectArena::~ObjectArena()
+{
+    assert(m_objectCount == 0);
+
+    this->Clear();
+}
+
+bool ObjectArena::Clear()
+{
+    if (m_objectCount > 0) return false;
+
+    for (char *chunk : m_chunks) {
+        RemoveArenaChunk(chunk);
+        delete[] chunk;
+    }
+    m_chunks.clear();
+    std::fill(m_freeLists.begin(), m_freeLists.end(), (void *)NULL);
+    m_current = NULL;
+    m_end = NULL;
+
+    return true;
+}
+
+void ObjectArena::Release()
+{
+    m_isReleased = true;
+    if (m_objectCount == 0) delete this;
+}
+
+ObjectArena *ObjectArena::GetCurrent()
+{
+    return s_currentArena;
+}
+
+void *ObjectArena::AllocateBlock(size_t size)
+{
+    const size_t blockSize = size + BLOCK_HEADER_SIZE;
+    ObjectArena *arena = s_currentArena;
+
+    // Without arena (or for large blocks) the block is a plain heap block
+    if (!arena || (blockSize > MAX_BLOCK_SIZE)) return ::operator new(size);
+
+    const int sizeClass = (int)((blockSize + BLOCK_ALIGNMENT - 1) / BLOCK_ALIGNMENT);
+    BlockHeader *header = static_cast<BlockHeader *>(arena->Allocate(sizeClass));
+    header->m_arena = arena;
+    header->m_sizeClass = sizeClass;
+    header->m_size = (unsigned int)size;
+
+    return reinterpret_cast<char *>(header) + BLOCK_HEADER_SIZE;
+}
+
+void ObjectArena::DeallocateBlock(void *ptr)
+{
+    if (!ptr) return;
+
+    if (!IsArenaBlock(ptr)) {
+        ::operator delete(ptr);
+        return;
+    }
+
+    BlockHeader *header = reinterpret_cast<BlockHeader *>(static_cast<char *>(ptr) - BLOCK_HEADER_SIZE);
+    header->m_arena->Deallocate(header, header->m_sizeClass);
+}
+
+size_t ObjectArena::GetBlockSize(const void *ptr)
+{
+    assert(ptr);
+
+    if (IsArenaBlock(ptr)) {
+        const BlockHeader *header
+            = reinterpret_cast<const BlockHeader *>(static_cast<const char *>(ptr) - BLOCK_HEADER_SIZE);
+        return header->m_size;
+    }
+
+    // The size of heap blocks is the one given by the allocator (which includes its padding)
+#if defined(__APPLE__)
+    return malloc_size(ptr);
+#elif defined(__GLIBC__) || defined(__EMSCRIPTEN__)
+    return malloc_usable_size(const_cast<void *>(ptr));
+#elif defined(_WIN32)
+    return _msize(const_cast<void *>(ptr));
+#else
+    return 0;
+#endif
+}
+
+void *ObjectArena::Allocate(int sizeClass)
+{
+    ++m_objectCount;
+
+    // Reuse a block of the same size deleted before
+    void *block = m_freeLists.at(sizeClass);
+    if (block) {
+        m_freeLists.at(sizeClass) = *static_cast<void **>(block);
+        return block;
+    }
+
+    // Otherwise bump the pointer, the end of a chunk too small for the block is left unused
+    const size_t blockSize = sizeClass * BLOCK_ALIGNMENT;
+    if (!m_current || ((size_t)(m_end - m_current) < blockSize)) {
+        m_current = new char[CHUNK_SIZE];
+        m_end = m_current + CHUNK_SIZE;
+        m_chunks.push_back(m_current);
+        AddArenaChunk(m_current);
+    }
+    block = m_current;
+    m_current += blockSize;
+    return block;
+}
+
+void ObjectArena::Deallocate(void *block, int sizeClass)
+{
+    assert(m_objectCount > 0);
+
+    *static_cast<void **>(block) = m_freeLists.at(sizeClass);
+    m_freeLists.at(sizeClass) = block;
+
+    --m_objectCount;
+    if (m_isReleased && (m_objectCount == 0)) delete this;
+}
+
+//----------------------------------------------------------------------------
+// ObjectArenaScope
+//----------------------------------------------------------------------------
+
+ObjectArenaScope::ObjectArenaScope(ObjectArena *arena)
+{
+    m_previous = s_currentArena;
+    s_currentArena = arena;
+}
+
+ObjectArenaScope::~ObjectArenaScope()
+{
+    s_currentArena = m_previous;
+}
+
+} // namespace vrv
@@ -655,6 +655,10 @@ Options::Options()
     m_landscape.Init(false);
     this->Register(&m_landscape, "landscape", &m_general);
 
+    m_memoryStats.SetInfo("Memory stats", "Collect memory usage statistics after each processing phase");
+    m_memoryStats.Init(false);
+    this->Register(&m_memoryStats, "memoryStats", &m_general);
+
     m_mensuralToMeasure.SetInfo("Mensural to measure", "Convert mensural sections to measure-based MEI");
     m_mensuralToMeasure.Init(false);
     this->Register(&m_mensuralToMeasure, "mensuralToMeasure", &m_general);
@@ -750,6 +754,10 @@ Options::Options()
     m_unit.Init(9, 6, 20, true);
     this->Register(&m_unit, "unit", &m_general);
 
+    m_useArena.SetInfo("Use arena", "Allocate the objects of the document from per-document memory arenas");
+    m_useArena.Init(false);
+    this->Register(&m_useArena, "useArena", &m_general);
+
     m_useBraceGlyph.SetInfo("Use Brace Glyph", "Use brace glyph from current font");
     m_useBraceGlyph.Init(false);
     this->Register(&m_useBraceGlyph, "useBraceGlyph", &m_general);
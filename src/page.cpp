@@ -59,6 +59,8 @@ void Page::Reset()
 
     m_drawingJustifiableHeight = 0;
     m_justificationSum = 0.;
+
+    m_spatialIndex.Reset();
 }
 
 bool Page::IsSupportedChild(Object *child)
@@ -119,6 +121,8 @@ void Page::LayOut(bool force)
         return;
     }
 
+    m_spatialIndex.Reset();
+
     this->LayOutHorizontally();
     this->JustifyHorizontally();
     this->LayOutVertically();
@@ -144,6 +148,8 @@ void Page::LayOutTranscription(bool force)
         return;
     }
 
+    m_spatialIndex.Reset();
+
     Doc *doc = vrv_cast<Doc *>(GetFirstAncestor(DOC));
     assert(doc);
 
@@ -210,6 +216,38 @@ void Page::LayOutTranscription(bool force)
     m_layoutDone = true;
 }
 
+const SpatialIndex *Page::GetSpatialIndex()
+{
+    Doc *doc = vrv_cast<Doc *>(GetFirstAncestor(DOC));
+    assert(doc);
+
+    // Doc::SetDrawingPage should have been called before
+    assert(this == doc->GetDrawingPage());
+
+    if (m_spatialIndex.IsBuilt()) return &m_spatialIndex;
+
+    // The bounding boxes are up-to-date only when they were filled after the justification in Page::LayOut
+    if (!doc->GetOptions()->m_svgBoundingBoxes.GetValue() || (doc->GetType() == Transcription)) {
+        View view;
+        view.SetDoc(doc);
+        BBoxDeviceContext bBoxDC(&view, 0, 0);
+        // Do not do the layout in this view - otherwise we will loop...
+        view.SetPage(this->GetIdx(), false);
+        view.DrawCurrentPage(&bBoxDC, false);
+    }
+
+    m_spatialIndex.Build(this, doc);
+
+    return &m_spatialIndex;
+}
+
+void Page::Modify(bool modified)
+{
+    if (modified && m_spatialIndex.IsBuilt()) m_spatialIndex.Reset();
+
+    Object::Modify(modified);
+}
+
 void Page::LayOutHorizontally()
 {
     Doc *doc = vrv_cast<Doc *>(GetFirstAncestor(DOC));
@@ -17,6 +17,7 @@
 #include "horizontalaligner.h"
 #include "layerelement.h"
 #include "smufl.h"
+#include "staff.h"
 #include "vrv.h"
 
 //----------------------------------------------------------------------------
@@ -93,17 +94,26 @@ int Pedal::GenerateMIDI(FunctorParams *functorParams)
     double starttime = params->m_totalTime + pedalTime;
     int tpq = params->m_midiFile->getTPQ();
 
+    // The pedal is processed once for the measure, so send it to the track of the staff it starts in
+    int midiTrack = params->m_midiTrack;
+    int midiChannel = params->m_midiChannel;
+    Staff *staff = vrv_cast<Staff *>(GetStart()->GetFirstAncestor(STAFF));
+    if (staff && (params->m_trackStates.count(staff->GetN()) > 0)) {
+        midiTrack = params->m_trackStates.at(staff->GetN()).m_midiTrack;
+        midiChannel = params->m_trackStates.at(staff->GetN()).m_midiChannel;
+    }
+
     // todo: check pedal @func to switch between sustain/soften/damper pedals?
     switch (GetDir()) {
         case pedalLog_DIR_down:
-            params->m_midiFile->addSustainPedalOn(params->m_midiTrack, (starttime * tpq), params->m_midiChannel);
+            params->m_midiFile->addSustainPedalOn(midiTrack, (starttime * tpq), midiChannel);
             break;
         case pedalLog_DIR_up:
-            params->m_midiFile->addSustainPedalOff(params->m_midiTrack, (starttime * tpq), params->m_midiChannel);
+            params->m_midiFile->addSustainPedalOff(midiTrack, (starttime * tpq), midiChannel);
             break;
         case pedalLog_DIR_bounce:
-            params->m_midiFile->addSustainPedalOff(params->m_midiTrack, (starttime * tpq), params->m_midiChannel);
-            params->m_midiFile->addSustainPedalOn(params->m_midiTrack, (starttime * tpq) + 0.1, params->m_midiChannel);
+            params->m_midiFile->addSustainPedalOff(midiTrack, (starttime * tpq), midiChannel);
+            params->m_midiFile->addSustainPedalOn(midiTrack, (starttime * tpq) + 0.1, midiChannel);
             break;
         default: return FUNCTOR_CONTINUE;
     }
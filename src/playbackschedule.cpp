@@ -0,0 +1,179 @@
+/////////////////////////////////////////////////////////////////////////////
+// Name:        playbackschedule.cpp
+// Author:      agent
+// Created:     2026
+// Copyright (c) Authors and others. All rights reserved.
+/////////////////////////////////////////////////////////////////////////////
+
+#include "playbackschedule.h"
+
+//----------------------------------------------------------------------------
+
+#include <algorithm>
+#include <assert.h>
+#include <map>
+
+//----------------------------------------------------------------------------
+
+#include "measure.h"
+#include "note.h"
+#include "page.h"
+
+namespace vrv {
+
+//----------------------------------------------------------------------------
+// PlaybackSchedule
+//----------------------------------------------------------------------------
+
+PlaybackSchedule::PlaybackSchedule()
+{
+    Reset();
+}
+
+PlaybackSchedule::~PlaybackSchedule() {}
+
+void PlaybackSchedule::Reset()
+{
+    m_events.clear();
+    m_anchors.clear();
+    m_currentMeasure = NULL;
+    m_currentPage = 0;
+    m_isBuilt = false;
+    m_hasPages = false;
+}
+
+void PlaybackSchedule::AddMeasure(Measure *measure, double scoreTimeOffset, double realTimeOffset, int tempo)
+{
+    assert(measure);
+
+    const int page = PlaybackSchedule::GetPageNumber(measure);
+    if (m_anchors.empty() || (m_anchors.back().m_tempo != tempo)) {
+        m_events.push_back(
+            { realTimeOffset, scoreTimeOffset, PLAYBACK_TEMPO, NULL, measure, page, tempo, 0, 0, 0 });
+    }
+    m_anchors.push_back({ scoreTimeOffset, realTimeOffset, tempo });
+    m_currentMeasure = measure;
+    m_currentPage = page;
+}
+
+void PlaybackSchedule::AddNote(
+    Note *note, double scoreTimeOnset, double scoreTimeOffset, int pitch, int velocity, int channel)
+{
+    assert(note);
+    assert(!m_anchors.empty());
+
+    const int tempo = m_anchors.back().m_tempo;
+    // Real times are set by Finalize once all the measures are known
+    m_events.push_back({ 0.0, scoreTimeOnset, PLAYBACK_NOTE_ON, note, m_currentMeasure, m_currentPage, tempo,
+        (char)pitch, (char)velocity, (char)channel });
+    m_events.push_back({ 0.0, scoreTimeOffset, PLAYBACK_NOTE_OFF, note, m_currentMeasure, m_currentPage, tempo,
+        (char)pitch, (char)velocity, (char)channel });
+}
+
+void PlaybackSchedule::Finalize()
+{
+    // Measures are added in the document order, but keep the anchors sorted for the binary search anyway
+    std::stable_sort(m_anchors.begin(), m_anchors.end(),
+        [](const MeasureAnchor &a, const MeasureAnchor &b) { return a.m_scoreTime < b.m_scoreTime; });
+
+    for (auto &event : m_events) {
+        if (event.m_type != PLAYBACK_TEMPO) event.m_time = this->GetRealTime(event.m_scoreTime);
+    }
+
+    // Simultaneous events remain in the document order within each type
+    std::stable_sort(m_events.begin(), m_events.end(), [](const PlaybackEvent &a, const PlaybackEvent &b) {
+        if (a.m_time != b.m_time) return (a.m_time < b.m_time);
+        return (a.m_type < b.m_type);
+    });
+
+    m_isBuilt = true;
+    m_hasPages = true;
+}
+
+void PlaybackSchedule::UpdatePages()
+{
+    // Look up each measure only once
+    std::map<Measure *, int> pages;
+    for (auto &event : m_events) {
+        auto iter = pages.find(event.m_measure);
+        if (iter == pages.end()) {
+            iter = pages.insert({ event.m_measure, PlaybackSchedule::GetPageNumber(event.m_measure) }).first;
+        }
+        event.m_page = iter->second;
+    }
+    if (m_currentMeasure) m_currentPage = PlaybackSchedule::GetPageNumber(m_currentMeasure);
+
+    m_hasPages = true;
+}
+
+int PlaybackSchedule::GetEventIndex(double millisec) const
+{
+    auto iter = std::lower_bound(m_events.begin(), m_events.end(), millisec,
+        [](const PlaybackEvent &event, double time) { return event.m_time < time; });
+    return (int)(iter - m_events.begin());
+}
+
+double PlaybackSchedule::GetRealTime(double scoreTime) const
+{
+    auto iter = std::upper_bound(m_anchors.begin(), m_anchors.end(), scoreTime,
+        [](double time, const MeasureAnchor &anchor) { return time < anchor.m_scoreTime; });
+    if (iter != m_anchors.begin()) --iter;
+    if (iter == m_anchors.end()) return 0.0;
+
+    return iter->m_realTime + (scoreTime - iter->m_scoreTime) * 60000.0 / iter->m_tempo;
+}
+
+int PlaybackSchedule::GetPageNumber(Measure *measure)
+{
+    assert(measure);
+
+    Page *page = vrv_cast<Page *>(measure->GetFirstAncestor(PAGE));
+    return (page) ? page->GetIdx() + 1 : 0;
+}
+
+//----------------------------------------------------------------------------
+// PlaybackCursor
+//----------------------------------------------------------------------------
+
+PlaybackCursor::PlaybackCursor(const PlaybackSchedule *schedule)
+{
+    assert(schedule);
+
+    m_schedule = schedule;
+    m_index = 0;
+}
+
+PlaybackCursor::~PlaybackCursor() {}
+
+void PlaybackCursor::Seek(double millisec)
+{
+    m_index = m_schedule->GetEventIndex(millisec);
+}
+
+bool PlaybackCursor::IsAtEnd() const
+{
+    return (m_index >= m_schedule->GetEventCount());
+}
+
+const PlaybackEvent *PlaybackCursor::Peek() const
+{
+    if (this->IsAtEnd()) return NULL;
+    return &m_schedule->GetEvents().at(m_index);
+}
+
+const PlaybackEvent *PlaybackCursor::Next()
+{
+    const PlaybackEvent *event = this->Peek();
+    if (event) ++m_index;
+    return event;
+}
+
+const PlaybackEvent *PlaybackCursor::NextUntil(double millisec)
+{
+    const PlaybackEvent *event = this->Peek();
+    if (!event || (event->m_time > millisec)) return NULL;
+    ++m_index;
+    return event;
+}
+
+} // namespace vrv
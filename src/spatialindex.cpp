@@ -0,0 +1,264 @@
+/////////////////////////////////////////////////////////////////////////////
+// Name:        spatialindex.cpp
+// Author:      agent
+// Created:     2026
+// Copyright (c) Authors and others. All rights reserved.
+/////////////////////////////////////////////////////////////////////////////
+
+#include "spatialindex.h"
+
+//----------------------------------------------------------------------------
+
+#include <algorithm>
+#include <assert.h>
+#include <map>
+
+//----------------------------------------------------------------------------
+
+#include "doc.h"
+#include "floatingobject.h"
+#include "page.h"
+#include "system.h"
+#include "verticalaligner.h"
+#include "vrv.h"
+
+/** The size of the cells in drawing units */
+#define SPATIAL_INDEX_CELL_UNITS 4
+/** The number of cells above which a box is not put in the cells */
+#define SPATIAL_INDEX_MAX_CELLS 64
+
+namespace vrv {
+
+//----------------------------------------------------------------------------
+// SpatialIndex
+//----------------------------------------------------------------------------
+
+SpatialIndex::SpatialIndex()
+{
+    Reset();
+}
+
+SpatialIndex::~SpatialIndex() {}
+
+void SpatialIndex::Reset()
+{
+    m_boxes.clear();
+    m_largeBoxes.clear();
+    m_cellStarts.clear();
+    m_cellBoxes.clear();
+    m_left = 0;
+    m_top = 0;
+    m_cellSize = 1;
+    m_columns = 0;
+    m_rows = 0;
+    m_isBuilt = false;
+}
+
+void SpatialIndex::Build(Page *page, Doc *doc)
+{
+    assert(page);
+    assert(doc);
+    assert(page == doc->GetDrawingPage());
+
+    Reset();
+
+    ArrayOfObjects objects;
+    page->FillFlatList(&objects);
+
+    // The bounding boxes of the floating objects are the ones of their positioners, one for each staff of the page
+    std::map<Object *, std::vector<BoundingBox *>> positioners;
+    for (Object *child : page->GetChildRange(SYSTEM)) {
+        System *system = vrv_cast<System *>(child);
+        assert(system);
+        for (Object *alignment : system->m_systemAligner.GetChildRange(STAFF_ALIGNMENT)) {
+            StaffAlignment *staffAlignment = vrv_cast<StaffAlignment *>(alignment);
+            assert(staffAlignment);
+            for (FloatingPositioner *positioner : staffAlignment->GetFloatingPositioners()) {
+                positioners[positioner->GetObject()].push_back(positioner);
+            }
+        }
+    }
+
+    // The conversion done by View::ToDeviceContextY and the translation of the page margins in the SVG
+    const int marginLeft = doc->m_drawingPageMarginLeft;
+    const int marginTop = doc->m_drawingPageMarginTop;
+    const int contentHeight = doc->m_drawingPageContentHeight;
+
+    int right = 0;
+    int bottom = 0;
+    auto addBox = [&](Object *object, BoundingBox *boundingBox) {
+        Box box;
+        box.m_object = object;
+        if (boundingBox->HasSelfBB()) {
+            box.m_left = boundingBox->GetSelfLeft() + marginLeft;
+            box.m_right = boundingBox->GetSelfRight() + marginLeft;
+            box.m_top = contentHeight - boundingBox->GetSelfTop() + marginTop;
+            box.m_bottom = contentHeight - boundingBox->GetSelfBottom() + marginTop;
+        }
+        else if (boundingBox->HasContentBB()) {
+            box.m_left = boundingBox->GetContentLeft() + marginLeft;
+            box.m_right = boundingBox->GetContentRight() + marginLeft;
+            box.m_top = contentHeight - boundingBox->GetContentTop() + marginTop;
+            box.m_bottom = contentHeight - boundingBox->GetContentBottom() + marginTop;
+        }
+        else {
+            return;
+        }
+        if (box.m_left > box.m_right) std::swap(box.m_left, box.m_right);
+        if (box.m_top > box.m_bottom) std::swap(box.m_top, box.m_bottom);
+        if (m_boxes.empty()) {
+            m_left = box.m_left;
+            m_top = box.m_top;
+            right = box.m_right;
+            bottom = box.m_bottom;
+        }
+        else {
+            m_left = std::min(m_left, box.m_left);
+            m_top = std::min(m_top, box.m_top);
+            right = std::max(right, box.m_right);
+            bottom = std::max(bottom, box.m_bottom);
+        }
+        m_boxes.push_back(box);
+    };
+
+    for (Object *object : objects) {
+        if (object == page) continue;
+        if (object->IsFloatingObject()) {
+            auto iter = positioners.find(object);
+            if (iter == positioners.end()) continue;
+            for (BoundingBox *positioner : iter->second) addBox(object, positioner);
+        }
+        else {
+            addBox(object, object);
+        }
+    }
+
+    m_cellSize = std::max(1, doc->GetDrawingUnit(100) * SPATIAL_INDEX_CELL_UNITS);
+    m_columns = (right - m_left) / m_cellSize + 1;
+    m_rows = (bottom - m_top) / m_cellSize + 1;
+
+    // Count the boxes of each cell first, and then fill them in the document order
+    m_cellStarts.assign(m_columns * m_rows + 1, 0);
+    std::vector<bool> isLarge(m_boxes.size(), false);
+    for (int i = 0; i < (int)m_boxes.size(); ++i) {
+        const Box &box = m_boxes.at(i);
+        const int column1 = this->GetColumn(box.m_left);
+        const int column2 = this->GetColumn(box.m_right);
+        const int row1 = this->GetRow(box.m_top);
+        const int row2 = this->GetRow(box.m_bottom);
+        if ((column2 - column1 + 1) * (row2 - row1 + 1) > SPATIAL_INDEX_MAX_CELLS) {
+            isLarge.at(i) = true;
+            m_largeBoxes.push_back(i);
+            continue;
+        }
+        for (int row = row1; row <= row2; ++row) {
+            for (int column = column1; column <= column2; ++column) {
+                ++m_cellStarts.at(row * m_columns + column + 1);
+            }
+        }
+    }
+    for (int cell = 1; cell < (int)m_cellStarts.size(); ++cell) {
+        m_cellStarts.at(cell) += m_cellStarts.at(cell - 1);
+    }
+
+    m_cellBoxes.resize(m_cellStarts.back());
+    std::vector<int> cellEnds(m_cellStarts.begin(), m_cellStarts.end() - 1);
+    for (int i = 0; i < (int)m_boxes.size(); ++i) {
+        if (isLarge.at(i)) continue;
+        const Box &box = m_boxes.at(i);
+        const int column1 = this->GetColumn(box.m_left);
+        const int column2 = this->GetColumn(box.m_right);
+        const int row1 = this->GetRow(box.m_top);
+        const int row2 = this->GetRow(box.m_bottom);
+        for (int row = row1; row <= row2; ++row) {
+            for (int column = column1; column <= column2; ++column) {
+                m_cellBoxes.at(cellEnds.at(row * m_columns + column)++) = i;
+            }
+        }
+    }
+
+    m_isBuilt = true;
+}
+
+void SpatialIndex::GetObjectsInRect(int left, int top, int right, int bottom, std::vector<Object *> &objects) const
+{
+    if (left > right) std::swap(left, right);
+    if (top > bottom) std::swap(top, bottom);
+
+    std::vector<int> boxIdx;
+    this->FindBoxes(left, top, right, bottom, boxIdx);
+
+    for (int idx : boxIdx) {
+        // The boxes of the positioners of a floating object follow each other
+        if (!objects.empty() && (objects.back() == m_boxes.at(idx).m_object)) continue;
+        objects.push_back(m_boxes.at(idx).m_object);
+    }
+}
+
+void SpatialIndex::GetObjectsAtPoint(int x, int y, int radius, std::vector<Object *> &objects) const
+{
+    radius = std::max(0, radius);
+
+    std::vector<int> boxIdx;
+    this->FindBoxes(x - radius, y - radius, x + radius, y + radius, boxIdx);
+
+    // Keep the boxes within the radius, which excludes the corners of the square
+    const double maxDistance = (double)radius * radius;
+    for (int idx : boxIdx) {
+        const Box &box = m_boxes.at(idx);
+        const double dx = (x < box.m_left) ? (box.m_left - x) : ((x > box.m_right) ? (x - box.m_right) : 0);
+        const double dy = (y < box.m_top) ? (box.m_top - y) : ((y > box.m_bottom) ? (y - box.m_bottom) : 0);
+        if (dx * dx + dy * dy > maxDistance) continue;
+        if (!objects.empty() && (objects.back() == box.m_object)) continue;
+        objects.push_back(box.m_object);
+    }
+}
+
+void SpatialIndex::FindBoxes(int left, int top, int right, int bottom, std::vector<int> &boxIdx) const
+{
+    if (m_boxes.empty()) return;
+
+    auto overlaps = [left, top, right, bottom](const Box &box) {
+        return ((box.m_left <= right) && (box.m_right >= left) && (box.m_top <= bottom) && (box.m_bottom >= top));
+    };
+
+    for (int idx : m_largeBoxes) {
+        if (overlaps(m_boxes.at(idx))) boxIdx.push_back(idx);
+    }
+
+    // Nothing else can overlap a rectangle outside the grid
+    if ((right >= m_left) && (bottom >= m_top) && (left < m_left + m_columns * m_cellSize)
+        && (top < m_top + m_rows * m_cellSize)) {
+        const int column1 = this->GetColumn(left);
+        const int column2 = this->GetColumn(right);
+        const int row1 = this->GetRow(top);
+        const int row2 = this->GetRow(bottom);
+        for (int row = row1; row <= row2; ++row) {
+            for (int column = column1; column <= column2; ++column) {
+                const int cell = row * m_columns + column;
+                for (int i = m_cellStarts.at(cell); i < m_cellStarts.at(cell + 1); ++i) {
+                    const int idx = m_cellBoxes.at(i);
+                    if (overlaps(m_boxes.at(idx))) boxIdx.push_back(idx);
+                }
+            }
+        }
+    }
+
+    // Boxes spanning several cells are found more than once
+    std::sort(boxIdx.begin(), boxIdx.end());
+    boxIdx.erase(std::unique(boxIdx.begin(), boxIdx.end()), boxIdx.end());
+}
+
+int SpatialIndex::GetColumn(int x) const
+{
+    if (x <= m_left) return 0;
+    return std::min((x - m_left) / m_cellSize, m_columns - 1);
+}
+
+int SpatialIndex::GetRow(int y) const
+{
+    if (y <= m_top) return 0;
+    return std::min((y - m_top) / m_cellSize, m_rows - 1);
+}
+
+} // namespace vrv
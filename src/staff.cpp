@@ -81,13 +81,14 @@ void Staff::Reset()
 
 void Staff::CloneReset()
 {
-    Object::CloneReset();
-
+    // The ledger lines are owned by the original staff and must not be deleted when resetting the drawing
     m_ledgerLinesAbove = NULL;
     m_ledgerLinesBelow = NULL;
     m_ledgerLinesAboveCue = NULL;
     m_ledgerLinesBelowCue = NULL;
 
+    Object::CloneReset();
+
     m_drawingStaffSize = 100;
     m_drawingLines = 5;
     m_drawingNotationType = NOTATIONTYPE_NONE;
@@ -522,6 +523,22 @@ int Staff::CalcOnsetOffset(FunctorParams *functorParams)
     return FUNCTOR_CONTINUE;
 }
 
+int Staff::GenerateMIDI(FunctorParams *functorParams)
+{
+    GenerateMIDIParams *params = vrv_params_cast<GenerateMIDIParams *>(functorParams);
+    assert(params);
+
+    // Route the events of the staff to its track
+    auto trackState = params->m_trackStates.find(this->GetN());
+    if (trackState == params->m_trackStates.end()) return FUNCTOR_SIBLINGS;
+
+    params->m_midiTrack = trackState->second.m_midiTrack;
+    params->m_midiChannel = trackState->second.m_midiChannel;
+    params->m_transSemi = trackState->second.m_transSemi;
+
+    return FUNCTOR_CONTINUE;
+}
+
 int Staff::CalcStem(FunctorParams *)
 {
     ClassIdComparison isLayer(LAYER);
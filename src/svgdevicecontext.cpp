@@ -10,6 +10,8 @@
 //----------------------------------------------------------------------------
 
 #include <assert.h>
+#include <cstring>
+#include <vector>
 
 //----------------------------------------------------------------------------
 
@@ -968,6 +970,31 @@ std::string SvgDeviceContext::GetStringSVG(bool xml_declaration)
     return m_outdata.str();
 }
 
+size_t SvgDeviceContext::GetMemorySize(int &nodeCount)
+{
+    // The nodes and the attributes are estimated from the pointers pugixml stores for them
+    const size_t nodeSize = 8 * sizeof(void *);
+    const size_t attributeSize = 5 * sizeof(void *);
+
+    nodeCount = 0;
+    size_t size = 0;
+    std::vector<pugi::xml_node> nodes = { m_svgDoc };
+    while (!nodes.empty()) {
+        pugi::xml_node node = nodes.back();
+        nodes.pop_back();
+        ++nodeCount;
+        size += nodeSize + strlen(node.name()) + strlen(node.value());
+        for (pugi::xml_attribute attribute : node.attributes()) {
+            size += attributeSize + strlen(attribute.name()) + strlen(attribute.value());
+        }
+        for (pugi::xml_node child : node.children()) {
+            nodes.push_back(child);
+        }
+    }
+
+    return size + (size_t)m_outdata.tellp();
+}
+
 void SvgDeviceContext::DrawSvgBoundingBoxRectangle(int x, int y, int width, int height)
 {
     std::string s;
@@ -0,0 +1,186 @@
+/////////////////////////////////////////////////////////////////////////////
+// Name:        timeindex.cpp
+// Author:      agent
+// Created:     2026
+// Copyright (c) Authors and others. All rights reserved.
+/////////////////////////////////////////////////////////////////////////////
+
+#include "timeindex.h"
+
+//----------------------------------------------------------------------------
+
+#include <algorithm>
+#include <assert.h>
+#include <set>
+
+//----------------------------------------------------------------------------
+
+#include "comparison.h"
+#include "doc.h"
+#include "measure.h"
+#include "note.h"
+#include "vrv.h"
+
+namespace vrv {
+
+//----------------------------------------------------------------------------
+// TimeIndex
+//----------------------------------------------------------------------------
+
+TimeIndex::TimeIndex()
+{
+    Reset();
+}
+
+TimeIndex::~TimeIndex() {}
+
+void TimeIndex::Reset()
+{
+    m_measureIntervals.clear();
+    m_noteIntervals.clear();
+    m_isBuilt = false;
+}
+
+void TimeIndex::Build(Doc *doc)
+{
+    assert(doc);
+
+    Reset();
+
+    ClassIdComparison matchMeasure(MEASURE);
+    ListOfObjects measures;
+    doc->FindAllDescendantByComparison(&measures, &matchMeasure);
+
+    ClassIdComparison matchNote(NOTE);
+    int measureOrder = 0;
+    int noteOrder = 0;
+    for (auto const &object : measures) {
+        Measure *measure = vrv_cast<Measure *>(object);
+        assert(measure);
+        const int duration = measure->GetRealTimeDurationMilliseconds();
+
+        ListOfObjects notes;
+        measure->FindAllDescendantByComparison(&notes, &matchNote);
+
+        for (int repeat = 1; repeat <= measure->GetRepeatCount(); ++repeat) {
+            MeasureInterval measureInterval;
+            measureInterval.m_onset = measure->GetRealTimeOffsetMilliseconds(repeat);
+            measureInterval.m_offset = measureInterval.m_onset + duration;
+            measureInterval.m_measureTimeOffset = (int)measureInterval.m_onset;
+            measureInterval.m_order = measureOrder;
+            measureInterval.m_measure = measure;
+            m_measureIntervals.push_back(measureInterval);
+
+            int order = noteOrder;
+            for (auto const &noteObject : notes) {
+                Note *note = vrv_cast<Note *>(noteObject);
+                assert(note);
+                NoteInterval noteInterval;
+                noteInterval.m_noteOnset = note->GetRealTimeOnsetMilliseconds();
+                noteInterval.m_noteOffset = note->GetRealTimeOffsetMilliseconds();
+                noteInterval.m_onset = measureInterval.m_measureTimeOffset + noteInterval.m_noteOnset;
+                noteInterval.m_order = order++;
+                noteInterval.m_measureTimeOffset = measureInterval.m_measureTimeOffset;
+                noteInterval.m_measure = measure;
+                noteInterval.m_note = note;
+                m_noteIntervals.push_back(noteInterval);
+            }
+        }
+        noteOrder += (int)notes.size();
+        ++measureOrder;
+    }
+
+    // Stable sort so that the repeats of a measure and the simultaneous notes remain in the document order
+    std::stable_sort(m_measureIntervals.begin(), m_measureIntervals.end(),
+        [](const MeasureInterval &a, const MeasureInterval &b) { return a.m_onset < b.m_onset; });
+    std::stable_sort(m_noteIntervals.begin(), m_noteIntervals.end(),
+        [](const NoteInterval &a, const NoteInterval &b) { return a.m_onset < b.m_onset; });
+
+    SetMaxOffsets(m_measureIntervals, [](const MeasureInterval &interval) { return interval.m_offset; });
+    SetMaxOffsets(m_noteIntervals,
+        [](const NoteInterval &interval) { return interval.m_measureTimeOffset + interval.m_noteOffset; });
+
+    m_isBuilt = true;
+}
+
+template <class INTERVAL> int TimeIndex::UpperBound(const std::vector<INTERVAL> &intervals, double time)
+{
+    auto iter = std::upper_bound(intervals.begin(), intervals.end(), time,
+        [](double value, const INTERVAL &interval) { return value < interval.m_onset; });
+    return (int)(iter - intervals.begin());
+}
+
+template <class INTERVAL, class OFFSET>
+void TimeIndex::SetMaxOffsets(std::vector<INTERVAL> &intervals, OFFSET offset)
+{
+    double maxOffset = 0.0;
+    for (auto &interval : intervals) {
+        maxOffset = std::max(maxOffset, (double)offset(interval));
+        interval.m_maxOffset = maxOffset;
+    }
+}
+
+Measure *TimeIndex::GetNotesAtTime(int millisec, std::vector<Note *> &notes) const
+{
+    notes.clear();
+
+    // Stop as soon as none of the intervals left ends at or after the time
+    const MeasureInterval *measureInterval = NULL;
+    for (int i = UpperBound(m_measureIntervals, millisec) - 1; i >= 0; --i) {
+        const MeasureInterval &interval = m_measureIntervals.at(i);
+        if (interval.m_maxOffset < millisec) break;
+        if (millisec > interval.m_offset) continue;
+        // Keep the first measure in the document order, and its first repeat
+        if (!measureInterval || (interval.m_order < measureInterval->m_order)
+            || ((interval.m_order == measureInterval->m_order) && (interval.m_onset <= measureInterval->m_onset))) {
+            measureInterval = &interval;
+        }
+    }
+    if (!measureInterval) return NULL;
+
+    // The notes store their times within the measure, so compare them with the time relative to the measure
+    const int measureTime = millisec - measureInterval->m_measureTimeOffset;
+    std::vector<std::pair<int, Note *> > sounding;
+    for (int i = UpperBound(m_noteIntervals, millisec + 1) - 1; i >= 0; --i) {
+        const NoteInterval &interval = m_noteIntervals.at(i);
+        if (interval.m_maxOffset < millisec) break;
+        if ((interval.m_measure != measureInterval->m_measure)
+            || (interval.m_measureTimeOffset != measureInterval->m_measureTimeOffset)) {
+            continue;
+        }
+        if ((measureTime >= interval.m_noteOnset) && (measureTime <= interval.m_noteOffset)) {
+            sounding.push_back({ interval.m_order, interval.m_note });
+        }
+    }
+
+    std::sort(sounding.begin(), sounding.end());
+    for (auto const &note : sounding) notes.push_back(note.second);
+
+    return measureInterval->m_measure;
+}
+
+void TimeIndex::GetNotesInTimeRange(
+    int startMillisec, int endMillisec, std::vector<Note *> &notes, std::vector<Measure *> &measures) const
+{
+    notes.clear();
+    measures.clear();
+
+    std::vector<const NoteInterval *> sounding;
+    for (int i = UpperBound(m_noteIntervals, endMillisec) - 1; i >= 0; --i) {
+        const NoteInterval &interval = m_noteIntervals.at(i);
+        if (interval.m_maxOffset < startMillisec) break;
+        if (interval.m_measureTimeOffset + interval.m_noteOffset < startMillisec) continue;
+        sounding.push_back(&interval);
+    }
+
+    // Intervals were collected backwards
+    std::reverse(sounding.begin(), sounding.end());
+    std::set<Note *> uniqueNotes;
+    std::set<Measure *> uniqueMeasures;
+    for (auto const &interval : sounding) {
+        if (uniqueNotes.insert(interval->m_note).second) notes.push_back(interval->m_note);
+        if (uniqueMeasures.insert(interval->m_measure).second) measures.push_back(interval->m_measure);
+    }
+}
+
+} // namespace vrv
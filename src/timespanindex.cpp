@@ -0,0 +1,253 @@
+/////////////////////////////////////////////////////////////////////////////
+// Name:        timespanindex.cpp
+// Author:      agent
+// Created:     2026
+// Copyright (c) Authors and others. All rights reserved.
+/////////////////////////////////////////////////////////////////////////////
+
+#include "timespanindex.h"
+
+//----------------------------------------------------------------------------
+
+#include <algorithm>
+#include <assert.h>
+
+//----------------------------------------------------------------------------
+
+#include "chord.h"
+#include "comparison.h"
+#include "functorparams.h"
+#include "horizontalaligner.h"
+#include "layer.h"
+#include "layerelement.h"
+#include "measure.h"
+#include "mensur.h"
+#include "metersig.h"
+
+namespace vrv {
+
+//----------------------------------------------------------------------------
+// TimeSpanIndex
+//----------------------------------------------------------------------------
+
+TimeSpanIndex::TimeSpanIndex() {}
+
+TimeSpanIndex::~TimeSpanIndex() {}
+
+void TimeSpanIndex::Reset()
+{
+    m_visits.clear();
+    m_layerCountSpans.clear();
+    m_layerElementSpans.clear();
+}
+
+int TimeSpanIndex::GetLayerCount(
+    Measure *measure, int staffN, double time, double duration, MeterSig *meterSig, Mensur *mensur)
+{
+    const std::vector<Visit> &visits = this->GetVisits(measure, staffN);
+
+    auto key = std::make_tuple(staffN, meterSig, mensur);
+    auto iter = m_layerCountSpans.find(key);
+    if (iter == m_layerCountSpans.end()) {
+        SpanList &spanList = m_layerCountSpans[key];
+        std::vector<int> spanIdx(visits.size() + 1, -1);
+        std::vector<int> visitIdx;
+        // The meter signature and the mensur change along the traversal and scoreDef elements are not counted
+        MeterSig *currentMeterSig = meterSig;
+        Mensur *currentMensur = mensur;
+        int i = 0;
+        while (i < (int)visits.size()) {
+            spanIdx.at(i) = (int)spanList.m_spans.size();
+            LayerElement *element = visits.at(i).m_element;
+            if (element->Is(METERSIG)) {
+                currentMeterSig = vrv_cast<MeterSig *>(element);
+                ++i;
+            }
+            else if (element->Is(MENSUR)) {
+                currentMensur = vrv_cast<Mensur *>(element);
+                ++i;
+            }
+            else if (element->IsScoreDefElement()) {
+                i = visits.at(i).m_end;
+            }
+            // For mRest we do not look at the time span
+            else if (element->Is(MREST)) {
+                spanList.m_mRests.push_back({ (int)spanList.m_spans.size(), element->GetAlignmentLayerN() });
+                i = visits.at(i).m_end;
+            }
+            else if (!element->GetDurationInterface() || element->Is({ MSPACE, SPACE }) || element->HasSameasLink()) {
+                ++i;
+            }
+            else {
+                AddSpan(spanList, element, element->GetAlignment()->GetTime(),
+                    element->GetAlignmentDuration(currentMensur, currentMeterSig));
+                visitIdx.push_back(i);
+                ++i;
+            }
+        }
+        spanIdx.back() = (int)spanList.m_spans.size();
+        FinishSpans(spanList, visits, spanIdx, visitIdx);
+        iter = m_layerCountSpans.find(key);
+    }
+    const SpanList &spanList = iter->second;
+
+    std::vector<int> spanIdx;
+    const int stopIdx = FindSpans(spanList, time, duration, spanIdx);
+
+    std::vector<int> layers;
+    auto addLayer = [&layers](int layerN) {
+        if (std::find(layers.begin(), layers.end(), layerN) == layers.end()) layers.push_back(layerN);
+    };
+    // The mRests visited before the traversal stops
+    for (auto &mRest : spanList.m_mRests) {
+        if (mRest.first > stopIdx) break;
+        addLayer(mRest.second);
+    }
+    for (int idx : spanIdx) {
+        addLayer(spanList.m_spans.at(idx).m_layerN);
+    }
+
+    return (int)layers.size();
+}
+
+ListOfObjects TimeSpanIndex::GetLayerElements(
+    Measure *measure, int staffN, Layer *layer, double time, double duration, MeterSig *meterSig, Mensur *mensur)
+{
+    const std::vector<Visit> &visits = this->GetVisits(measure, staffN);
+
+    auto key = std::make_tuple(staffN, layer, meterSig, mensur);
+    auto iter = m_layerElementSpans.find(key);
+    if (iter == m_layerElementSpans.end()) {
+        SpanList &spanList = m_layerElementSpans[key];
+        std::vector<int> spanIdx(visits.size() + 1, -1);
+        std::vector<int> visitIdx;
+        // Only the elements of the layer are looked at, without scoreDef elements and mRests
+        int i = 0;
+        while (i < (int)visits.size()) {
+            spanIdx.at(i) = (int)spanList.m_spans.size();
+            LayerElement *element = visits.at(i).m_element;
+            Layer *currentLayer = vrv_cast<Layer *>(element->GetFirstAncestor(LAYER));
+            if (!currentLayer || (currentLayer != layer) || element->IsScoreDefElement() || element->Is(MREST)) {
+                i = visits.at(i).m_end;
+            }
+            else if (!element->GetDurationInterface() || element->Is({ MSPACE, SPACE }) || element->HasSameasLink()) {
+                ++i;
+            }
+            else {
+                Chord *chord = (element->GetParent()->Is(CHORD)) ? vrv_cast<Chord *>(element->GetParent()) : NULL;
+                const double elementDuration = (chord) ? chord->GetAlignmentDuration(mensur, meterSig)
+                                                       : element->GetAlignmentDuration(mensur, meterSig);
+                AddSpan(spanList, element, element->GetAlignment()->GetTime(), elementDuration);
+                visitIdx.push_back(i);
+                ++i;
+            }
+        }
+        spanIdx.back() = (int)spanList.m_spans.size();
+        FinishSpans(spanList, visits, spanIdx, visitIdx);
+        iter = m_layerElementSpans.find(key);
+    }
+    const SpanList &spanList = iter->second;
+
+    std::vector<int> spanIdx;
+    FindSpans(spanList, time, duration, spanIdx);
+
+    ListOfObjects elements;
+    for (int idx : spanIdx) {
+        elements.push_back(spanList.m_spans.at(idx).m_element);
+    }
+
+    return elements;
+}
+
+const std::vector<TimeSpanIndex::Visit> &TimeSpanIndex::GetVisits(Measure *measure, int staffN)
+{
+    assert(measure);
+
+    auto iter = m_visits.find(staffN);
+    if (iter != m_visits.end()) return iter->second;
+
+    std::vector<Visit> &visits = m_visits[staffN];
+
+    // Each object is added when it is entered and when it is left, which gives us the extent of its descendants
+    ArrayOfObjects objects;
+    Functor addToFlatList(&Object::AddLayerElementToFlatList);
+    AddLayerElementToFlatListParams addLayerElementToFlatListParams(&objects);
+
+    ArrayOfComparisons filters;
+    AttNIntegerComparison matchStaff(ALIGNMENT_REFERENCE, staffN);
+    filters.push_back(&matchStaff);
+
+    measure->m_measureAligner.Process(&addToFlatList, &addLayerElementToFlatListParams, &addToFlatList, &filters);
+
+    // The objects being visited with the index of their visit (-1 for objects other than layer elements)
+    std::vector<std::pair<Object *, int>> stack;
+    for (Object *object : objects) {
+        // An object cannot be a descendant of itself, so this is where we leave it
+        if (!stack.empty() && (stack.back().first == object)) {
+            if (stack.back().second != -1) visits.at(stack.back().second).m_end = (int)visits.size();
+            stack.pop_back();
+            continue;
+        }
+        int visitIdx = -1;
+        if (object->IsLayerElement()) {
+            visitIdx = (int)visits.size();
+            visits.push_back({ vrv_cast<LayerElement *>(object), 0 });
+        }
+        stack.push_back({ object, visitIdx });
+    }
+    assert(stack.empty());
+
+    return visits;
+}
+
+void TimeSpanIndex::AddSpan(SpanList &spanList, LayerElement *element, double time, double duration)
+{
+    assert(element);
+
+    spanList.m_spans.push_back({ element, time, duration, 0, element->GetAlignmentLayerN(), element->Is(CHORD) });
+}
+
+void TimeSpanIndex::FinishSpans(SpanList &spanList, const std::vector<Visit> &visits, const std::vector<int> &spanIdx,
+    const std::vector<int> &visitIdx)
+{
+    assert(spanList.m_spans.size() == visitIdx.size());
+
+    double maxEnd = 0.0;
+    for (int i = 0; i < (int)spanList.m_spans.size(); ++i) {
+        Span &span = spanList.m_spans.at(i);
+        // The end of the descendants is never skipped when the span is not
+        span.m_next = spanIdx.at(visits.at(visitIdx.at(i)).m_end);
+        assert(span.m_next > i);
+        const double end = span.m_time + span.m_duration;
+        maxEnd = (i == 0) ? end : std::max(maxEnd, end);
+        spanList.m_maxEnds.push_back(maxEnd);
+    }
+}
+
+int TimeSpanIndex::FindSpans(const SpanList &spanList, double time, double duration, std::vector<int> &spanIdx)
+{
+    // All the spans before the first one ending after the time would be skipped
+    auto first = std::upper_bound(spanList.m_maxEnds.begin(), spanList.m_maxEnds.end(), time);
+    int i = (int)(first - spanList.m_maxEnds.begin());
+
+    const int count = (int)spanList.m_spans.size();
+    while (i < count) {
+        const Span &span = spanList.m_spans.at(i);
+        // The event is starting after the end of the element
+        if ((span.m_time + span.m_duration) <= time) {
+            ++i;
+            continue;
+        }
+        // The element is starting after the event end - the traversal stops here
+        if (span.m_time >= (time + duration)) {
+            return i;
+        }
+        spanIdx.push_back(i);
+        // No need to go into chords
+        i = (span.m_isChord) ? span.m_next : i + 1;
+    }
+
+    return count;
+}
+
+} // namespace vrv
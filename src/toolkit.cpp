@@ -9,7 +9,10 @@
 
 //----------------------------------------------------------------------------
 
+#include <algorithm>
 #include <assert.h>
+#include <cstring>
+#include <set>
 
 //----------------------------------------------------------------------------
 
@@ -19,6 +22,7 @@
 #include "editortoolkit_mensural.h"
 #include "editortoolkit_neume.h"
 #include "functorparams.h"
+#include "inflater.h"
 #include "ioabc.h"
 #include "iodarms.h"
 #include "iohumdrum.h"
@@ -27,7 +31,9 @@
 #include "iopae.h"
 #include "layer.h"
 #include "measure.h"
+#include "midiwriter.h"
 #include "nc.h"
+#include "objectarena.h"
 #include "neume.h"
 #include "note.h"
 #include "options.h"
@@ -71,6 +77,7 @@ Toolkit::Toolkit(bool initFont)
 
     m_humdrumBuffer = NULL;
     m_cString = NULL;
+    m_hasLayoutInformation = false;
 
     if (initFont) {
         Resources::InitFonts();
@@ -293,6 +300,9 @@ bool Toolkit::LoadFile(const std::string &filename)
     if (IsUTF16(filename)) {
         return LoadUTF16File(filename);
     }
+    if (IsCompressed(filename)) {
+        return LoadBinaryFile(filename);
+    }
 
     std::ifstream in(filename.c_str());
     if (!in.is_open()) {
@@ -363,6 +373,41 @@ bool Toolkit::LoadUTF16File(const std::string &filename)
     return LoadData(utf8line);
 }
 
+bool Toolkit::IsCompressed(const std::string &filename)
+{
+    std::ifstream fin(filename.c_str(), std::ios::in | std::ios::binary);
+    if (!fin.is_open()) {
+        return false;
+    }
+
+    std::string data(4, 0);
+    fin.read(&data[0], 4);
+    fin.close();
+
+    return (Inflater::IsGzip(data) || Inflater::IsZip(data));
+}
+
+bool Toolkit::LoadBinaryFile(const std::string &filename)
+{
+    // Compressed files are binary and need to be read without any newline conversion
+    std::ifstream fin(filename.c_str(), std::ios::in | std::ios::binary);
+    if (!fin.is_open()) {
+        return false;
+    }
+
+    fin.seekg(0, std::ios::end);
+    std::streamsize fileSize = (std::streamsize)fin.tellg();
+    fin.clear();
+    fin.seekg(0, std::ios::beg);
+
+    std::string content(fileSize, 0);
+    fin.read(&content[0], fileSize);
+
+    m_doc.m_expansionMap.Reset();
+
+    return LoadData(content);
+}
+
 void Toolkit::GetClassIds(const std::vector<std::string> &classStrings, std::vector<ClassId> &classIds)
 {
     // one we use magic_enum.hpp we can do :
@@ -390,8 +435,54 @@ void Toolkit::GetClassIds(const std::vector<std::string> &classStrings, std::vec
     }
 }
 
+bool Toolkit::DecompressData(const std::string &data, std::string &output)
+{
+    if (Inflater::IsGzip(data)) {
+        return Inflater::Gunzip(data, output);
+    }
+
+    std::vector<std::string> names;
+    if (!Inflater::GetZipEntryNames(data, names)) {
+        return false;
+    }
+
+    // Compressed MusicXML files point to the root file in META-INF/container.xml
+    std::string container;
+    if (Inflater::Unzip(data, "META-INF/container.xml", container)) {
+        pugi::xml_document doc;
+        doc.load_buffer(container.c_str(), container.size());
+        pugi::xpath_node rootfile = doc.select_node("//rootfile[@full-path]");
+        if (rootfile) {
+            std::string rootPath = rootfile.node().attribute("full-path").value();
+            if (Inflater::Unzip(data, rootPath, output)) return true;
+            LogError("The root file '%s' could not be found in the archive", rootPath.c_str());
+            return false;
+        }
+    }
+
+    // Otherwise use the first file that is not in META-INF
+    for (auto const &name : names) {
+        if ((name.compare(0, 9, "META-INF/") == 0) || (name.empty()) || (name.back() == '/')) continue;
+        return Inflater::Unzip(data, name, output);
+    }
+
+    LogError("No file to load could be found in the archive");
+    return false;
+}
+
 bool Toolkit::LoadData(const std::string &data)
 {
+    if (Inflater::IsGzip(data) || Inflater::IsZip(data)) {
+        std::string decompressed;
+        if (!DecompressData(data, decompressed)) {
+            return false;
+        }
+        return LoadData(decompressed);
+    }
+
+    // The objects created by the import are content objects (the layout uses its own arena)
+    ObjectArenaScope arenaScope(m_doc.GetContentArena());
+
     std::string newData;
     Input *input = NULL;
 
@@ -598,6 +689,50 @@ bool Toolkit::LoadData(const std::string &data)
         delete input;
         return false;
     }
+    m_hasLayoutInformation = input->HasLayoutInformation();
+    m_transposition = "";
+    delete input;
+
+    m_memoryStats.clear();
+    this->SnapshotMemoryStats("import");
+
+    this->PrepareLoadedDoc(true);
+
+    return true;
+}
+
+bool Toolkit::LoadCopy(Toolkit *toolkit)
+{
+    assert(toolkit && (toolkit != this));
+
+    // A content transposed by the other toolkit cannot be transposed differently
+    const bool transpose = toolkit->m_transposition.empty();
+    if (!transpose && (m_options->m_transpose.GetValue() != toolkit->m_transposition)) {
+        LogError("A document transposed with '%s' cannot be copied with another transposition",
+            toolkit->m_transposition.c_str());
+        return false;
+    }
+
+    // The copies are content objects (see Doc::CopyContentFrom)
+    if (!m_doc.CopyContentFrom(&toolkit->m_doc)) {
+        LogError("Error copying the document");
+        return false;
+    }
+    m_hasLayoutInformation = toolkit->m_hasLayoutInformation;
+    m_transposition = toolkit->m_transposition;
+
+    m_memoryStats.clear();
+    this->SnapshotMemoryStats("import");
+
+    this->PrepareLoadedDoc(transpose);
+
+    return true;
+}
+
+void Toolkit::PrepareLoadedDoc(bool transpose)
+{
+    // The objects generated are content objects (the layout uses its own arena)
+    ObjectArenaScope arenaScope(m_doc.GetContentArena());
 
     bool adjustPageHeight = m_options->m_adjustPageHeight.GetValue();
     int footerOption = m_options->m_footer.GetValue();
@@ -614,12 +749,14 @@ bool Toolkit::LoadData(const std::string &data)
     m_doc.GenerateMeasureNumbers();
 
     // transpose the content if necessary
-    if (m_options->m_transpose.GetValue() != "") {
+    if (transpose && (m_options->m_transpose.GetValue() != "")) {
         m_doc.PrepareDrawing();
         m_doc.TransposeDoc();
+        m_transposition = m_options->m_transpose.GetValue();
     }
 
     m_doc.PrepareDrawing();
+    this->SnapshotMemoryStats("prepareDrawing");
 
     // Convert pseudo-measures into distinct segments based on barLine elements
     if (m_doc.IsMensuralMusicOnly()) {
@@ -635,7 +772,7 @@ bool Toolkit::LoadData(const std::string &data)
     // be converted
     if (m_doc.GetType() == Transcription || m_doc.GetType() == Facs) breaks = BREAKS_none;
     if (breaks != BREAKS_none) {
-        if (input->HasLayoutInformation() && (breaks == BREAKS_encoded || breaks == BREAKS_line)) {
+        if (m_hasLayoutInformation && (breaks == BREAKS_encoded || breaks == BREAKS_line)) {
             if (breaks == BREAKS_encoded) {
                 // LogElapsedTimeStart();
                 m_doc.CastOffEncodingDoc();
@@ -657,8 +794,8 @@ bool Toolkit::LoadData(const std::string &data)
             // LogElapsedTimeEnd("layout");
         }
     }
+    this->SnapshotMemoryStats("castOff");
 
-    delete input;
     m_view.SetDoc(&m_doc);
 
 #if defined NO_HUMDRUM_SUPPORT
@@ -675,15 +812,13 @@ bool Toolkit::LoadData(const std::string &data)
         default: m_editorToolkit = new EditorToolkitCMN(&m_doc, &m_view);
     }
 #endif
-
-    return true;
 }
 
-std::string Toolkit::GetMEI(const std::string &jsonOptions)
+void Toolkit::SetMEIOutputOptions(MEIOutput &meioutput, const std::string &jsonOptions, int &pageNo)
 {
     bool scoreBased = true;
-    int pageNo = 0;
     bool removeIds = false;
+    pageNo = 0;
 
     jsonxx::Object json;
 
@@ -697,21 +832,28 @@ std::string Toolkit::GetMEI(const std::string &jsonOptions)
         if (json.has<jsonxx::Boolean>("removeIds")) removeIds = json.get<jsonxx::Boolean>("removeIds");
     }
 
+    // Page number is one-based - correct it to 0-based
+    pageNo--;
+
+    meioutput.SetScoreBasedMEI(scoreBased);
+
+    int indent = (m_options->m_outputIndentTab.GetValue()) ? -1 : m_options->m_outputIndent.GetValue();
+    meioutput.SetIndent(indent);
+    meioutput.SetRemoveIds(removeIds);
+}
+
+std::string Toolkit::GetMEI(const std::string &jsonOptions)
+{
     if (GetPageCount() == 0) {
         LogWarning("No data loaded");
         return "";
     }
 
     int initialPageNo = (m_doc.GetDrawingPage() == NULL) ? -1 : m_doc.GetDrawingPage()->GetIdx();
-    // Page number is one-based - correct it to 0-based first
-    pageNo--;
 
     MEIOutput meioutput(&m_doc);
-    meioutput.SetScoreBasedMEI(scoreBased);
-
-    int indent = (m_options->m_outputIndentTab.GetValue()) ? -1 : m_options->m_outputIndent.GetValue();
-    meioutput.SetIndent(indent);
-    meioutput.SetRemoveIds(removeIds);
+    int pageNo;
+    this->SetMEIOutputOptions(meioutput, jsonOptions, pageNo);
 
     std::string output = meioutput.GetOutput(pageNo);
     if (initialPageNo >= 0) m_doc.SetDrawingPage(initialPageNo);
@@ -720,7 +862,10 @@ std::string Toolkit::GetMEI(const std::string &jsonOptions)
 
 bool Toolkit::SaveFile(const std::string &filename, const std::string &jsonOptions)
 {
-    std::string output = GetMEI(jsonOptions);
+    if (GetPageCount() == 0) {
+        LogWarning("No data loaded");
+        return false;
+    }
 
     std::ofstream outfile;
     outfile.open(filename.c_str());
@@ -730,9 +875,18 @@ bool Toolkit::SaveFile(const std::string &filename, const std::string &jsonOptio
         return false;
     }
 
-    outfile << output;
+    int initialPageNo = (m_doc.GetDrawingPage() == NULL) ? -1 : m_doc.GetDrawingPage()->GetIdx();
+
+    // The MEI is streamed to the file and never held in memory as a whole
+    MEIOutput meioutput(&m_doc);
+    int pageNo;
+    this->SetMEIOutputOptions(meioutput, jsonOptions, pageNo);
+
+    bool success = meioutput.Export(outfile, pageNo);
+    if (initialPageNo >= 0) m_doc.SetDrawingPage(initialPageNo);
+
     outfile.close();
-    return true;
+    return success;
 }
 
 std::string Toolkit::GetOptions(bool defaultValues) const
@@ -1123,6 +1277,69 @@ bool Toolkit::SetOption(const std::string &option, const std::string &value)
     return opt->SetValue(value);
 }
 
+jsonxx::Object Toolkit::GetMemoryEntriesObject(const std::map<std::string, MemoryStats::Entry> &entries)
+{
+    jsonxx::Object o;
+    for (auto const &entry : entries) {
+        jsonxx::Object e;
+        e << "count" << entry.second.m_count;
+        e << "bytes" << (double)entry.second.m_size;
+        o << entry.first << e;
+    }
+    return o;
+}
+
+jsonxx::Object Toolkit::GetMemoryStatsObject(const MemoryStats &stats)
+{
+    jsonxx::Object o;
+    o << "objects" << GetMemoryEntriesObject(stats.GetObjects());
+    o << "objectCount" << stats.GetObjectTotal().m_count;
+    o << "objectBytes" << (double)stats.GetObjectTotal().m_size;
+    o << "structures" << GetMemoryEntriesObject(stats.GetStructures());
+    o << "structureBytes" << (double)stats.GetStructureTotal().m_size;
+    return o;
+}
+
+std::string Toolkit::GetMemoryStats()
+{
+    MemoryStats stats;
+    this->CollectMemoryStats(stats);
+    jsonxx::Object o = GetMemoryStatsObject(stats);
+
+    if (!m_memoryStats.empty()) {
+        jsonxx::Object phases;
+        for (auto const &phase : m_memoryStats) {
+            phases << phase.first << GetMemoryStatsObject(phase.second);
+        }
+        o << "phases" << phases;
+    }
+
+    return o.json();
+}
+
+void Toolkit::CollectMemoryStats(MemoryStats &stats, SvgDeviceContext *svg)
+{
+    m_doc.CollectMemoryStats(stats);
+
+    if (m_humdrumBuffer) {
+        stats.AddStructure("humdrumBuffer", 1, strlen(m_humdrumBuffer) + 1);
+    }
+    if (svg) {
+        int nodeCount = 0;
+        size_t size = svg->GetMemorySize(nodeCount);
+        stats.AddStructure("svg", nodeCount, size);
+    }
+}
+
+void Toolkit::SnapshotMemoryStats(const std::string &phase, SvgDeviceContext *svg)
+{
+    if (!m_options->m_memoryStats.GetValue()) return;
+
+    MemoryStats &stats = m_memoryStats[phase];
+    stats.Reset();
+    this->CollectMemoryStats(stats, svg);
+}
+
 std::string Toolkit::GetElementAttr(const std::string &xmlId)
 {
     jsonxx::Object o;
@@ -1159,7 +1376,7 @@ std::string Toolkit::GetElementAttr(const std::string &xmlId)
 std::string Toolkit::GetNotatedIdForElement(const std::string &xmlId)
 {
     if (m_doc.m_expansionMap.HasExpansionMap())
-        return m_doc.m_expansionMap.GetExpansionIdsForElement(xmlId).front();
+        return m_doc.m_expansionMap.GetNotatedId(xmlId);
     else
         return xmlId;
 }
@@ -1180,6 +1397,10 @@ std::string Toolkit::GetExpansionIdsForElement(const std::string &xmlId)
 
 bool Toolkit::Edit(const std::string &json_editorAction)
 {
+    // The edit can add or delete notes referenced by the time index
+    m_doc.ResetMidiTimemap();
+
+    ObjectArenaScope arenaScope(m_doc.GetContentArena());
     return m_editorToolkit->ParseEditorAction(json_editorAction);
 }
 
@@ -1229,6 +1450,7 @@ void Toolkit::RedoLayout()
     else {
         m_doc.CastOffDoc();
     }
+    this->SnapshotMemoryStats("castOff");
 }
 
 void Toolkit::RedoPagePitchPosLayout()
@@ -1321,6 +1543,7 @@ std::string Toolkit::RenderToSVG(int pageNo, bool xml_declaration)
     RenderToDeviceContext(pageNo, &svg);
 
     std::string out_str = svg.GetStringSVG(xml_declaration);
+    this->SnapshotMemoryStats("render", &svg);
     if (initialPageNo >= 0) m_doc.SetDrawingPage(initialPageNo);
     return out_str;
 }
@@ -1367,19 +1590,17 @@ void Toolkit::GetHumdrum(std::ostream &output)
     output << GetHumdrumBuffer();
 }
 
-std::string Toolkit::RenderToMIDI()
+std::string Toolkit::RenderToMIDI(const std::string &jsonOptions)
 {
-    smf::MidiFile outputfile;
-    outputfile.absoluteTicks();
-    m_doc.ExportMIDI(&outputfile);
-    outputfile.sortTracks();
-
-    std::stringstream strstrem;
-    outputfile.write(strstrem);
-    std::string outputstr = Base64Encode(
-        reinterpret_cast<const unsigned char *>(strstrem.str().c_str()), (unsigned int)strstrem.str().length());
+    const std::string data = this->RenderToMIDIData(jsonOptions);
+    return Base64Encode(reinterpret_cast<const unsigned char *>(data.c_str()), (unsigned int)data.length());
+}
 
-    return outputstr;
+std::string Toolkit::RenderToMIDIData(const std::string &jsonOptions)
+{
+    std::string output;
+    this->ExportMIDI(output, jsonOptions);
+    return output;
 }
 
 std::string Toolkit::RenderToPAE()
@@ -1410,70 +1631,295 @@ bool Toolkit::RenderToPAEFile(const std::string &filename)
     return true;
 }
 
-std::string Toolkit::RenderToTimemap()
+bool Toolkit::SetPlaybackRange(PlaybackRange &range, const std::string &jsonOptions)
+{
+    jsonxx::Object json;
+
+    // Read JSON options
+    if (jsonOptions.empty()) {
+        return true;
+    }
+    else if (!json.parse(jsonOptions)) {
+        LogWarning("Cannot parse JSON std::string. Using default options.");
+        return true;
+    }
+
+    // A single measure is a range starting and ending with it
+    const std::vector<std::pair<std::string, Measure **> > measureOptions
+        = { { "measureId", &range.m_startMeasure }, { "measureId", &range.m_endMeasure },
+              { "startMeasureId", &range.m_startMeasure }, { "endMeasureId", &range.m_endMeasure } };
+    for (auto const &option : measureOptions) {
+        if (!json.has<jsonxx::String>(option.first)) continue;
+        const std::string measureId = json.get<jsonxx::String>(option.first);
+        *option.second = dynamic_cast<Measure *>(m_doc.FindDescendantByUuid(measureId));
+        if (!*option.second) {
+            LogWarning("Measure with ID '%s' not found", measureId.c_str());
+            return false;
+        }
+    }
+    if (json.has<jsonxx::Number>("startTime")) range.m_startTime = json.get<jsonxx::Number>("startTime");
+    if (json.has<jsonxx::Number>("endTime")) range.m_endTime = json.get<jsonxx::Number>("endTime");
+
+    return true;
+}
+
+bool Toolkit::ExportMIDI(std::string &output, const std::string &jsonOptions)
+{
+    output = "";
+
+    PlaybackRange range;
+    if (!this->SetPlaybackRange(range, jsonOptions)) return false;
+
+    smf::MidiFile outputfile;
+    outputfile.absoluteTicks();
+    m_doc.ExportMIDI(&outputfile, range);
+
+    // The writer merges the events generated in order instead of sorting the tracks
+    MIDIWriter writer;
+    writer.Write(outputfile, output);
+
+    return true;
+}
+
+bool Toolkit::ExportTimemap(std::string &output, const std::string &jsonOptions)
+{
+    output = "";
+
+    PlaybackRange range;
+    if (!this->SetPlaybackRange(range, jsonOptions)) return false;
+
+    bool ndjson = false;
+    jsonxx::Object json;
+    if (!jsonOptions.empty() && json.parse(jsonOptions) && json.has<jsonxx::String>("format")) {
+        const std::string format = json.get<jsonxx::String>("format");
+        if (format == "ndjson") {
+            ndjson = true;
+        }
+        else if (format != "json") {
+            LogWarning("Unsupported timemap format '%s'. Using JSON.", format.c_str());
+        }
+    }
+
+    return m_doc.ExportTimemap(output, ndjson, range);
+}
+
+std::string Toolkit::RenderToTimemap(const std::string &jsonOptions)
 {
     std::string output;
-    m_doc.ExportTimemap(output);
+    this->ExportTimemap(output, jsonOptions);
     return output;
 }
 
-std::string Toolkit::GetElementsAtTime(int millisec)
+jsonxx::Object Toolkit::GetElementsAtTimeObject(int millisec)
 {
     jsonxx::Object o;
     jsonxx::Array a;
 
+    std::vector<Note *> notes;
+    Measure *measure = m_doc.GetTimeIndex().GetNotesAtTime(millisec, notes);
+
+    if (!measure) {
+        return o;
+    }
+
+    // Get the pageNo from the measure
+    int pageNo = -1;
+    Page *page = dynamic_cast<Page *>(measure->GetFirstAncestor(PAGE));
+    if (page) pageNo = page->GetIdx() + 1;
+
+    // Fill the JSON object
+    for (auto const &note : notes) {
+        a << note->GetUuid();
+    }
+    o << "notes" << a;
+    o << "page" << pageNo;
+
+    return o;
+}
+
+std::string Toolkit::GetElementsAtTime(int millisec)
+{
     // Here we need to check that the midi timemap is done
     if (!m_doc.HasMidiTimemap()) {
         // generate MIDI timemap before progressing
         m_doc.CalculateMidiTimemap();
     }
 
-    MeasureOnsetOffsetComparison matchMeasureTime(millisec);
-    Measure *measure = dynamic_cast<Measure *>(m_doc.FindDescendantByComparison(&matchMeasureTime));
+    return this->GetElementsAtTimeObject(millisec).json();
+}
 
-    if (!measure) {
-        return o.json();
+std::string Toolkit::GetElementsAtTimes(const std::string &jsonTimes)
+{
+    jsonxx::Array times;
+    jsonxx::Array a;
+
+    if (!times.parse(jsonTimes)) {
+        LogError("Cannot parse JSON std::string. An array of times in milliseconds is expected.");
+        return a.json();
     }
 
-    int repeat = measure->EnclosesTime(millisec);
-    int measureTimeOffset = measure->GetRealTimeOffsetMilliseconds(repeat);
+    if (!m_doc.HasMidiTimemap()) {
+        // generate MIDI timemap before progressing
+        m_doc.CalculateMidiTimemap();
+    }
 
-    // Get the pageNo from the first note (if any)
-    int pageNo = -1;
-    Page *page = dynamic_cast<Page *>(measure->GetFirstAncestor(PAGE));
-    if (page) pageNo = page->GetIdx() + 1;
+    for (int i = 0; i < (int)times.size(); ++i) {
+        if (!times.has<jsonxx::Number>(i)) {
+            a << jsonxx::Object();
+            continue;
+        }
+        a << this->GetElementsAtTimeObject(times.get<jsonxx::Number>(i));
+    }
 
-    NoteOnsetOffsetComparison matchNoteTime(millisec - measureTimeOffset);
-    ListOfObjects notes;
+    return a.json();
+}
 
-    measure->FindAllDescendantByComparison(&notes, &matchNoteTime);
+std::string Toolkit::GetElementsInTimeRange(int startMillisec, int endMillisec)
+{
+    jsonxx::Object o;
+    jsonxx::Array a;
+    jsonxx::Array p;
 
-    // Fill the JSON object
-    ListOfObjects::iterator iter;
-    for (iter = notes.begin(); iter != notes.end(); ++iter) {
-        a << (*iter)->GetUuid();
+    if (!m_doc.HasMidiTimemap()) {
+        // generate MIDI timemap before progressing
+        m_doc.CalculateMidiTimemap();
     }
+
+    std::vector<Note *> notes;
+    std::vector<Measure *> measures;
+    m_doc.GetTimeIndex().GetNotesInTimeRange(startMillisec, endMillisec, notes, measures);
+
+    for (auto const &note : notes) {
+        a << note->GetUuid();
+    }
+
+    std::set<int> pageNos;
+    for (auto const &measure : measures) {
+        Page *page = dynamic_cast<Page *>(measure->GetFirstAncestor(PAGE));
+        if (page) pageNos.insert(page->GetIdx() + 1);
+    }
+    for (auto const &pageNo : pageNos) {
+        p << pageNo;
+    }
+
     o << "notes" << a;
-    o << "page" << pageNo;
+    o << "pages" << p;
 
     return o.json();
 }
 
-bool Toolkit::RenderToMIDIFile(const std::string &filename)
+std::string Toolkit::GetElementsAtPoint(int pageNo, int x, int y, int radius)
 {
-    smf::MidiFile outputfile;
-    outputfile.absoluteTicks();
-    m_doc.ExportMIDI(&outputfile);
-    outputfile.sortTracks();
-    outputfile.write(filename);
+    int initialPageNo = (m_doc.GetDrawingPage() == NULL) ? -1 : m_doc.GetDrawingPage()->GetIdx();
+
+    std::vector<Object *> objects;
+    const SpatialIndex *spatialIndex = this->GetSpatialIndex(pageNo);
+    if (spatialIndex) spatialIndex->GetObjectsAtPoint(x, y, radius, objects);
+
+    if (initialPageNo >= 0) m_doc.SetDrawingPage(initialPageNo);
+    return this->GetElementsByNameObject(objects).json();
+}
+
+std::string Toolkit::GetElementsInRect(int pageNo, int x, int y, int width, int height)
+{
+    int initialPageNo = (m_doc.GetDrawingPage() == NULL) ? -1 : m_doc.GetDrawingPage()->GetIdx();
+
+    std::vector<Object *> objects;
+    const SpatialIndex *spatialIndex = this->GetSpatialIndex(pageNo);
+    if (spatialIndex) spatialIndex->GetObjectsInRect(x, y, x + width, y + height, objects);
+
+    if (initialPageNo >= 0) m_doc.SetDrawingPage(initialPageNo);
+    return this->GetElementsByNameObject(objects).json();
+}
+
+const SpatialIndex *Toolkit::GetSpatialIndex(int pageNo)
+{
+    if ((pageNo < 1) || (pageNo > GetPageCount())) {
+        LogWarning("Page %d does not exist", pageNo);
+        return NULL;
+    }
+
+    // Page number is one-based - correct it to 0-based first
+    m_view.SetPage(pageNo - 1);
+
+    Page *page = m_doc.GetDrawingPage();
+    assert(page);
+    return page->GetSpatialIndex();
+}
+
+jsonxx::Object Toolkit::GetElementsByNameObject(const std::vector<Object *> &objects)
+{
+    std::map<std::string, jsonxx::Array> elements;
+    for (Object *object : objects) {
+        std::string name = object->GetClassName();
+        std::transform(name.begin(), name.begin() + 1, name.begin(), ::tolower);
+        elements[name] << object->GetUuid();
+    }
+
+    jsonxx::Object o;
+    for (auto const &entry : elements) {
+        o << entry.first << entry.second;
+    }
+
+    return o;
+}
+
+const PlaybackSchedule *Toolkit::GetPlaybackSchedule()
+{
+    return &m_doc.GetPlaybackSchedule();
+}
+
+std::string Toolkit::GetPlaybackEvents(int startMillisec, int endMillisec)
+{
+    jsonxx::Array a;
+
+    PlaybackCursor cursor(&m_doc.GetPlaybackSchedule());
+    cursor.Seek(startMillisec);
+    while (const PlaybackEvent *event = cursor.NextUntil(endMillisec)) {
+        jsonxx::Object o;
+        o << "tstamp" << event->m_time;
+        o << "qstamp" << event->m_scoreTime;
+        if (event->m_type == PLAYBACK_TEMPO) {
+            o << "type"
+              << "tempo";
+            o << "tempo" << event->m_tempo;
+        }
+        else {
+            o << "type" << std::string((event->m_type == PLAYBACK_NOTE_ON) ? "on" : "off");
+            o << "id" << event->m_note->GetUuid();
+            o << "pitch" << (int)event->m_pitch;
+            o << "velocity" << (int)event->m_velocity;
+            o << "channel" << (int)event->m_channel;
+            o << "page" << event->m_page;
+        }
+        a << o;
+    }
+
+    return a.json();
+}
+
+bool Toolkit::RenderToMIDIFile(const std::string &filename, const std::string &jsonOptions)
+{
+    std::string outputString;
+    if (!this->ExportMIDI(outputString, jsonOptions)) {
+        return false;
+    }
+
+    std::ofstream output(filename.c_str(), std::ios::binary);
+    if (!output.is_open()) {
+        return false;
+    }
+    output << outputString;
 
     return true;
 }
 
-bool Toolkit::RenderToTimemapFile(const std::string &filename)
+bool Toolkit::RenderToTimemapFile(const std::string &filename, const std::string &jsonOptions)
 {
     std::string outputString;
-    m_doc.ExportTimemap(outputString);
+    if (!this->ExportTimemap(outputString, jsonOptions)) {
+        return false;
+    }
 
     std::ofstream output(filename.c_str());
     if (!output.is_open()) {
@@ -1605,4 +2051,15 @@ const char *Toolkit::GetCString()
     }
 }
 
+void Toolkit::SetCData(std::string &&data)
+{
+    m_cData = std::move(data);
+}
+
+const unsigned char *Toolkit::GetCData(int &length)
+{
+    length = (int)m_cData.size();
+    return reinterpret_cast<const unsigned char *>(m_cData.data());
+}
+
 } // namespace vrv
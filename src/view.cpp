@@ -15,6 +15,7 @@
 //----------------------------------------------------------------------------
 
 #include "doc.h"
+#include "objectarena.h"
 #include "page.h"
 #include "vrv.h"
 
@@ -72,6 +73,8 @@ void View::SetPage(int pageIdx, bool doLayout)
     m_currentPage = m_doc->SetDrawingPage(pageIdx);
 
     if (doLayout) {
+        // The alignments and the positioners created by the layout are layout objects
+        ObjectArenaScope arenaScope(m_doc->GetLayoutArena());
         m_doc->SetCurrentScoreDefDoc();
         // if we once deal with multiple views, it would be better
         // to redo the layout only when necessary?
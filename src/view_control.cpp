@@ -72,80 +72,103 @@ void View::DrawControlElement(DeviceContext *dc, ControlElement *element, Measur
     assert(element);
 
     // For dir, dynam, fermata, and harm, we do not consider the @tstamp2 for rendering
-    if (element->Is({ BRACKETSPAN, FIGURE, GLISS, HAIRPIN, PHRASE, OCTAVE, SLUR, TIE })) {
-        // create placeholder
-        dc->StartGraphic(element, "", element->GetUuid());
-        dc->EndGraphic(element, this);
-        system->AddToDrawingList(element);
-    }
-    else if (element->Is(ARPEG)) {
-        Arpeg *arpeg = vrv_cast<Arpeg *>(element);
-        assert(arpeg);
-        DrawArpeg(dc, arpeg, measure, system);
-    }
-    else if (element->Is(BREATH)) {
-        Breath *breath = vrv_cast<Breath *>(element);
-        assert(breath);
-        DrawBreath(dc, breath, measure, system);
-    }
-    else if (element->Is(DIR)) {
-        Dir *dir = vrv_cast<Dir *>(element);
-        assert(dir);
-        DrawDir(dc, dir, measure, system);
-        system->AddToDrawingListIfNeccessary(dir);
-    }
-    else if (element->Is(DYNAM)) {
-        Dynam *dynam = vrv_cast<Dynam *>(element);
-        assert(dynam);
-        DrawDynam(dc, dynam, measure, system);
-        system->AddToDrawingListIfNeccessary(dynam);
-    }
-    else if (element->Is(FERMATA)) {
-        Fermata *fermata = vrv_cast<Fermata *>(element);
-        assert(fermata);
-        DrawFermata(dc, fermata, measure, system);
-    }
-    else if (element->Is(FING)) {
-        Fing *fing = vrv_cast<Fing *>(element);
-        assert(fing);
-        DrawFing(dc, fing, measure, system);
-    }
-    else if (element->Is(HARM)) {
-        Harm *harm = vrv_cast<Harm *>(element);
-        assert(harm);
-        DrawHarm(dc, harm, measure, system);
-    }
-    else if (element->Is(MORDENT)) {
-        Mordent *mordent = vrv_cast<Mordent *>(element);
-        assert(mordent);
-        DrawMordent(dc, mordent, measure, system);
-    }
-    else if (element->Is(PEDAL)) {
-        Pedal *pedal = vrv_cast<Pedal *>(element);
-        assert(pedal);
-        DrawPedal(dc, pedal, measure, system);
-        system->AddToDrawingListIfNeccessary(pedal);
-    }
-    else if (element->Is(REH)) {
-        Reh *reh = vrv_cast<Reh *>(element);
-        assert(reh);
-        DrawReh(dc, reh, measure, system);
-    }
-    else if (element->Is(TEMPO)) {
-        Tempo *tempo = vrv_cast<Tempo *>(element);
-        assert(tempo);
-        DrawTempo(dc, tempo, measure, system);
-    }
-    else if (element->Is(TRILL)) {
-        Trill *trill = vrv_cast<Trill *>(element);
-        assert(trill);
-        DrawTrill(dc, trill, measure, system);
-        system->AddToDrawingListIfNeccessary(trill);
-    }
-    else if (element->Is(TURN)) {
-        Turn *turn = vrv_cast<Turn *>(element);
-        assert(turn);
-        DrawTurn(dc, turn, measure, system);
+    switch (element->GetClassId()) {
+        case BRACKETSPAN:
+        case FIGURE:
+        case GLISS:
+        case HAIRPIN:
+        case PHRASE:
+        case OCTAVE:
+        case SLUR:
+        case TIE:
+            // create placeholder
+            dc->StartGraphic(element, "", element->GetUuid());
+            dc->EndGraphic(element, this);
+            system->AddToDrawingList(element);
+            break;
+        case ARPEG: {
+            Arpeg *arpeg = vrv_cast<Arpeg *>(element);
+            assert(arpeg);
+            DrawArpeg(dc, arpeg, measure, system);
+            break;
+        }
+        case BREATH: {
+            Breath *breath = vrv_cast<Breath *>(element);
+            assert(breath);
+            DrawBreath(dc, breath, measure, system);
+            break;
+        }
+        case DIR: {
+            Dir *dir = vrv_cast<Dir *>(element);
+            assert(dir);
+            DrawDir(dc, dir, measure, system);
+            system->AddToDrawingListIfNeccessary(dir);
+            break;
+        }
+        case DYNAM: {
+            Dynam *dynam = vrv_cast<Dynam *>(element);
+            assert(dynam);
+            DrawDynam(dc, dynam, measure, system);
+            system->AddToDrawingListIfNeccessary(dynam);
+            break;
+        }
+        case FERMATA: {
+            Fermata *fermata = vrv_cast<Fermata *>(element);
+            assert(fermata);
+            DrawFermata(dc, fermata, measure, system);
+            break;
+        }
+        case FING: {
+            Fing *fing = vrv_cast<Fing *>(element);
+            assert(fing);
+            DrawFing(dc, fing, measure, system);
+            break;
+        }
+        case HARM: {
+            Harm *harm = vrv_cast<Harm *>(element);
+            assert(harm);
+            DrawHarm(dc, harm, measure, system);
+            break;
+        }
+        case MORDENT: {
+            Mordent *mordent = vrv_cast<Mordent *>(element);
+            assert(mordent);
+            DrawMordent(dc, mordent, measure, system);
+            break;
+        }
+        case PEDAL: {
+            Pedal *pedal = vrv_cast<Pedal *>(element);
+            assert(pedal);
+            DrawPedal(dc, pedal, measure, system);
+            system->AddToDrawingListIfNeccessary(pedal);
+            break;
+        }
+        case REH: {
+            Reh *reh = vrv_cast<Reh *>(element);
+            assert(reh);
+            DrawReh(dc, reh, measure, system);
+            break;
+        }
+        case TEMPO: {
+            Tempo *tempo = vrv_cast<Tempo *>(element);
+            assert(tempo);
+            DrawTempo(dc, tempo, measure, system);
+            break;
+        }
+        case TRILL: {
+            Trill *trill = vrv_cast<Trill *>(element);
+            assert(trill);
+            DrawTrill(dc, trill, measure, system);
+            system->AddToDrawingListIfNeccessary(trill);
+            break;
+        }
+        case TURN: {
+            Turn *turn = vrv_cast<Turn *>(element);
+            assert(turn);
+            DrawTurn(dc, turn, measure, system);
+            break;
+        }
+        default: break;
     }
 }
 
@@ -2333,31 +2356,35 @@ void View::DrawSystemElement(DeviceContext *dc, SystemElement *element, System *
     assert(element);
     assert(system);
 
-    if (element->Is(BOUNDARY_END)) {
-        BoundaryEnd *boundaryEnd = vrv_cast<BoundaryEnd *>(element);
-        assert(boundaryEnd);
-        assert(boundaryEnd->GetStart());
-        dc->StartGraphic(element, boundaryEnd->GetStart()->GetUuid(), element->GetUuid());
-        dc->EndGraphic(element, this);
-    }
-    else if (element->Is(ENDING)) {
-        // Create placeholder - A graphic for the end boundary will be created
-        // but only if it is on a different system - See View::DrawEnding
-        // The Ending is added to the System drawing list by View::DrawMeasure
-        dc->StartGraphic(element, "boundaryStart", element->GetUuid());
-        dc->EndGraphic(element, this);
-    }
-    else if (element->Is(PB)) {
-        dc->StartGraphic(element, "", element->GetUuid());
-        dc->EndGraphic(element, this);
-    }
-    else if (element->Is(SB)) {
-        dc->StartGraphic(element, "", element->GetUuid());
-        dc->EndGraphic(element, this);
-    }
-    else if (element->Is(SECTION)) {
-        dc->StartGraphic(element, "boundaryStart", element->GetUuid());
-        dc->EndGraphic(element, this);
+    switch (element->GetClassId()) {
+        case BOUNDARY_END: {
+            BoundaryEnd *boundaryEnd = vrv_cast<BoundaryEnd *>(element);
+            assert(boundaryEnd);
+            assert(boundaryEnd->GetStart());
+            dc->StartGraphic(element, boundaryEnd->GetStart()->GetUuid(), element->GetUuid());
+            dc->EndGraphic(element, this);
+            break;
+        }
+        case ENDING:
+            // Create placeholder - A graphic for the end boundary will be created
+            // but only if it is on a different system - See View::DrawEnding
+            // The Ending is added to the System drawing list by View::DrawMeasure
+            dc->StartGraphic(element, "boundaryStart", element->GetUuid());
+            dc->EndGraphic(element, this);
+            break;
+        case PB:
+            dc->StartGraphic(element, "", element->GetUuid());
+            dc->EndGraphic(element, this);
+            break;
+        case SB:
+            dc->StartGraphic(element, "", element->GetUuid());
+            dc->EndGraphic(element, this);
+            break;
+        case SECTION:
+            dc->StartGraphic(element, "boundaryStart", element->GetUuid());
+            dc->EndGraphic(element, this);
+            break;
+        default: break;
     }
 }
 
@@ -88,133 +88,58 @@ void View::DrawLayerElement(DeviceContext *dc, LayerElement *element, Layer *lay
         m_currentColour = AxNONE;
     }
 
-    if (element->Is(ACCID)) {
-        DrawAccid(dc, element, layer, staff, measure);
-    }
-    else if (element->Is(ARTIC)) {
-        DrawArtic(dc, element, layer, staff, measure);
-    }
-    else if (element->Is(ARTIC_PART)) {
-        DrawArticPart(dc, element, layer, staff, measure);
-    }
-    else if (element->Is(BARLINE)) {
-        DrawBarLine(dc, element, layer, staff, measure);
-    }
-    else if (element->Is(BEAM)) {
-        DrawBeam(dc, element, layer, staff, measure);
-    }
-    else if (element->Is(BEATRPT)) {
-        DrawBeatRpt(dc, element, layer, staff, measure);
-    }
-    else if (element->Is(BTREM)) {
-        DrawBTrem(dc, element, layer, staff, measure);
-    }
-    else if (element->Is(CHORD)) {
-        DrawDurationElement(dc, element, layer, staff, measure);
-    }
-    else if (element->Is(CLEF)) {
-        DrawClef(dc, element, layer, staff, measure);
-    }
-    else if (element->Is(CUSTOS)) {
-        DrawCustos(dc, element, layer, staff, measure);
-    }
-    else if (element->Is(DOT)) {
-        DrawDot(dc, element, layer, staff, measure);
-    }
-    else if (element->Is(DOTS)) {
-        DrawDots(dc, element, layer, staff, measure);
-    }
-    else if (element->Is(FTREM)) {
-        DrawFTrem(dc, element, layer, staff, measure);
-    }
-    else if (element->Is(FLAG)) {
-        DrawFlag(dc, element, layer, staff, measure);
-    }
-    else if (element->Is(GRACEGRP)) {
-        DrawGraceGrp(dc, element, layer, staff, measure);
-    }
-    else if (element->Is(HALFMRPT)) {
-        DrawHalfmRpt(dc, element, layer, staff, measure);
-    }
-    else if (element->Is(KEYSIG)) {
-        DrawKeySig(dc, element, layer, staff, measure);
-    }
-    else if (element->Is(LIGATURE)) {
-        DrawLigature(dc, element, layer, staff, measure);
-    }
-    else if (element->Is(MENSUR)) {
-        DrawMensur(dc, element, layer, staff, measure);
-    }
-    else if (element->Is(METERSIG)) {
-        DrawMeterSig(dc, element, layer, staff, measure);
-    }
-    else if (element->Is(MREST)) {
-        DrawMRest(dc, element, layer, staff, measure);
-    }
-    else if (element->Is(MRPT)) {
-        DrawMRpt(dc, element, layer, staff, measure);
-    }
-    else if (element->Is(MRPT2)) {
-        DrawMRpt2(dc, element, layer, staff, measure);
-    }
-    else if (element->Is(MSPACE)) {
-        DrawMSpace(dc, element, layer, staff, measure);
-    }
-    else if (element->Is(MULTIREST)) {
-        DrawMultiRest(dc, element, layer, staff, measure);
-    }
-    else if (element->Is(MULTIRPT)) {
-        DrawMultiRpt(dc, element, layer, staff, measure);
-    }
-    else if (element->Is(NC)) {
-        DrawNc(dc, element, layer, staff, measure);
-    }
-    else if (element->Is(NOTE)) {
-        DrawDurationElement(dc, element, layer, staff, measure);
-    }
-    else if (element->Is(NEUME)) {
-        DrawNeume(dc, element, layer, staff, measure);
-    }
-    else if (element->Is(PLICA)) {
-        DrawPlica(dc, element, layer, staff, measure);
-    }
-    else if (element->Is(PROPORT)) {
-        DrawProport(dc, element, layer, staff, measure);
-    }
-    else if (element->Is(REST)) {
-        DrawDurationElement(dc, element, layer, staff, measure);
-    }
-    else if (element->Is(SPACE)) {
-        DrawSpace(dc, element, layer, staff, measure);
-    }
-    else if (element->Is(STEM)) {
-        DrawStem(dc, element, layer, staff, measure);
-    }
-    else if (element->Is(SYL)) {
-        DrawSyl(dc, element, layer, staff, measure);
-    }
-    else if (element->Is(SYLLABLE)) {
-        DrawSyllable(dc, element, layer, staff, measure);
-    }
-    else if (element->Is(TUPLET)) {
-        DrawTuplet(dc, element, layer, staff, measure);
-    }
-    else if (element->Is(TUPLET_BRACKET)) {
-        dc->StartGraphic(element, "", element->GetUuid());
-        dc->EndGraphic(element, this);
-        layer->AddToDrawingList(element);
-    }
-    else if (element->Is(TUPLET_NUM)) {
-        dc->StartGraphic(element, "", element->GetUuid());
-        dc->EndGraphic(element, this);
-        layer->AddToDrawingList(element);
-    }
-    else if (element->Is(VERSE)) {
-        DrawVerse(dc, element, layer, staff, measure);
-    }
-    else {
-        // This should never happen
-        LogError("Element '%s' cannot be drawn", element->GetClassName().c_str());
+    switch (element->GetClassId()) {
+        case ACCID: DrawAccid(dc, element, layer, staff, measure); break;
+        case ARTIC: DrawArtic(dc, element, layer, staff, measure); break;
+        case ARTIC_PART: DrawArticPart(dc, element, layer, staff, measure); break;
+        case BARLINE: DrawBarLine(dc, element, layer, staff, measure); break;
+        case BEAM: DrawBeam(dc, element, layer, staff, measure); break;
+        case BEATRPT: DrawBeatRpt(dc, element, layer, staff, measure); break;
+        case BTREM: DrawBTrem(dc, element, layer, staff, measure); break;
+        case CHORD: DrawDurationElement(dc, element, layer, staff, measure); break;
+        case CLEF: DrawClef(dc, element, layer, staff, measure); break;
+        case CUSTOS: DrawCustos(dc, element, layer, staff, measure); break;
+        case DOT: DrawDot(dc, element, layer, staff, measure); break;
+        case DOTS: DrawDots(dc, element, layer, staff, measure); break;
+        case FTREM: DrawFTrem(dc, element, layer, staff, measure); break;
+        case FLAG: DrawFlag(dc, element, layer, staff, measure); break;
+        case GRACEGRP: DrawGraceGrp(dc, element, layer, staff, measure); break;
+        case HALFMRPT: DrawHalfmRpt(dc, element, layer, staff, measure); break;
+        case KEYSIG: DrawKeySig(dc, element, layer, staff, measure); break;
+        case LIGATURE: DrawLigature(dc, element, layer, staff, measure); break;
+        case MENSUR: DrawMensur(dc, element, layer, staff, measure); break;
+        case METERSIG: DrawMeterSig(dc, element, layer, staff, measure); break;
+        case MREST: DrawMRest(dc, element, layer, staff, measure); break;
+        case MRPT: DrawMRpt(dc, element, layer, staff, measure); break;
+        case MRPT2: DrawMRpt2(dc, element, layer, staff, measure); break;
+        case MSPACE: DrawMSpace(dc, element, layer, staff, measure); break;
+        case MULTIREST: DrawMultiRest(dc, element, layer, staff, measure); break;
+        case MULTIRPT: DrawMultiRpt(dc, element, layer, staff, measure); break;
+        case NC: DrawNc(dc, element, layer, staff, measure); break;
+        case NOTE: DrawDurationElement(dc, element, layer, staff, measure); break;
+        case NEUME: DrawNeume(dc, element, layer, staff, measure); break;
+        case PLICA: DrawPlica(dc, element, layer, staff, measure); break;
+        case PROPORT: DrawProport(dc, element, layer, staff, measure); break;
+        case REST: DrawDurationElement(dc, element, layer, staff, measure); break;
+        case SPACE: DrawSpace(dc, element, layer, staff, measure); break;
+        case STEM: DrawStem(dc, element, layer, staff, measure); break;
+        case SYL: DrawSyl(dc, element, layer, staff, measure); break;
+        case SYLLABLE: DrawSyllable(dc, element, layer, staff, measure); break;
+        case TUPLET: DrawTuplet(dc, element, layer, staff, measure); break;
+        case TUPLET_BRACKET:
+            dc->StartGraphic(element, "", element->GetUuid());
+            dc->EndGraphic(element, this);
+            layer->AddToDrawingList(element);
+            break;
+        case TUPLET_NUM:
+            dc->StartGraphic(element, "", element->GetUuid());
+            dc->EndGraphic(element, this);
+            layer->AddToDrawingList(element);
+            break;
+        case VERSE: DrawVerse(dc, element, layer, staff, measure); break;
+        default:
+            // This should never happen
+            LogError("Element '%s' cannot be drawn", element->GetClassName().c_str());
     }
 
     m_currentColour = previousColor;
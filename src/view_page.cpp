@@ -1382,7 +1382,7 @@ void View::DrawSystemChildren(DeviceContext *dc, Object *parent, System *system)
     for (auto current : *parent->GetChildren()) {
         if (current->Is(MEASURE)) {
             // cast to Measure check in DrawMeasure
-            DrawMeasure(dc, dynamic_cast<Measure *>(current), system);
+            DrawMeasure(dc, vrv_cast<Measure *>(current), system);
         }
         // scoreDef are not drawn directly, but anything else should not be possible
         else if (current->Is(SCOREDEF)) {
@@ -1393,11 +1393,11 @@ void View::DrawSystemChildren(DeviceContext *dc, Object *parent, System *system)
         }
         else if (current->IsSystemElement()) {
             // cast to EditorialElement check in DrawSystemEditorial element
-            DrawSystemElement(dc, dynamic_cast<SystemElement *>(current), system);
+            DrawSystemElement(dc, vrv_cast<SystemElement *>(current), system);
         }
         else if (current->IsEditorialElement()) {
             // cast to EditorialElement check in DrawSystemEditorial element
-            DrawSystemEditorialElement(dc, dynamic_cast<EditorialElement *>(current), system);
+            DrawSystemEditorialElement(dc, vrv_cast<EditorialElement *>(current), system);
         }
         else {
             assert(false);
@@ -1415,15 +1415,15 @@ void View::DrawMeasureChildren(DeviceContext *dc, Object *parent, Measure *measu
     for (auto current : *parent->GetChildren()) {
         if (current->Is(STAFF)) {
             // cast to Staff check in DrawStaff
-            DrawStaff(dc, dynamic_cast<Staff *>(current), measure, system);
+            DrawStaff(dc, vrv_cast<Staff *>(current), measure, system);
         }
         else if (current->IsControlElement()) {
             // cast to ControlElement check in DrawControlElement
-            DrawControlElement(dc, dynamic_cast<ControlElement *>(current), measure, system);
+            DrawControlElement(dc, vrv_cast<ControlElement *>(current), measure, system);
         }
         else if (current->IsEditorialElement()) {
             // cast to EditorialElement check in DrawMeasureEditorialElement
-            DrawMeasureEditorialElement(dc, dynamic_cast<EditorialElement *>(current), measure, system);
+            DrawMeasureEditorialElement(dc, vrv_cast<EditorialElement *>(current), measure, system);
         }
         else {
             LogDebug("Current is %s", current->GetClassName().c_str());
@@ -1442,11 +1442,11 @@ void View::DrawStaffChildren(DeviceContext *dc, Object *parent, Staff *staff, Me
     for (auto current : *parent->GetChildren()) {
         if (current->Is(LAYER)) {
             // cast to Layer check in DrawLayer
-            DrawLayer(dc, dynamic_cast<Layer *>(current), staff, measure);
+            DrawLayer(dc, vrv_cast<Layer *>(current), staff, measure);
         }
         else if (current->IsEditorialElement()) {
             // cast to EditorialElement check in DrawStaffEditorialElement
-            DrawStaffEditorialElement(dc, dynamic_cast<EditorialElement *>(current), staff, measure);
+            DrawStaffEditorialElement(dc, vrv_cast<EditorialElement *>(current), staff, measure);
         }
         else {
             assert(false);
@@ -1464,11 +1464,11 @@ void View::DrawLayerChildren(DeviceContext *dc, Object *parent, Layer *layer, St
 
     for (auto current : *parent->GetChildren()) {
         if (current->IsLayerElement()) {
-            DrawLayerElement(dc, dynamic_cast<LayerElement *>(current), layer, staff, measure);
+            DrawLayerElement(dc, vrv_cast<LayerElement *>(current), layer, staff, measure);
         }
         else if (current->IsEditorialElement()) {
             // cast to EditorialElement check in DrawLayerEditorialElement
-            DrawLayerEditorialElement(dc, dynamic_cast<EditorialElement *>(current), layer, staff, measure);
+            DrawLayerEditorialElement(dc, vrv_cast<EditorialElement *>(current), layer, staff, measure);
         }
         else if (!current->Is({ LABEL, LABELABBR })) {
             assert(false);
@@ -1483,11 +1483,11 @@ void View::DrawTextChildren(DeviceContext *dc, Object *parent, TextDrawingParams
 
     for (auto current : *parent->GetChildren()) {
         if (current->IsTextElement()) {
-            DrawTextElement(dc, dynamic_cast<TextElement *>(current), params);
+            DrawTextElement(dc, vrv_cast<TextElement *>(current), params);
         }
         else if (current->IsEditorialElement()) {
             // cast to EditorialElement check in DrawTextEditorialElement
-            DrawTextEditorialElement(dc, dynamic_cast<EditorialElement *>(current), params);
+            DrawTextEditorialElement(dc, vrv_cast<EditorialElement *>(current), params);
         }
         else {
             assert(false);
@@ -1502,11 +1502,11 @@ void View::DrawFbChildren(DeviceContext *dc, Object *parent, TextDrawingParams &
 
     for (auto current : *parent->GetChildren()) {
         if (current->IsTextElement()) {
-            DrawTextElement(dc, dynamic_cast<TextElement *>(current), params);
+            DrawTextElement(dc, vrv_cast<TextElement *>(current), params);
         }
         else if (current->IsEditorialElement()) {
             // cast to EditorialElement check in DrawLayerEditorialElement
-            DrawFbEditorialElement(dc, dynamic_cast<EditorialElement *>(current), params);
+            DrawFbEditorialElement(dc, vrv_cast<EditorialElement *>(current), params);
         }
         else {
             assert(false);
@@ -1521,18 +1521,18 @@ void View::DrawRunningChildren(DeviceContext *dc, Object *parent, TextDrawingPar
 
     for (auto current : *parent->GetChildren()) {
         if (current->Is(FIG)) {
-            DrawFig(dc, dynamic_cast<Fig *>(current), params);
+            DrawFig(dc, vrv_cast<Fig *>(current), params);
         }
         else if (current->IsTextElement()) {
             // We are now reaching a text element - start set only here because we can have a figure
             TextDrawingParams paramsChild = params;
             dc->StartText(ToDeviceContextX(params.m_x), ToDeviceContextY(params.m_y), HORIZONTALALIGNMENT_left);
-            DrawTextElement(dc, dynamic_cast<TextElement *>(current), paramsChild);
+            DrawTextElement(dc, vrv_cast<TextElement *>(current), paramsChild);
             dc->EndText();
         }
         else if (current->IsEditorialElement()) {
             // cast to EditorialElement check in DrawLayerEditorialElement
-            DrawRunningEditorialElement(dc, dynamic_cast<EditorialElement *>(current), params);
+            DrawRunningEditorialElement(dc, vrv_cast<EditorialElement *>(current), params);
         }
         else {
             assert(false);
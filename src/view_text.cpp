@@ -166,33 +166,38 @@ void View::DrawTextElement(DeviceContext *dc, TextElement *element, TextDrawingP
     assert(dc);
     assert(element);
 
-    if (element->Is(FIGURE)) {
-        F *f = vrv_cast<F *>(element);
-        assert(f);
-        DrawF(dc, f, params);
-    }
-    else if (element->Is(LB)) {
-        Lb *lb = vrv_cast<Lb *>(element);
-        assert(lb);
-        DrawLb(dc, lb, params);
-    }
-    else if (element->Is(NUM)) {
-        Num *num = vrv_cast<Num *>(element);
-        assert(num);
-        DrawNum(dc, num, params);
-    }
-    else if (element->Is(REND)) {
-        Rend *rend = vrv_cast<Rend *>(element);
-        assert(rend);
-        DrawRend(dc, rend, params);
-    }
-    else if (element->Is(TEXT)) {
-        Text *text = vrv_cast<Text *>(element);
-        assert(text);
-        DrawText(dc, text, params);
-    }
-    else {
-        assert(false);
+    switch (element->GetClassId()) {
+        case FIGURE: {
+            F *f = vrv_cast<F *>(element);
+            assert(f);
+            DrawF(dc, f, params);
+            break;
+        }
+        case LB: {
+            Lb *lb = vrv_cast<Lb *>(element);
+            assert(lb);
+            DrawLb(dc, lb, params);
+            break;
+        }
+        case NUM: {
+            Num *num = vrv_cast<Num *>(element);
+            assert(num);
+            DrawNum(dc, num, params);
+            break;
+        }
+        case REND: {
+            Rend *rend = vrv_cast<Rend *>(element);
+            assert(rend);
+            DrawRend(dc, rend, params);
+            break;
+        }
+        case TEXT: {
+            Text *text = vrv_cast<Text *>(element);
+            assert(text);
+            DrawText(dc, text, params);
+            break;
+        }
+        default: assert(false); break;
     }
 }
 
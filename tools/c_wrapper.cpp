@@ -68,12 +68,36 @@ const char *vrvToolkit_getElementAttr(Toolkit *tk, const char *xmlId)
     return tk->GetCString();
 }
 
+const char *vrvToolkit_getElementsAtPoint(Toolkit *tk, int pageNo, int x, int y, int radius)
+{
+    tk->SetCString(tk->GetElementsAtPoint(pageNo, x, y, radius));
+    return tk->GetCString();
+}
+
 const char *vrvToolkit_getElementsAtTime(Toolkit *tk, int millisec)
 {
     tk->SetCString(tk->GetElementsAtTime(millisec));
     return tk->GetCString();
 }
 
+const char *vrvToolkit_getElementsAtTimes(Toolkit *tk, const char *times)
+{
+    tk->SetCString(tk->GetElementsAtTimes(times));
+    return tk->GetCString();
+}
+
+const char *vrvToolkit_getElementsInRect(Toolkit *tk, int pageNo, int x, int y, int width, int height)
+{
+    tk->SetCString(tk->GetElementsInRect(pageNo, x, y, width, height));
+    return tk->GetCString();
+}
+
+const char *vrvToolkit_getElementsInTimeRange(Toolkit *tk, int startMillisec, int endMillisec)
+{
+    tk->SetCString(tk->GetElementsInTimeRange(startMillisec, endMillisec));
+    return tk->GetCString();
+}
+
 const char *vrvToolkit_getExpansionIdsForElement(Toolkit *tk, const char *xmlId)
 {
     tk->SetCString(tk->GetExpansionIdsForElement(xmlId));
@@ -104,6 +128,12 @@ const char *vrvToolkit_getMIDIValuesForElement(Toolkit *tk, const char *xmlId)
     return tk->GetCString();
 }
 
+const char *vrvToolkit_getMemoryStats(Toolkit *tk)
+{
+    tk->SetCString(tk->GetMemoryStats());
+    return tk->GetCString();
+}
+
 const char *vrvToolkit_getNotatedIdForElement(Toolkit *tk, const char *xmlId)
 {
     tk->SetCString(tk->GetNotatedIdForElement(xmlId));
@@ -126,6 +156,12 @@ int vrvToolkit_getPageWithElement(Toolkit *tk, const char *xmlId)
     return tk->GetPageWithElement(xmlId);
 }
 
+const char *vrvToolkit_getPlaybackEvents(Toolkit *tk, int startMillisec, int endMillisec)
+{
+    tk->SetCString(tk->GetPlaybackEvents(startMillisec, endMillisec));
+    return tk->GetCString();
+}
+
 double vrvToolkit_getTimeForElement(Toolkit *tk, const char *xmlId)
 {
     return tk->GetTimeForElement(xmlId);
@@ -143,13 +179,26 @@ bool vrvToolkit_loadData(Toolkit *tk, const char *data)
     return tk->LoadData(data);
 }
 
+bool vrvToolkit_loadCopy(Toolkit *tk, Toolkit *source)
+{
+    tk->ResetLogBuffer();
+    return tk->LoadCopy(source);
+}
+
 const char *vrvToolkit_renderToMIDI(Toolkit *tk, const char *c_options)
 {
     tk->ResetLogBuffer();
-    tk->SetCString(tk->RenderToMIDI());
+    tk->SetCString(tk->RenderToMIDI(c_options));
     return tk->GetCString();
 }
 
+const unsigned char *vrvToolkit_renderToMIDIData(Toolkit *tk, const char *c_options, int *length)
+{
+    tk->ResetLogBuffer();
+    tk->SetCData(tk->RenderToMIDIData(c_options));
+    return tk->GetCData(*length);
+}
+
 const char *vrvToolkit_renderToSVG(Toolkit *tk, int page_no, const char *c_options)
 {
     tk->ResetLogBuffer();
@@ -157,10 +206,10 @@ const char *vrvToolkit_renderToSVG(Toolkit *tk, int page_no, const char *c_optio
     return tk->GetCString();
 }
 
-const char *vrvToolkit_renderToTimemap(Toolkit *tk)
+const char *vrvToolkit_renderToTimemap(Toolkit *tk, const char *c_options)
 {
     tk->ResetLogBuffer();
-    tk->SetCString(tk->RenderToTimemap());
+    tk->SetCString(tk->RenderToTimemap(c_options));
     return tk->GetCString();
 }
 
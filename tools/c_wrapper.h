@@ -15,22 +15,30 @@ void vrvToolkit_destructor(Toolkit *tk);
 bool vrvToolkit_edit(Toolkit *tk, const char *editorAction);
 const char *vrvToolkit_getAvailableOptions(Toolkit *tk);
 const char *vrvToolkit_getElementAttr(Toolkit *tk, const char *xmlId);
+const char *vrvToolkit_getElementsAtPoint(Toolkit *tk, int pageNo, int x, int y, int radius);
 const char *vrvToolkit_getElementsAtTime(Toolkit *tk, int millisec);
+const char *vrvToolkit_getElementsAtTimes(Toolkit *tk, const char *times);
+const char *vrvToolkit_getElementsInRect(Toolkit *tk, int pageNo, int x, int y, int width, int height);
+const char *vrvToolkit_getElementsInTimeRange(Toolkit *tk, int startMillisec, int endMillisec);
 const char *vrvToolkit_getExpansionIdsForElement(Toolkit *tk, const char *xmlId);
 const char *vrvToolkit_getHumdrum(Toolkit *tk);
 const char *vrvToolkit_getLog(Toolkit *tk);
 const char *vrvToolkit_getMEI(Toolkit *tk, const char *options);
 const char *vrvToolkit_getMIDIValuesForElement(Toolkit *tk, const char *xmlId);
+const char *vrvToolkit_getMemoryStats(Toolkit *tk);
 const char *vrvToolkit_getNotatedIdForElement(Toolkit *tk, const char *xmlId);
 const char *vrvToolkit_getOptions(Toolkit *tk, bool default_values);
 int vrvToolkit_getPageCount(Toolkit *tk);
 int vrvToolkit_getPageWithElement(Toolkit *tk, const char *xmlId);
+const char *vrvToolkit_getPlaybackEvents(Toolkit *tk, int startMillisec, int endMillisec);
 double vrvToolkit_getTimeForElement(Toolkit *tk, const char *xmlId);
 const char *vrvToolkit_getVersion(Toolkit *tk);
 bool vrvToolkit_loadData(Toolkit *tk, const char *data);
+bool vrvToolkit_loadCopy(Toolkit *tk, Toolkit *source);
 const char *vrvToolkit_renderToMIDI(Toolkit *tk, const char *c_options);
+const unsigned char *vrvToolkit_renderToMIDIData(Toolkit *tk, const char *c_options, int *length);
 const char *vrvToolkit_renderToSVG(Toolkit *tk, int page_no, const char *c_options);
-const char *vrvToolkit_renderToTimemap(Toolkit *tk);
+const char *vrvToolkit_renderToTimemap(Toolkit *tk, const char *c_options);
 void vrvToolkit_redoLayout(Toolkit *tk);
 void vrvToolkit_redoPagePitchPosLayout(Toolkit *tk);
 const char *vrvToolkit_renderData(Toolkit *tk, const char *data, const char *options);
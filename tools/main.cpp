@@ -490,8 +490,8 @@ int main(int argc, char **argv)
     else if (outformat == "midi") {
         outfile += ".mid";
         if (std_output) {
-            std::cerr << "Midi cannot write to standard output." << std::endl;
-            exit(1);
+            const std::string data = toolkit.RenderToMIDIData();
+            std::cout.write(data.data(), data.size());
         }
         else if (!toolkit.RenderToMIDIFile(outfile)) {
             std::cerr << "Unable to write MIDI to " << outfile << "." << std::endl;